@@ -144,6 +144,36 @@ void capacity_t::copy(capacity_t * capacity)
 	_prev_charge = capacity->_prev_charge;
 	_charge = capacity->_charge;
 }
+void capacity_t::get_state(capacity_state & state) const
+{
+	state.q0 = _q0;
+	state.qmax = _qmax;
+	state.qmax_thermal = _qmax_thermal;
+	state.qmax0 = _qmax0;
+	state.I = _I;
+	state.I_loss = _I_loss;
+	state.SOC = _SOC;
+	state.DOD = _DOD;
+	state.DOD_prev = _DOD_prev;
+	state.chargeChange = _chargeChange;
+	state.prev_charge = _prev_charge;
+	state.charge = _charge;
+}
+void capacity_t::set_state(const capacity_state & state)
+{
+	_q0 = state.q0;
+	_qmax = state.qmax;
+	_qmax_thermal = state.qmax_thermal;
+	_qmax0 = state.qmax0;
+	_I = state.I;
+	_I_loss = state.I_loss;
+	_SOC = state.SOC;
+	_DOD = state.DOD;
+	_DOD_prev = state.DOD_prev;
+	_chargeChange = state.chargeChange;
+	_prev_charge = state.prev_charge;
+	_charge = state.charge;
+}
 void capacity_t::check_charge_change()
 {
 	_charge = NO_CHARGE;
@@ -269,6 +299,22 @@ void capacity_kibam_t::copy(capacity_t * capacity)
 	_q20 = tmp->_q20;
 	_I20 = tmp->_I20;
 }
+void capacity_kibam_t::get_state(capacity_state & state) const
+{
+	capacity_t::get_state(state);
+	state.q1 = _q1;
+	state.q2 = _q2;
+	state.q1_0 = _q1_0;
+	state.q2_0 = _q2_0;
+}
+void capacity_kibam_t::set_state(const capacity_state & state)
+{
+	capacity_t::set_state(state);
+	_q1 = state.q1;
+	_q2 = state.q2;
+	_q1_0 = state.q1_0;
+	_q2_0 = state.q2_0;
+}
 
 void capacity_kibam_t::replace_battery()
 {
@@ -522,6 +568,14 @@ void voltage_t::copy(voltage_t * voltage)
 	// doesn't change;
 	//_batt_voltage_matrix = voltage->_batt_voltage_matrix;
 }
+void voltage_t::get_state(voltage_state & state) const
+{
+	state.cell_voltage = _cell_voltage;
+}
+void voltage_t::set_state(const voltage_state & state)
+{
+	_cell_voltage = state.cell_voltage;
+}
 double voltage_t::battery_voltage(){ return _num_cells_series*_cell_voltage; }
 double voltage_t::battery_voltage_nominal(){ return _num_cells_series * _cell_voltage_nominal; }
 double voltage_t::cell_voltage(){ return _cell_voltage; }
@@ -721,6 +775,16 @@ void voltage_vanadium_redox_t::copy(voltage_t * voltage)
 	_F = tmp->_F;
 	_C0 = tmp->_C0;
 }
+void voltage_vanadium_redox_t::get_state(voltage_state & state) const
+{
+	voltage_t::get_state(state);
+	state.I = _I;
+}
+void voltage_vanadium_redox_t::set_state(const voltage_state & state)
+{
+	voltage_t::set_state(state);
+	_I = state.I;
+}
 void voltage_vanadium_redox_t::updateVoltage(capacity_t * capacity, thermal_t * thermal, double )
 {
 
@@ -801,6 +865,22 @@ void lifetime_t::copy(lifetime_t * lifetime)
 	_replacement_scheduled = lifetime->_replacement_scheduled;
 	_q = lifetime->_q;
 }
+void lifetime_t::get_state(lifetime_state & state) const
+{
+	state.q = _q;
+	state.replacements = _replacements;
+	state.replacement_scheduled = _replacement_scheduled;
+	_lifetime_cycle->get_state(state.cycle);
+	_lifetime_calendar->get_state(state.calendar);
+}
+void lifetime_t::set_state(const lifetime_state & state)
+{
+	_q = state.q;
+	_replacements = state.replacements;
+	_replacement_scheduled = state.replacement_scheduled;
+	_lifetime_cycle->set_state(state.cycle);
+	_lifetime_calendar->set_state(state.calendar);
+}
 double lifetime_t::capacity_percent(){ return _q; }
 void lifetime_t::runLifetimeModels(size_t idx, capacity_t * capacity, double T_battery)
 {
@@ -851,12 +931,49 @@ lifetime_cycle_t::lifetime_cycle_t(const util::matrix_t<double> &batt_lifetime_m
 {
 
 	_batt_lifetime_matrix = batt_lifetime_matrix;
+
+	// split the table into bins of unique DOD
+	std::vector<std::vector<double> > bin_rows;
+	double D_min = 100.;
+	_bin_DOD_max = 0.;
 	for (int i = 0; i <(int)_batt_lifetime_matrix.nrows(); i++)
 	{
-		_DOD_vect.push_back(batt_lifetime_matrix.at(i,0));
-		_cycles_vect.push_back(batt_lifetime_matrix.at(i,1));
-		_capacities_vect.push_back(batt_lifetime_matrix.at(i, 2));
+		double D = batt_lifetime_matrix.at(i, 0);
+		size_t bin = 0;
+		while (bin < _bin_DOD.size() && _bin_DOD[bin] != D)
+			bin++;
+		if (bin == _bin_DOD.size())
+		{
+			_bin_DOD.push_back(D);
+			bin_rows.push_back(std::vector<double>());
+		}
+		bin_rows[bin].push_back(batt_lifetime_matrix.at(i, 1));
+		bin_rows[bin].push_back(batt_lifetime_matrix.at(i, 2));
+
+		if (D < D_min){ D_min = D; }
+		else if (D > _bin_DOD_max){ _bin_DOD_max = D; }
 	}
+	if (std::find(_bin_DOD.begin(), _bin_DOD.end(), _bin_DOD_max) == _bin_DOD.end() && _bin_DOD.size() > 0)
+		_bin_DOD_max = *std::max_element(_bin_DOD.begin(), _bin_DOD.end());
+
+	for (size_t bin = 0; bin < _bin_DOD.size(); bin++)
+	{
+		size_t n_rows = bin_rows[bin].size() / 2;
+		_bin_C_n.push_back(util::matrix_t<double>(n_rows, 2, &bin_rows[bin]));
+
+		// Assumes 0% DOD
+		util::matrix_t<double> C_n_zero(n_rows, 2);
+		for (size_t i = 0; i < n_rows; i++)
+		{
+			C_n_zero.at(i, 0) = 0. + i * 500; // cycles
+			C_n_zero.at(i, 1) = 100.; // 100 % capacity
+		}
+		_bin_C_n_zero.push_back(C_n_zero);
+	}
+
+	// the peak stack only holds the residual half cycles, so this rarely grows
+	_Peaks.reserve(64);
+
 	// initialize other member variables
 	_nCycles = 0;
 	_Dlt = 0;
@@ -891,6 +1008,30 @@ void lifetime_cycle_t::copy(lifetime_cycle_t * lifetime_cycle)
 	_Range = lifetime_cycle->_Range;
 	_average_range = lifetime_cycle->_average_range;
 }
+void lifetime_cycle_t::get_state(cycle_state & state) const
+{
+	state.nCycles = _nCycles;
+	state.q = _q;
+	state.Dlt = _Dlt;
+	state.jlt = _jlt;
+	state.Xlt = _Xlt;
+	state.Ylt = _Ylt;
+	state.Range = _Range;
+	state.average_range = _average_range;
+	state.Peaks.assign(_Peaks.begin(), _Peaks.end());
+}
+void lifetime_cycle_t::set_state(const cycle_state & state)
+{
+	_nCycles = state.nCycles;
+	_q = state.q;
+	_Dlt = state.Dlt;
+	_jlt = state.jlt;
+	_Xlt = state.Xlt;
+	_Ylt = state.Ylt;
+	_Range = state.Range;
+	_average_range = state.average_range;
+	_Peaks.assign(state.Peaks.begin(), state.Peaks.end());
+}
 double lifetime_cycle_t::computeCycleDamageAtDOD(double DOD)
 {
 	if (DOD == 0)
@@ -980,18 +1121,16 @@ int lifetime_cycle_t::rainflow_compareRanges()
 		_nCycles++;
 
 		// the capacity percent cannot increase
-		if (bilinear(_average_range, _nCycles) <= _q)
-			_q = bilinear(_average_range, _nCycles);
+		double q_cycle = bilinear(_average_range, _nCycles);
+		if (q_cycle <= _q)
+			_q = q_cycle;
 
 		if (_q < 0)
 			_q = 0.;
 		
-		// discard peak & valley of Y
-		double save = _Peaks[_jlt]; 
-		_Peaks.pop_back(); 
-		_Peaks.pop_back();
-		_Peaks.pop_back();
-		_Peaks.push_back(save);
+		// discard peak & valley of Y, keeping the latest point in their place
+		_Peaks[_jlt - 2] = _Peaks[_jlt];
+		_Peaks.resize(_jlt - 1);
 		_jlt -= 2;
 		// stay in while loop
 		retCode = LT_RERANGE;
@@ -1018,123 +1157,68 @@ double lifetime_cycle_t::cycle_range(){ return _Range; }
 double lifetime_cycle_t::bilinear(double DOD, int cycle_number)
 {
 	/*
-	Work could be done to make this simpler
-	Current idea is to interpolate first along the C = f(n) curves for each DOD to get C_DOD_, C_DOD_+ 
+	Interpolate first along the C = f(n) curves for each DOD to get C_DOD_, C_DOD_+ 
 	Then interpolate C_, C+ to get C at the DOD of interest
 	*/
 
-	std::vector<double> D_unique_vect;
-	std::vector<double> C_n_low_vect;
-	std::vector<double> D_high_vect;
-	std::vector<double> C_n_high_vect;
-	std::vector<int> low_indices;
-	std::vector<int> high_indices;
-	double D = 0.;
-	size_t n = 0;
+	size_t n = _bin_DOD.size();
 	double C = 100;
 
-	// get unique values of D
-	D_unique_vect.push_back(_DOD_vect[0]);
-	for (int i = 0; i < (int)_DOD_vect.size(); i++){
-		bool contained = false;
-		for (int j = 0; j < (int)D_unique_vect.size(); j++){
-			if (_DOD_vect[i] == D_unique_vect[j]){
-				contained = true;
-				break;
-			}
-		}
-		if (!contained){
-			D_unique_vect.push_back(_DOD_vect[i]);
-		}
-	}
-	n = D_unique_vect.size();
-
 	if (n > 1)
 	{
 		// get where DOD is bracketed [D_lo, DOD, D_hi]
 		double D_lo = 0;
 		double D_hi = 100;
 
-		for (int i = 0; i < (int)_DOD_vect.size(); i++)
+		for (size_t i = 0; i < n; i++)
 		{
-			D = _DOD_vect[i];
+			double D = _bin_DOD[i];
 			if (D < DOD && D > D_lo)
 				D_lo = D;
 			else if (D >= DOD && D < D_hi)
 				D_hi = D;
 		}
 
-		// Seperate table into bins
-		double D_min = 100.;
-		double D_max = 0.;
-		
-		for (int i = 0; i < (int)_DOD_vect.size(); i++)
+		int i_lo = -1;
+		int i_hi = -1;
+		for (size_t i = 0; i < n; i++)
 		{
-			D = _DOD_vect[i];
-			if (D == D_lo)
-				low_indices.push_back(i);
-			else if (D == D_hi)
-				high_indices.push_back(i);
-
-			if (D < D_min){ D_min = D; }
-			else if (D > D_max){ D_max = D; }
+			if (_bin_DOD[i] == D_lo)
+				i_lo = (int)i;
+			else if (_bin_DOD[i] == D_hi)
+				i_hi = (int)i;
 		}
 
 		// if we're out of the bounds, just make the upper bound equal to the highest input
-		if (high_indices.size() == 0)
+		if (i_hi < 0)
 		{
-			for (int i = 0; i != (int)_DOD_vect.size(); i++)
+			for (size_t i = 0; i < n; i++)
 			{
-				if (_DOD_vect[i] == D_max)
-					high_indices.push_back(i);
+				if (_bin_DOD[i] == _bin_DOD_max)
+					i_hi = (int)i;
 			}
 		}
 
-		size_t n_rows_lo = low_indices.size();
-		size_t n_rows_hi = high_indices.size();
-		size_t n_cols = 2;
+		// If we aren't bounded, use the assumed 0% DOD rows
+		const util::matrix_t<double> &C_n_low = (i_lo >= 0 ? _bin_C_n[i_lo] : _bin_C_n_zero[i_hi]);
+		const util::matrix_t<double> &C_n_high = _bin_C_n[i_hi];
 
-		// If we aren't bounded, fill in values
-		if (n_rows_lo == 0)
-		{
-			// Assumes 0% DOD
-			for (int i = 0; i < (int)n_rows_hi; i++)
-			{
-				C_n_low_vect.push_back(0. + i * 500); // cycles
-				C_n_low_vect.push_back(100.); // 100 % capacity
-			}
-		}
-		
-		if (n_rows_lo != 0)
-		{
-			for (int i = 0; i < (int)n_rows_lo; i++)
-			{
-				C_n_low_vect.push_back(_cycles_vect[low_indices[i]]);
-				C_n_low_vect.push_back(_capacities_vect[low_indices[i]]);
-			}
-		}
-		if (n_rows_hi != 0)
+		// Compute C(D_lo, n), C(D_hi, n)
+		double C_Dlo = util::linterp_col(C_n_low, 0, cycle_number, 1);
+		double C_Dhi = 0.;
+		if (C_n_low.nrows() < C_n_high.nrows())
 		{
-			for (int i = 0; i < (int)n_rows_hi; i++)
+			// bins of unequal length only use the leading rows of the upper bin
+			util::matrix_t<double> C_n_high_lead(C_n_low.nrows(), 2);
+			for (size_t i = 0; i < C_n_low.nrows(); i++)
 			{
-				C_n_high_vect.push_back(_cycles_vect[high_indices[i]]);
-				C_n_high_vect.push_back(_capacities_vect[high_indices[i]]);
+				C_n_high_lead.at(i, 0) = C_n_high.at(i, 0);
+				C_n_high_lead.at(i, 1) = C_n_high.at(i, 1);
 			}
+			C_Dhi = util::linterp_col(C_n_high_lead, 0, cycle_number, 1);
 		}
-		n_rows_lo = C_n_low_vect.size() / n_cols;
-		n_rows_hi = C_n_high_vect.size() / n_cols;
-
-		if (n_rows_lo == 0 || n_rows_hi == 0)
-		{
-			// need a safeguard here
-		}
-
-		util::matrix_t<double> C_n_low(n_rows_lo, n_cols, &C_n_low_vect);
-		util::matrix_t<double> C_n_high(n_rows_lo, n_cols, &C_n_high_vect);
-
-		// Compute C(D_lo, n), C(D_hi, n)
-		double C_Dlo = util::linterp_col(C_n_low, 0, cycle_number, 1);
-		double C_Dhi = util::linterp_col(C_n_high, 0, cycle_number, 1);
+		else
+			C_Dhi = util::linterp_col(C_n_high, 0, cycle_number, 1);
 
 		if (C_Dlo < 0.)
 			C_Dlo = 0.;
@@ -1212,6 +1296,22 @@ void lifetime_calendar_t::copy(lifetime_calendar_t * lifetime_calendar)
 	_b = lifetime_calendar->_b;
 	_c = lifetime_calendar->_c;
 }
+void lifetime_calendar_t::get_state(calendar_state & state) const
+{
+	state.day_age_of_battery = _day_age_of_battery;
+	state.last_idx = _last_idx;
+	state.q = _q;
+	state.dq_old = _dq_old;
+	state.dq_new = _dq_new;
+}
+void lifetime_calendar_t::set_state(const calendar_state & state)
+{
+	_day_age_of_battery = state.day_age_of_battery;
+	_last_idx = state.last_idx;
+	_q = state.q;
+	_dq_old = state.dq_old;
+	_dq_new = state.dq_new;
+}
 double lifetime_calendar_t::runLifetimeCalendarModel(size_t idx, double T, double SOC)
 {
 	if (_calendar_choice != lifetime_calendar_t::NONE)
@@ -1339,6 +1439,18 @@ void thermal_t::copy(thermal_t * thermal)
 	_capacity_percent = thermal->_capacity_percent;
 	_T_max = thermal->_T_max;
 }
+void thermal_t::get_state(thermal_state & state) const
+{
+	state.T_battery = _T_battery;
+	state.capacity_percent = _capacity_percent;
+	state.R = _R;
+}
+void thermal_t::set_state(const thermal_state & state)
+{
+	_T_battery = state.T_battery;
+	_capacity_percent = state.capacity_percent;
+	_R = state.R;
+}
 void thermal_t::replace_battery()
 { 
 	_T_battery = _T_room; 
@@ -1516,6 +1628,25 @@ void battery_t::copy(const battery_t * battery)
 	_last_idx = battery->_last_idx;
 }
 
+void battery_t::get_state(battery_state & state) const
+{
+	_capacity->get_state(state.capacity);
+	_voltage->get_state(state.voltage);
+	_thermal->get_state(state.thermal);
+	_lifetime->get_state(state.lifetime);
+	state.losses_nCycle = _losses->get_state();
+	state.last_idx = _last_idx;
+}
+void battery_t::set_state(const battery_state & state)
+{
+	_capacity->set_state(state.capacity);
+	_voltage->set_state(state.voltage);
+	_thermal->set_state(state.thermal);
+	_lifetime->set_state(state.lifetime);
+	_losses->set_state(state.losses_nCycle);
+	_last_idx = state.last_idx;
+}
+
 void battery_t::delete_clone()
 {
 	if (_capacity) delete _capacity;
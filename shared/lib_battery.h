@@ -102,6 +102,33 @@ public:
 	// shallow copy from capacity to this
 	virtual void copy(capacity_t *);
 
+	/// Charge state which changes with time, excluding the model parameters
+	struct capacity_state
+	{
+		double q0;
+		double qmax;
+		double qmax_thermal;
+		double qmax0;
+		double I;
+		double I_loss;
+		double SOC;
+		double DOD;
+		double DOD_prev;
+		bool chargeChange;
+		int prev_charge;
+		int charge;
+
+		// KiBaM only
+		double q1;
+		double q2;
+		double q1_0;
+		double q2_0;
+	};
+
+	// save and restore the charge state
+	virtual void get_state(capacity_state & state) const;
+	virtual void set_state(const capacity_state & state);
+
 	// virtual destructor
 	virtual ~capacity_t(){};
 	
@@ -170,6 +197,9 @@ public:
 	// copy from capacity to this
 	void copy(capacity_t *);
 
+	void get_state(capacity_state & state) const;
+	void set_state(const capacity_state & state);
+
 	void updateCapacity(double &I, double dt);
 	void updateCapacityForThermal(double capacity_percent);
 	void updateCapacityForLifetime(double capacity_percent);
@@ -254,6 +284,16 @@ public:
 	// copy from voltage to this
 	virtual void copy(voltage_t *);
 
+	/// Voltage state which changes with time, excluding the model parameters
+	struct voltage_state
+	{
+		double cell_voltage;
+		double I;		// vanadium redox only
+	};
+
+	// save and restore the voltage state
+	virtual void get_state(voltage_state & state) const;
+	virtual void set_state(const voltage_state & state);
 
 	virtual ~voltage_t(){};
 
@@ -364,6 +404,9 @@ public:
 	// copy from voltage to this
 	void copy(voltage_t *);
 
+	void get_state(voltage_state & state) const;
+	void set_state(const voltage_state & state);
+
 	void updateVoltage(capacity_t * capacity, thermal_t * thermal, double dt);
 
 protected:
@@ -409,6 +452,27 @@ public:
 	int cycles_elapsed();
 	double cycle_range();
 
+	/// Damage state of the rainflow counter.  Peaks only holds the residual (unclosed) half cycles,
+	/// so a snapshot stays small over the whole project life and can be taken every year.
+	struct cycle_state
+	{
+		int nCycles;
+		double q;
+		double Dlt;
+		int jlt;
+		double Xlt;
+		double Ylt;
+		double Range;
+		double average_range;
+		std::vector<double> Peaks;
+	};
+
+	// save the damage state, reusing the storage already in state
+	void get_state(cycle_state & state) const;
+
+	// restore a damage state saved by get_state
+	void set_state(const cycle_state & state);
+
 protected:
 	
 	void rainflow_ranges();
@@ -418,9 +482,12 @@ protected:
 
 	util::matrix_t<double> _cycles_vs_DOD;
 	util::matrix_t<double> _batt_lifetime_matrix;
-	std::vector<double> _DOD_vect;
-	std::vector<double> _cycles_vect;
-	std::vector<double> _capacities_vect;
+
+	// lifetime table split by unique DOD (in table order), built once since bilinear runs on every counted cycle
+	std::vector<double> _bin_DOD;
+	std::vector<util::matrix_t<double> > _bin_C_n;		// [cycles, capacity] rows of each DOD
+	std::vector<util::matrix_t<double> > _bin_C_n_zero;	// assumed 0% DOD rows, sized to match each DOD
+	double _bin_DOD_max;
 
 
 	int _nCycles;
@@ -456,6 +523,20 @@ public:
 	// copy from lifetime_calendar to this
 	void copy(lifetime_calendar_t *);
 
+	/// Calendar degradation state, excluding the calendar table
+	struct calendar_state
+	{
+		int day_age_of_battery;
+		size_t last_idx;
+		double q;
+		double dq_old;
+		double dq_new;
+	};
+
+	// save and restore the calendar degradation state
+	void get_state(calendar_state & state) const;
+	void set_state(const calendar_state & state);
+
 	/// Given the index of the simulation, the tempertature and SOC, return the effective capacity percent
 	double runLifetimeCalendarModel(size_t idx, double T, double SOC);
 
@@ -512,6 +593,20 @@ public:
 	// copy lifetime to this
 	void copy(lifetime_t *);
 
+	/// Degradation state of the cycle and calendar models plus the replacement bookkeeping
+	struct lifetime_state
+	{
+		double q;
+		int replacements;
+		bool replacement_scheduled;
+		lifetime_cycle_t::cycle_state cycle;
+		lifetime_calendar_t::calendar_state calendar;
+	};
+
+	// save and restore the degradation state
+	void get_state(lifetime_state & state) const;
+	void set_state(const lifetime_state & state);
+
 	void runLifetimeModels(size_t idx, capacity_t *, double T_battery);
 
 	double capacity_percent();
@@ -558,6 +653,18 @@ public:
 	// copy thermal to this
 	void copy(thermal_t *);
 
+	/// Thermal state which changes with time
+	struct thermal_state
+	{
+		double T_battery;
+		double capacity_percent;
+		double R;
+	};
+
+	// save and restore the thermal state
+	void get_state(thermal_state & state) const;
+	void set_state(const thermal_state & state);
+
 	void updateTemperature(double I, double R, double dt);
 	void replace_battery();
 
@@ -605,6 +712,10 @@ public:
 	// copy losses to this
 	void copy(losses_t *);
 
+	// save and restore the cycle count, the only loss quantity which changes with time
+	int get_state() const { return _nCycle; }
+	void set_state(int nCycle) { _nCycle = nCycle; }
+
 	// main APIs
 	void run_losses(double dt_hour, size_t index);
 	void replace_battery();
@@ -642,6 +753,25 @@ public:
 	// copy members from battery to this
 	void copy(const battery_t * battery);
 
+	/**
+	Dynamic state of all the battery submodels, without the parameters and tables they were built from.
+	Restoring it is equivalent to copy() from a battery in that state, but only copies scalars
+	plus the short residual rainflow stack, so dispatch can snapshot the battery every step.
+	*/
+	struct battery_state
+	{
+		capacity_t::capacity_state capacity;
+		voltage_t::voltage_state voltage;
+		thermal_t::thermal_state thermal;
+		lifetime_t::lifetime_state lifetime;
+		int losses_nCycle;
+		size_t last_idx;
+	};
+
+	// save and restore the battery state
+	void get_state(battery_state & state) const;
+	void set_state(const battery_state & state);
+
 	// virtual destructor, does nothing as no memory allocated in constructor
 	virtual ~battery_t();
 
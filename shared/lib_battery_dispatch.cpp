@@ -49,6 +49,7 @@
 #include <math.h>
 #include <algorithm>
 #include <numeric>
+#include <limits>
 
 /*
 Dispatch base class
@@ -70,7 +71,7 @@ dispatch_t::dispatch_t(battery_t * Battery, double dt_hour, double SOC_min, doub
 
 	// initalize Battery and a copy of the Battery for iteration
 	_Battery = Battery;
-	_Battery_initial = new battery_t(*_Battery);
+	_Battery->get_state(_Battery_initial);
 
 	// Call the dispatch init method
 	init(_Battery, dt_hour, current_choice, t_min, mode);
@@ -114,7 +115,7 @@ dispatch_t::dispatch_t(const dispatch_t& dispatch)
 	m_batteryPower = m_batteryPowerFlow->getBatteryPower();
 
 	_Battery = new battery_t(*dispatch._Battery);
-	_Battery_initial = new battery_t(*dispatch._Battery_initial);
+	_Battery_initial = dispatch._Battery_initial;
 	init(_Battery, dispatch._dt_hour, dispatch._current_choice, dispatch._t_min, dispatch._mode);
 }
 
@@ -122,7 +123,7 @@ dispatch_t::dispatch_t(const dispatch_t& dispatch)
 void dispatch_t::copy(const dispatch_t * dispatch)
 {
 	_Battery->copy(dispatch->_Battery);
-	_Battery_initial->copy(dispatch->_Battery_initial);
+	_Battery_initial = dispatch->_Battery_initial;
 	init(_Battery, dispatch->_dt_hour,  dispatch->_current_choice, dispatch->_t_min, dispatch->_mode);
 
 	// can't create shallow copy of unique ptr
@@ -132,19 +133,16 @@ void dispatch_t::copy(const dispatch_t * dispatch)
 }
 void dispatch_t::delete_clone()
 {
-	// need to delete both, since allocated memory for both in deep copy 
+	// delete the battery allocated in the deep copy
 	if (_Battery) delete _Battery;
-	if (_Battery_initial) delete _Battery_initial;
 }
 dispatch_t::~dispatch_t()
 {
 	// original _Battery doesn't need deleted, since was a pointer passed in
-	_Battery_initial->delete_clone();
-	delete _Battery_initial;
 }
 void dispatch_t::finalize(size_t idx, double &I)
 {
-	_Battery->copy(_Battery_initial);
+	_Battery->set_state(_Battery_initial);
 	m_batteryPower->powerBattery = 0;
 	m_batteryPower->powerGridToBattery = 0;
 	m_batteryPower->powerBatteryToGrid = 0;
@@ -209,7 +207,7 @@ bool dispatch_t::check_constraints(double &I, size_t count)
 	// reset
 	if (iterate)
 	{
-		_Battery->copy(_Battery_initial);
+		_Battery->set_state(_Battery_initial);
 		m_batteryPower->powerBattery = 0;
 		m_batteryPower->powerGridToBattery = 0;
 		m_batteryPower->powerBatteryToGrid = 0;
@@ -340,7 +338,7 @@ void dispatch_t::runDispatch(size_t year, size_t hour_of_year, size_t step)
 	double I = current_controller(_Battery->battery_voltage_nominal());
 
 	// Setup battery iteration
-	_Battery_initial->copy(_Battery);
+	_Battery->get_state(_Battery_initial);
 	bool iterate = true;
 	size_t count = 0;
 	size_t idx = util::index_year_hour_step(year, hour_of_year, step, static_cast<size_t>(1 / _dt_hour));
@@ -543,7 +541,7 @@ bool dispatch_manual_t::check_constraints(double &I, size_t count)
 		// reset
 		if (iterate)
 		{
-			_Battery->copy(_Battery_initial);
+			_Battery->set_state(_Battery_initial);
 			m_batteryPower->powerBattery = 0;
 			m_batteryPower->powerGridToBattery = 0;
 			m_batteryPower->powerBatteryToGrid = 0;
@@ -715,13 +713,20 @@ bool dispatch_automatic_t::check_constraints(double &I, size_t count)
 			double dSOC = 100 * dQ / _Battery->battery_charge_maximum();
 			double SOC = _Battery->battery_soc();
 
+			// Plans that rely on their targets being met also correct the charge when it draws nothing from the grid:
+			// charging less, or charging from PV that would otherwise be exported. They only stop at the SOC and current limits
+			bool exact = follow_targets_exactly();
+			bool canChargeWithoutGrid = exact && (dP < 0 || (m_batteryPower->canPVCharge && m_batteryPower->powerPVToGrid > fabs(dP)));
+			double SOC_margin = (exact ? tolerance : 2.0);
+			bool belowChargeCurrentMax = (exact ? fabs(I) < m_batteryPower->currentChargeMax : I > m_batteryPower->currentChargeMax);
+
 			// But only if it's possible to meet without break grid-charge contraint
-			if ((m_batteryPower->powerBatteryTarget < 0 && m_batteryPower->canGridCharge) ||
+			if ((m_batteryPower->powerBatteryTarget < 0 && (m_batteryPower->canGridCharge || canChargeWithoutGrid)) ||
 				(m_batteryPower->powerBatteryTarget > 0))
 			{
 				// Also don't violate SOC contraints, current limits
-				if ((m_batteryPower->powerBatteryTarget > 0 && SOC > m_batteryPower->stateOfChargeMin + 2.0 && I < m_batteryPower->currentDischargeMax) ||
-					(m_batteryPower->powerBatteryTarget < 0 && SOC < m_batteryPower->stateOfChargeMax - 2.0 && I > m_batteryPower->currentChargeMax)) {
+				if ((m_batteryPower->powerBatteryTarget > 0 && SOC > m_batteryPower->stateOfChargeMin + SOC_margin && I < m_batteryPower->currentDischargeMax) ||
+					(m_batteryPower->powerBatteryTarget < 0 && SOC < m_batteryPower->stateOfChargeMax - SOC_margin && belowChargeCurrentMax)) {
 
 					double dI = dP * util::kilowatt_to_watt / _Battery->battery_voltage();
 					if (SOC + dSOC > m_batteryPower->stateOfChargeMax + tolerance) {
@@ -791,7 +796,7 @@ bool dispatch_automatic_t::check_constraints(double &I, size_t count)
 		// reset
 		if (iterate)
 		{
-			_Battery->copy(_Battery_initial);
+			_Battery->set_state(_Battery_initial);
 			m_batteryPower->powerBattery = 0;
 			m_batteryPower->powerGridToBattery = 0;
 			m_batteryPower->powerBatteryToGrid = 0;
@@ -828,12 +833,12 @@ dispatch_automatic_behind_the_meter_t::dispatch_automatic_behind_the_meter_t(
 	_P_battery_use.reserve(_num_steps);
 
 	grid.reserve(_num_steps);
-	sorted_grid.reserve(_num_steps);
+	grid_heap.reserve(_num_steps);
 
 	for (size_t ii = 0; ii != _num_steps; ii++)
 	{
 		grid.push_back(grid_point(0., 0, 0));
-		sorted_grid.push_back(grid[ii]);
+		grid_heap.push_back(0.);
 	}
 }
 
@@ -847,7 +852,7 @@ void dispatch_automatic_behind_the_meter_t::init_with_pointer(const dispatch_aut
 	// time series data which could be slow to copy. Since this doesn't change, should probably make const and have copy point to common memory
 	_P_load_dc = tmp->_P_load_dc;
 	_P_target_use = tmp->_P_target_use;
-	sorted_grid = tmp->sorted_grid;
+	grid_heap = tmp->grid_heap;
 }
 
 // deep copy from dispatch to this
@@ -905,8 +910,8 @@ void dispatch_automatic_behind_the_meter_t::update_dispatch(size_t hour_of_year,
 			// setup vectors
 			initialize(hour_of_year);
 
-			// compute grid power, sort highest to lowest
-			sort_grid(p, debug, idx);
+			// compute grid power, heap highest first
+			compute_grid(p, debug, idx);
 
 			// Peak shaving scheme
 			compute_energy(p, debug, E_max);
@@ -941,7 +946,7 @@ void dispatch_automatic_behind_the_meter_t::initialize(size_t hour_of_year)
 	for (size_t ii = 0; ii != _num_steps; ii++)
 	{
 		grid[ii] = grid_point(0., 0, 0); 
-		sorted_grid[ii] = grid[ii];
+		grid_heap[ii] = 0.;
 		_P_target_use.push_back(0.);
 		_P_battery_use.push_back(0.);
 	}
@@ -980,7 +985,7 @@ void dispatch_automatic_behind_the_meter_t::check_debug(FILE *&p, bool & debug,
 	}
 }
 
-void dispatch_automatic_behind_the_meter_t::sort_grid(FILE *p, bool debug, size_t idx)
+void dispatch_automatic_behind_the_meter_t::compute_grid(FILE *p, bool debug, size_t idx)
 {
 
 	if (debug)
@@ -993,7 +998,7 @@ void dispatch_automatic_behind_the_meter_t::sort_grid(FILE *p, bool debug, size_
 		for (size_t step = 0; step != _steps_per_hour; step++)
 		{
 			grid[count] = grid_point(_P_load_dc[idx] - _P_pv_dc[idx], hour, step);
-			sorted_grid[count] = grid[count];
+			grid_heap[count] = grid[count].Grid();
 
 			if (debug)
 				fprintf(p, "%zu\t %.1f\t %.1f\t %.1f\n", count, _P_load_dc[idx], _P_pv_dc[idx], _P_load_dc[idx] - _P_pv_dc[idx]);
@@ -1002,7 +1007,8 @@ void dispatch_automatic_behind_the_meter_t::sort_grid(FILE *p, bool debug, size_
 			count++;
 		}
 	}
-	std::sort(sorted_grid.begin(), sorted_grid.end(), byGrid());
+	// only the peaks are needed in order, so heap rather than sort the day
+	std::make_heap(grid_heap.begin(), grid_heap.end());
 }
 
 void dispatch_automatic_behind_the_meter_t::compute_energy(FILE *p, bool debug, double & E_max)
@@ -1022,14 +1028,11 @@ void dispatch_automatic_behind_the_meter_t::target_power(FILE*p, bool debug, dou
 	// if target power set, use that
 	if (_P_target_input.size() > idx && _P_target_input[idx] >= 0)
 	{
-		double_vec::const_iterator first = _P_target_input.begin() + idx;
-		double_vec::const_iterator last = _P_target_input.begin() + idx + _num_steps;
-		double_vec tmp(first, last);
-		_P_target_use = tmp;
+		_P_target_use.assign(_P_target_input.begin() + idx, _P_target_input.begin() + idx + _num_steps);
 		return;
 	}
 	// don't calculate if peak grid demand is less than a previous target in the month
-	else if (sorted_grid[0].Grid() < _P_target_month)
+	else if (grid_heap[0] < _P_target_month)
 	{
 		for (size_t i = 0; i != _num_steps; i++)
 			_P_target_use[i] = _P_target_month;
@@ -1038,95 +1041,79 @@ void dispatch_automatic_behind_the_meter_t::target_power(FILE*p, bool debug, dou
 	// otherwise, compute one target for the next 24 hours.
 	else
 	{
-		// First compute target power which will allow battery to charge up to E_useful over 24 hour period
-		if (debug)
-			fprintf(p, "Index\tRecharge_target\t charge_energy\n");
-
-		double P_target = sorted_grid[0].Grid();
-		double P_target_min = 1e16;
-		double E_charge = 0.;
-		int index = (int)_num_steps - 1;
-		std::vector<double> E_charge_vec;
-		for (int jj = (int)_num_steps - 1; jj >= 0; jj--)
-		{
-			E_charge = 0.;
-			P_target_min = sorted_grid[index].Grid();
-
-			for (int ii = (int)_num_steps - 1; ii >= 0; ii--)
-			{
-				if (sorted_grid[ii].Grid() > P_target_min)
-					break;
-
-				E_charge += (P_target_min - sorted_grid[ii].Grid())*_dt_hour;
-			}
-			E_charge_vec.push_back(E_charge);
-			if (debug)
-				fprintf(p, "%u: index\t%.3f\t %.3f\n", index, P_target_min, E_charge);
-			index--;
-
-			if (index < 0)
-				break;
-		}
-		std::reverse(E_charge_vec.begin(), E_charge_vec.end());
-
-		// Calculate target power 
-		std::vector<double> sorted_grid_diff;
-		sorted_grid_diff.reserve(_num_steps - 1);
+		/**
+		Walk down the grid powers from the peak, popping each from the heap.  The energy the battery could
+		recharge below a target at the j-th highest power g_j is sum_{i >= j} (g_j - g_i) * dt, which is found
+		from the running sum of the powers above it, so only the peaks shaved are ever ordered.
+		*/
+		double gridTotal = std::accumulate(grid_heap.begin(), grid_heap.end(), 0.);
+		double_vec::iterator heapEnd = grid_heap.end();
+		std::pop_heap(grid_heap.begin(), heapEnd--);
 
-		for (size_t ii = 0; ii != _num_steps - 1; ii++)
-			sorted_grid_diff.push_back(sorted_grid[ii].Grid() - sorted_grid[ii + 1].Grid());
+		double gridCurrent = *heapEnd;	// grid power at the current target [kW]
+		double gridAbove = 0.;			// sum of grid powers above the current target [kW]
+		double E_charge = std::fmax(0., (_num_steps * gridCurrent - gridTotal) * _dt_hour);
 
-		P_target = sorted_grid[0].Grid(); // target power to shave to [kW]
+		double P_target = gridCurrent; // target power to shave to [kW]
 		double sum = 0;			   // energy [kWh];
 		if (debug)
 			fprintf(p, "Step\tTarget_Power\tEnergy_Sum\tEnergy_charged\n");
 
 		for (size_t ii = 0; ii != _num_steps - 1; ii++)
 		{
+			std::pop_heap(grid_heap.begin(), heapEnd--);
+			double gridNext = *heapEnd;
+
 			// don't look at negative grid power
-			if (sorted_grid[ii + 1].Grid() < 0)
+			if (gridNext < 0)
 				break;
 			// Update power target
 			else
-				P_target = sorted_grid[ii + 1].Grid();
+				P_target = gridNext;
+
+			// energy which can be recharged below the next target
+			gridAbove += gridCurrent;
+			double E_charge_next = std::fmax(0., ((_num_steps - ii - 1) * gridNext - (gridTotal - gridAbove)) * _dt_hour);
 
 			if (debug)
 				fprintf(p, "%lu\t %.3f\t", ii, P_target);
 
-			// implies a repeated power
-			if (sorted_grid_diff[ii] == 0)
+			// a repeated power adds no energy to trim
+			if (gridCurrent != gridNext)
 			{
-				if (debug)
-					fprintf(p, "\n");
-				continue;
-			}
-			// add to energy we are trimming
-			else
-				sum += sorted_grid_diff[ii] * (ii + 1)*_dt_hour;
-
-			if (debug)
-				fprintf(p, "%.3f\t%.3f\n", sum, E_charge_vec[ii + 1]);
+				// add to energy we are trimming
+				sum += (gridCurrent - gridNext) * (ii + 1)*_dt_hour;
 
-			if (sum < E_charge_vec[ii + 1] && sum < E_useful)
-				continue;
-			// we have limited power, we'll shave what more we can
-			else if (sum > E_charge_vec[ii + 1])
-			{
-				P_target += (sum - E_charge_vec[ii]) / ((ii + 1)*_dt_hour);
-				sum = E_charge_vec[ii];
-				if (debug)
-					fprintf(p, "%lu\t %.3f\t%.3f\t%.3f\n", ii, P_target, sum, E_charge_vec[ii]);
-				break;
-			}
-			// only allow one cycle per day
-			else if (sum > E_useful)
-			{
-				P_target += (sum - E_useful) / ((ii + 1)*_dt_hour);
-				sum = E_useful;
 				if (debug)
-					fprintf(p, "%lu\t %.3f\t%.3f\t%.3f\n", ii, P_target, sum, E_charge_vec[ii]);
-				break;
+					fprintf(p, "%.3f\t%.3f\n", sum, E_charge_next);
+
+				// we have limited power, we'll shave what more we can
+				if (sum >= E_charge_next || sum >= E_useful)
+				{
+					if (sum > E_charge_next)
+					{
+						P_target += (sum - E_charge) / ((ii + 1)*_dt_hour);
+						sum = E_charge;
+						if (debug)
+							fprintf(p, "%lu\t %.3f\t%.3f\t%.3f\n", ii, P_target, sum, E_charge);
+						break;
+					}
+					// only allow one cycle per day
+					else if (sum > E_useful)
+					{
+						P_target += (sum - E_useful) / ((ii + 1)*_dt_hour);
+						sum = E_useful;
+						if (debug)
+							fprintf(p, "%lu\t %.3f\t%.3f\t%.3f\n", ii, P_target, sum, E_charge);
+						break;
+					}
+				}
 			}
+			else if (debug)
+				fprintf(p, "\n");
+
+			gridCurrent = gridNext;
+			E_charge = E_charge_next;
 		}
 		// set safety factor in case voltage differences make it impossible to achieve target without violated minimum SOC
 		P_target *= (1 + _safety_factor);
@@ -1213,6 +1200,8 @@ dispatch_automatic_front_of_meter_t::dispatch_automatic_front_of_meter_t(
 	if (battCycleCostChoice == dispatch_t::INPUT_CYCLE_COST) {
 		m_cycleCost = battCycleCost;
 	}
+
+	m_optimalDispatch = false;
 	
 	setup_cost_vector(ppa_weekday_schedule, ppa_weekend_schedule);
 }
@@ -1228,6 +1217,7 @@ void dispatch_automatic_front_of_meter_t::init_with_pointer(const dispatch_autom
 	m_etaPVCharge = tmp->m_etaPVCharge;
 	m_etaGridCharge = tmp->m_etaGridCharge;
 	m_etaDischarge = tmp->m_etaDischarge;
+	m_optimalDispatch = tmp->m_optimalDispatch;
 }
 
 void dispatch_automatic_front_of_meter_t::setup_cost_vector(util::matrix_t<size_t> ppa_weekday_schedule, util::matrix_t<size_t> ppa_weekend_schedule)
@@ -1301,7 +1291,21 @@ void dispatch_automatic_front_of_meter_t::update_dispatch(size_t hour_of_year, s
 		// Power to charge (<0) or discharge (>0)
 		double powerBattery = 0;
 
-		if (idx == _index_last_updated + _d_index_update || idx == 0)
+		if (m_optimalDispatch)
+		{
+			if (idx == _index_last_updated + _d_index_update || idx == 0)
+			{
+				if (idx > 0) {
+					_index_last_updated += _d_index_update;
+				}
+				costToCycle();
+				update_dispatch_optimal(hour_of_year, idx);
+			}
+			size_t step = idx - _index_last_updated;
+			if (step < m_dpPlan.size())
+				powerBattery = m_dpPlan[step];
+		}
+		else if (idx == _index_last_updated + _d_index_update || idx == 0)
 		{
 			if (idx > 0) {
 				_index_last_updated += _d_index_update;
@@ -1404,6 +1408,155 @@ void dispatch_automatic_front_of_meter_t::update_dispatch(size_t hour_of_year, s
 	m_batteryPower->powerBattery = m_batteryPower->powerBatteryTarget;
 }
 
+void dispatch_automatic_front_of_meter_t::update_dispatch_optimal(size_t hour_of_year, size_t idx)
+{
+	/**
+	Maximize the revenue over the look-ahead window, where the state is the stored energy between the SOC limits
+	split into battery_dispatch::optimalDispatchLevels levels and the decision is the change in level each step.
+	Discharging earns the PPA price on the delivered energy less the cost to cycle, limited by the inverter
+	capacity left over by PV.  Charging draws from clipped PV (free), then PV and the grid in order of cost
+	per kWh stored.  The first steps of the optimal path are kept until the next update.
+	*/
+	size_t nSteps = std::max(_look_ahead_hours * _steps_per_hour, (size_t)1);
+	size_t nPlan = std::min(std::max(_d_index_update, (size_t)1), nSteps);
+	const size_t nLevels = battery_dispatch::optimalDispatchLevels;
+	m_dpPlan.assign(nPlan, 0.);
+
+	// usable energy between the SOC limits and the energy in each level [kWh]
+	double voltage = _Battery->battery_voltage();
+	double energyUsable = voltage * _Battery->battery_charge_maximum_thermal() * util::watt_to_kilowatt * 0.01 *
+		(m_batteryPower->stateOfChargeMax - m_batteryPower->stateOfChargeMin);
+	if (energyUsable <= 0)
+		return;
+	double energyLevel = energyUsable / (nLevels - 1);
+	double energyStored = std::fmax(0., energyUsable - _Battery->battery_energy_to_fill(m_batteryPower->stateOfChargeMax));
+	size_t level = std::min(nLevels - 1, (size_t)(energyStored / energyLevel + 0.5));
+
+	// largest change in level per step allowed by the current and power limits
+	double powerChargeMax = std::numeric_limits<double>::max();
+	double powerDischargeMax = std::numeric_limits<double>::max();
+	if (_current_choice == RESTRICT_CURRENT || _current_choice == RESTRICT_BOTH)
+	{
+		powerChargeMax = m_batteryPower->currentChargeMax * voltage * util::watt_to_kilowatt;
+		powerDischargeMax = m_batteryPower->currentDischargeMax * voltage * util::watt_to_kilowatt;
+	}
+	if (_current_choice == RESTRICT_POWER || _current_choice == RESTRICT_BOTH)
+	{
+		powerChargeMax = std::fmin(powerChargeMax, m_batteryPower->powerBatteryChargeMax);
+		powerDischargeMax = std::fmin(powerDischargeMax, m_batteryPower->powerBatteryDischargeMax);
+	}
+	bool canCharge = m_batteryPower->canClipCharge || m_batteryPower->canPVCharge || m_batteryPower->canGridCharge;
+	int maxUp = canCharge ? (int)std::fmin(nLevels - 1., std::floor(powerChargeMax * _dt_hour / energyLevel)) : 0;
+	int maxDown = (int)std::fmin(nLevels - 1., std::floor(powerDischargeMax * _dt_hour / energyLevel));
+	size_t nMoves = (size_t)(maxDown + maxUp + 1);
+
+	// reward of each change in level at each step, d = k - maxDown
+	const double infeasible = -std::numeric_limits<double>::max();
+	m_dpReward.resize(nSteps * nMoves);
+	for (size_t t = 0; t != nSteps; t++)
+	{
+		size_t hour = hour_of_year + t / _steps_per_hour;
+		double ppa_cost = _ppa_cost_vector[hour];
+		double usage_cost = ppa_cost;
+		if (m_utilityRateCalculator) {
+			usage_cost = m_utilityRateCalculator->getEnergyRate(hour % 8760);
+		}
+
+		// forecast PV, which for look-behind is the series lagged by a day to line up with the lagged prices
+		double powerPV = (idx + t < _P_pv_dc.size() ? _P_pv_dc[idx + t] : 0.);
+		double powerClipped = (idx + t < _P_cliploss_dc.size() ? _P_cliploss_dc[idx + t] : 0.);
+
+		// otherwise the current step's PV is known
+		if (t == 0 && _mode != dispatch_t::FOM_LOOK_BEHIND)
+		{
+			powerPV = m_batteryPower->powerPV;
+			powerClipped = m_batteryPower->powerPVClipped;
+		}
+		double powerPVSold = std::fmax(0., powerPV - powerClipped);
+		double energyDischargeMax = std::fmax(0., _inverter_paco - powerPVSold) * _dt_hour;
+
+		// charging sources as [kWh stored, $/kWh stored], cheapest first
+		double energyClip = m_batteryPower->canClipCharge ? powerClipped * _dt_hour * m_etaPVCharge : 0.;
+		double energyPV = m_batteryPower->canPVCharge ? powerPVSold * _dt_hour * m_etaPVCharge : 0.;
+		double energyGrid = m_batteryPower->canGridCharge ? std::numeric_limits<double>::max() : 0.;
+		double costPV = ppa_cost / m_etaPVCharge;
+		double costGrid = usage_cost / m_etaGridCharge;
+		double energy1 = energyPV, cost1 = costPV, energy2 = energyGrid, cost2 = costGrid;
+		if (costGrid < costPV) {
+			energy1 = energyGrid; cost1 = costGrid; energy2 = energyPV; cost2 = costPV;
+		}
+
+		double * reward = &m_dpReward[t * nMoves];
+		for (int k = 0; k != (int)nMoves; k++)
+		{
+			double energy = (k - maxDown) * energyLevel;
+			if (energy < 0)
+			{
+				double energyDelivered = -energy * m_etaDischarge;
+				if (energyDelivered > energyDischargeMax * (1 + tolerance))
+					reward[k] = infeasible;
+				else
+					reward[k] = ppa_cost * energyDelivered + m_cycleCost * energy;
+			}
+			else
+			{
+				double fromClip = std::fmin(energy, energyClip);
+				double from1 = std::fmin(energy - fromClip, energy1);
+				double from2 = energy - fromClip - from1;
+				if (from2 > energy2 * (1 + tolerance) + tolerance)
+					reward[k] = infeasible;
+				else
+					reward[k] = -(cost1 * from1 + (from2 > 0 ? cost2 * from2 : 0.));
+			}
+		}
+	}
+
+	// backward recursion, staying idle when moves tie
+	m_dpValue.assign(2 * nLevels, 0.);
+	m_dpPolicy.resize(nSteps * nLevels);
+	double * valueNext = &m_dpValue[0];
+	double * value = &m_dpValue[nLevels];
+	for (size_t t = nSteps; t-- > 0;)
+	{
+		const double * reward = &m_dpReward[t * nMoves];
+		short * policy = &m_dpPolicy[t * nLevels];
+
+		// feasible moves are contiguous around idle since limits only bind on larger moves
+		int kLow = maxDown, kHigh = maxDown;
+		while (kLow > 0 && reward[kLow - 1] != infeasible)
+			kLow--;
+		while (kHigh < (int)nMoves - 1 && reward[kHigh + 1] != infeasible)
+			kHigh++;
+
+		for (int i = 0; i != (int)nLevels; i++)
+		{
+			int kMin = std::max(kLow, maxDown - i);
+			int kMax = std::min(kHigh, maxDown + (int)nLevels - 1 - i);
+			double best = reward[maxDown] + valueNext[i];
+			int kBest = maxDown;
+			for (int k = kMin; k <= kMax; k++)
+			{
+				double v = reward[k] + valueNext[i + k - maxDown];
+				if (v > best) {
+					best = v;
+					kBest = k;
+				}
+			}
+			value[i] = best;
+			policy[i] = (short)(kBest - maxDown);
+		}
+		std::swap(value, valueNext);
+	}
+
+	// follow the optimal path from the current level, discharging (>0) or charging (<0)
+	for (size_t t = 0; t != nPlan; t++)
+	{
+		int move = m_dpPolicy[t * nLevels + level];
+		m_dpPlan[t] = -move * energyLevel / _dt_hour;
+		level += move;
+	}
+}
+
 void dispatch_automatic_front_of_meter_t::update_cliploss_data(double_vec P_cliploss)
 {
 	_P_cliploss_dc = P_cliploss;
@@ -59,6 +59,9 @@
 namespace battery_dispatch
 {
 	const size_t constraintCount = 10;
+
+	/*! Number of stored energy levels between the SOC limits in the optimal front-of-meter dispatch */
+	const size_t optimalDispatchLevels = 101;
 }
 
 /*
@@ -173,7 +176,7 @@ protected:
 	bool restrict_power(double &I);
 
 	battery_t * _Battery;
-	battery_t * _Battery_initial;
+	battery_t::battery_state _Battery_initial;	// battery state at the start of the step, restored between constraint iterations
 
 	double _dt_hour;
 
@@ -381,6 +384,9 @@ protected:
 	/*! Initialize with a pointer*/
 	void init_with_pointer(const dispatch_automatic_t * tmp);
 
+	/*! Whether check_constraints should meet the power targets up to the SOC and current limits, for plans that rely on them */
+	virtual bool follow_targets_exactly() { return false; }
+
 	/*! Return the dispatch mode */
 	int get_mode();
 
@@ -501,7 +507,7 @@ protected:
 
 	void initialize(size_t hour_of_year);
 	void check_debug(FILE *&p, bool & debug, size_t hour_of_year, size_t idx);
-	void sort_grid(FILE *p, bool debug, size_t idx);
+	void compute_grid(FILE *p, bool debug, size_t idx);
 	void compute_energy(FILE *p, bool debug, double & E_max);
 	void target_power(FILE*p, bool debug, double E_max, size_t idx);
 	void set_battery_power(FILE *p, bool debug);
@@ -525,8 +531,8 @@ protected:
 	/* Vector of length (24 hours * steps_per_hour) containing grid calculation [P_grid, hour, step] */
 	grid_vec grid; 
 
-	/* Vector of length (24 hours * steps_per_hour) containing sorted grid calculation [P_grid, hour, step] */
-	grid_vec sorted_grid;
+	/* Vector of length (24 hours * steps_per_hour) containing grid power arranged as a max-heap [kW] */
+	double_vec grid_heap;
 };
 
 /*! Automated Front of Meter DC-connected battery dispatch */
@@ -602,11 +608,20 @@ public:
 	/*! Return the calculated cost to cycle ($/cycle)*/
 	double cost_to_cycle() { return m_cycleCost; }
 
+	/*! Solve the look-ahead window exactly with a dynamic program instead of the heuristic rules */
+	void set_optimal_dispatch(bool optimal) { m_optimalDispatch = optimal; }
+
 protected:
 	
 	void init_with_pointer(const dispatch_automatic_front_of_meter_t* tmp);
 	void setup_cost_vector(util::matrix_t<size_t> ppa_weekday_schedule, util::matrix_t<size_t> ppa_weekend_schedule);
 
+	/*! Plan the battery power until the next update with a dynamic program over the stored energy */
+	void update_dispatch_optimal(size_t hour_of_year, size_t idx);
+
+	/*! The dynamic program plan is only optimal if the battery meets it */
+	bool follow_targets_exactly() { return m_optimalDispatch; }
+
 	/*! Full clipping loss due to AC power limits vector */
 	double_vec _P_cliploss_dc;
 
@@ -631,6 +646,15 @@ protected:
 	double m_etaPVCharge;
 	double m_etaGridCharge;
 	double m_etaDischarge;
+
+	/*! Use the dynamic program rather than the heuristic rules */
+	bool m_optimalDispatch;
+
+	/*! Dynamic program work arrays, reused between updates */
+	std::vector<double> m_dpValue;		// value to go at the next and current step [2 x levels]
+	std::vector<double> m_dpReward;		// reward of each change in level at each step [steps x moves]
+	std::vector<short> m_dpPolicy;		// best change in level at each step and level [steps x levels]
+	std::vector<double> m_dpPlan;		// battery power for each step until the next update [kW]
 };
 
 /*! Battery metrics class */
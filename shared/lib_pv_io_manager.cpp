@@ -11,10 +11,6 @@ PVIOManager::PVIOManager(compute_module*  cm, std::string cmName)
 	std::unique_ptr<Simulation_IO> ptr2(new Simulation_IO(cm, *m_IrradianceIO));
 	m_SimulationIO = std::move(ptr2);
 
-	std::unique_ptr<ShadeDB8_mpp> shadeDatabase(new ShadeDB8_mpp());
-	m_shadeDatabase = std::move(shadeDatabase);
-	m_shadeDatabase->init();
-
 	std::unique_ptr<Inverter_IO> ptrInv(new Inverter_IO(cm, cmName));
 	m_InverterIO = std::move(ptrInv);
 
@@ -33,6 +29,17 @@ PVIOManager::PVIOManager(compute_module*  cm, std::string cmName)
 		}
 	}
 
+	// The shading database tables are shared by the whole process, only attach to them if a subarray uses them
+	std::unique_ptr<ShadeDB8_mpp> shadeDatabase(new ShadeDB8_mpp());
+	m_shadeDatabase = std::move(shadeDatabase);
+	for (size_t subarray = 0; subarray < m_SubarraysIO.size(); subarray++)
+	{
+		if (m_SubarraysIO[subarray]->enable && m_SubarraysIO[subarray]->shadeCalculator.use_shade_db()) {
+			m_shadeDatabase->init();
+			break;
+		}
+	}
+
 	// Aggregate Subarray outputs in different structure
 	std::unique_ptr<PVSystem_IO> pvSystem(new PVSystem_IO(cm, cmName, m_SimulationIO.get(), m_IrradianceIO.get(), getSubarrays(), m_InverterIO.get()));
 	m_PVSystemIO = std::move(pvSystem);
@@ -188,49 +188,46 @@ void ShadeDB8_mpp::init()
 {
 	p_error_msg = "";
 	p_warning_msg = "";
-	p_vmpp_uint8_size = 12091680; // uint8 size from matlab
-	p_impp_uint8_size = 12091680; // uint8 size from matlab
-	p_vmpp = (unsigned char *)malloc(p_vmpp_uint8_size);//malloc(12091680); uint8 size
-	p_impp = (unsigned char *)malloc(p_impp_uint8_size);//malloc(12091680); uint8 size
-	p_compressed_size = 3133517; // from modified example5.c in miniz project
-	decompress_file_to_uint8();
+	const db_tables &tables = shared_tables();
+	p_vmpp = tables.data.data();
+	p_impp = tables.data.data() + tables.vmpp_uint8_size;
+	p_error_msg = tables.error;
 }
 
 ShadeDB8_mpp::~ShadeDB8_mpp()
 {
-	if (p_vmpp)
-		free(p_vmpp);
-	if (p_impp)
-		free(p_impp);
+	// tables are owned by shared_tables()
 }
 
-
-
-bool ShadeDB8_mpp::decompress_file_to_uint8()
+const ShadeDB8_mpp::db_tables &ShadeDB8_mpp::shared_tables()
 {
-	size_t status;
-	uint8 *pTmp_data;
-
-	size_t mem_size = p_vmpp_uint8_size + p_impp_uint8_size;
-
-	pTmp_data = (uint8 *)malloc(mem_size);
+	// inflating the database takes ~24 MB and a noticeable amount of time, so it is done
+	// once per process on first use and then shared read-only by every instance.
+	// initialization of a function-local static is thread-safe in C++11
+	static const db_tables tables = decompress_file_to_uint8();
+	return tables;
+}
 
-	status = tinfl_decompress_mem_to_mem((void *)pTmp_data, mem_size, pCmp_data, p_compressed_size, TINFL_FLAG_PARSE_ZLIB_HEADER);
+ShadeDB8_mpp::db_tables ShadeDB8_mpp::decompress_file_to_uint8()
+{
+	db_tables tables;
+	size_t impp_uint8_size = 12091680; // uint8 size from matlab
+	size_t compressed_size = 3133517; // from modified example5.c in miniz project
+	tables.vmpp_uint8_size = 12091680; // uint8 size from matlab
 
-	memcpy(p_vmpp, pTmp_data, p_vmpp_uint8_size);
-	memcpy(p_impp, pTmp_data + p_vmpp_uint8_size, p_impp_uint8_size);
+	// vmpp and impp are stored back to back in the compressed file, so inflate straight into the table
+	tables.data.resize(tables.vmpp_uint8_size + impp_uint8_size);
 
-	free(pTmp_data);
+	size_t status = tinfl_decompress_mem_to_mem((void *)tables.data.data(), tables.data.size(), pCmp_data, compressed_size, TINFL_FLAG_PARSE_ZLIB_HEADER);
 
 	if (status == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED)
 	{
 		std::stringstream outm;
 		outm << "tinfl_decompress_mem_to_mem() failed with status " << (int)status;
-		p_error_msg = outm.str();
-		return EXIT_FAILURE;
+		tables.error = outm.str();
 	}
 
-	return true;
+	return tables;
 };
 
 double ShadeDB8_mpp::get_shade_loss(double &gpoa, double &dpoa, std::vector<double> &shade_frac, bool use_pv_cell_temp, double pv_cell_temp, int mods_per_str, double str_vmp_stc, double mppt_lo, double mppt_hi)
@@ -68,6 +68,7 @@ public:
 		p_impp=NULL ;
 	};
 	~ShadeDB8_mpp();
+	/// Attaches to the decompressed tables, which are built on first use and shared by all instances in the process
 	void init();
 	short vmpp(size_t ndx){
 		return get_vmpp(ndx);
@@ -85,14 +86,20 @@ public:
 
 
 private:
-	unsigned char *p_vmpp;
-	unsigned char *p_impp;
+	/// Decompressed vmpp table followed by the impp table, read-only once built
+	struct db_tables
+	{
+		std::vector<unsigned char> data;
+		size_t vmpp_uint8_size;
+		std::string error;
+	};
+	static const db_tables &shared_tables();
+	static db_tables decompress_file_to_uint8();
+
+	const unsigned char *p_vmpp;
+	const unsigned char *p_impp;
 	short get_vmpp(size_t i);
 	short get_impp(size_t i);
-	bool decompress_file_to_uint8();
-	size_t p_vmpp_uint8_size;
-	size_t p_impp_uint8_size;
-	size_t p_compressed_size;
 	std::string p_warning_msg;
 	std::string p_error_msg;
 };
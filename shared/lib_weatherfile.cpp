@@ -58,6 +58,8 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #if defined(__WINDOWS__)||defined(WIN32)||defined(_WIN32)
 #define CASECMP(a,b) _stricmp(a,b)
@@ -576,7 +578,254 @@ bool weatherfile::timeStepChecks(int hdr_step_sec) {
 	return true;
 }
 
+bool weatherfile::sm_useBinaryCache = false;
+
+void weatherfile::enable_binary_cache(bool b)
+{
+	sm_useBinaryCache = b;
+}
+
+bool weatherfile::binary_cache_enabled()
+{
+	return sm_useBinaryCache;
+}
+
+std::string weatherfile::binary_cache_file(const std::string &file)
+{
+	return file + ".wfbin";
+}
+
 bool weatherfile::open(const std::string &file, bool header_only)
+{
+	if (cmp_ext(file, "wfbin"))
+	{
+		m_file = file;
+		return read_binary(file);
+	}
+
+	std::string cache;
+	if (sm_useBinaryCache && !header_only && !file.empty())
+	{
+		cache = binary_cache_file(file);
+		if (util::file_exists(cache.c_str()) && read_binary(cache, file))
+		{
+			m_file = file;
+			return true;
+		}
+		m_message.clear();
+	}
+
+	if (!open_text(file, header_only))
+		return false;
+
+	m_file = file;
+
+	// a failure to write the cache is not an error, the next open will parse the text file again
+	if (!cache.empty())
+		write_binary(cache, file);
+
+	return true;
+}
+
+static const char wfbin_magic[8] = { 'S', 'S', 'C', 'W', 'F', 'B', 'I', 'N' };
+static const unsigned int wfbin_version = 1;
+
+static bool source_stamp(const std::string &source, long long *size, long long *mtime)
+{
+	*size = *mtime = 0;
+	if (source.empty()) return true;
+
+	struct stat st;
+	if (stat(source.c_str(), &st) != 0) return false;
+	*size = (long long)st.st_size;
+	*mtime = (long long)st.st_mtime;
+	return true;
+}
+
+template <typename T>
+static bool write_pod(FILE *fp, const T &v)
+{
+	return fwrite(&v, sizeof(T), 1, fp) == 1;
+}
+
+template <typename T>
+static bool read_pod(FILE *fp, T *v)
+{
+	return fread(v, sizeof(T), 1, fp) == 1;
+}
+
+static bool write_str(FILE *fp, const std::string &s)
+{
+	unsigned int len = (unsigned int)s.length();
+	return write_pod(fp, len) && (len == 0 || fwrite(s.c_str(), 1, len, fp) == len);
+}
+
+static bool read_str(FILE *fp, std::string *s)
+{
+	unsigned int len = 0;
+	if (!read_pod(fp, &len)) return false;
+	s->resize(len);
+	return len == 0 || fread(&(*s)[0], 1, len, fp) == len;
+}
+
+bool weatherfile::write_binary(const std::string &file, const std::string &source)
+{
+	long long src_size, src_mtime;
+	if (!source_stamp(source, &src_size, &src_mtime))
+		return false;
+
+	// write to a temporary file first so a concurrent reader never sees a partial cache
+	std::string tmp = file + util::format(".%p.tmp", (void*)this);
+	{
+		util::stdfile fp(tmp, "wb");
+		if (!fp.ok()) return false;
+
+		bool ok = fwrite(wfbin_magic, 1, sizeof(wfbin_magic), fp) == sizeof(wfbin_magic)
+			&& write_pod(fp, wfbin_version)
+			&& write_pod(fp, src_size)
+			&& write_pod(fp, src_mtime)
+			&& write_pod(fp, (int)m_type)
+			&& write_pod(fp, (int)m_startYear)
+			&& write_pod(fp, (unsigned char)(m_hasLeapYear ? 1 : 0))
+			&& write_pod(fp, (unsigned long long)m_startSec)
+			&& write_pod(fp, (unsigned long long)m_stepSec)
+			&& write_pod(fp, (unsigned long long)m_nRecords)
+			&& write_str(fp, m_hdr.location)
+			&& write_str(fp, m_hdr.city)
+			&& write_str(fp, m_hdr.state)
+			&& write_str(fp, m_hdr.country)
+			&& write_str(fp, m_hdr.source)
+			&& write_str(fp, m_hdr.description)
+			&& write_str(fp, m_hdr.url)
+			&& write_pod(fp, (unsigned char)(m_hdr.hasunits ? 1 : 0))
+			&& write_pod(fp, m_hdr.tz)
+			&& write_pod(fp, m_hdr.lat)
+			&& write_pod(fp, m_hdr.lon)
+			&& write_pod(fp, m_hdr.elev);
+
+		for (size_t i = 0; ok && i < _MAXCOL_; i++)
+			ok = write_pod(fp, m_columns[i].index);
+
+		for (size_t i = 0; ok && i < _MAXCOL_; i++)
+		{
+			if (m_columns[i].data.size() < m_nRecords)
+				ok = false;
+			else if (m_nRecords > 0)
+				ok = fwrite(m_columns[i].data.data(), sizeof(float), m_nRecords, fp) == m_nRecords;
+		}
+
+		if (!ok)
+		{
+			fp.close();
+			util::remove_file(tmp.c_str());
+			return false;
+		}
+	}
+
+	// rename does not replace an existing file on Windows
+	util::remove_file(file.c_str());
+	if (rename(tmp.c_str(), file.c_str()) != 0)
+	{
+		util::remove_file(tmp.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool weatherfile::read_binary(const std::string &file, const std::string &source)
+{
+	util::stdfile fp(file, "rb");
+	if (!fp.ok())
+	{
+		m_message = "could not open file for reading: " + file;
+		return false;
+	}
+
+	char magic[sizeof(wfbin_magic)];
+	unsigned int version = 0;
+	if (fread(magic, 1, sizeof(magic), fp) != sizeof(magic)
+		|| memcmp(magic, wfbin_magic, sizeof(magic)) != 0
+		|| !read_pod(fp, &version)
+		|| version != wfbin_version)
+	{
+		m_message = "not a valid binary weather file: " + file;
+		return false;
+	}
+
+	long long src_size, src_mtime, cur_size, cur_mtime;
+	if (!read_pod(fp, &src_size) || !read_pod(fp, &src_mtime))
+	{
+		m_message = "binary weather file is truncated: " + file;
+		return false;
+	}
+
+	if (!source.empty()
+		&& (!source_stamp(source, &cur_size, &cur_mtime) || cur_size != src_size || cur_mtime != src_mtime))
+	{
+		m_message = "binary weather file is out of date with " + source;
+		return false;
+	}
+
+	int type, start_year;
+	unsigned char leap, hasunits;
+	unsigned long long start_sec, step_sec, nrecords;
+	weather_header hdr;
+	bool ok = read_pod(fp, &type)
+		&& read_pod(fp, &start_year)
+		&& read_pod(fp, &leap)
+		&& read_pod(fp, &start_sec)
+		&& read_pod(fp, &step_sec)
+		&& read_pod(fp, &nrecords)
+		&& read_str(fp, &hdr.location)
+		&& read_str(fp, &hdr.city)
+		&& read_str(fp, &hdr.state)
+		&& read_str(fp, &hdr.country)
+		&& read_str(fp, &hdr.source)
+		&& read_str(fp, &hdr.description)
+		&& read_str(fp, &hdr.url)
+		&& read_pod(fp, &hasunits)
+		&& read_pod(fp, &hdr.tz)
+		&& read_pod(fp, &hdr.lat)
+		&& read_pod(fp, &hdr.lon)
+		&& read_pod(fp, &hdr.elev);
+
+	for (size_t i = 0; ok && i < _MAXCOL_; i++)
+		ok = read_pod(fp, &m_columns[i].index);
+
+	for (size_t i = 0; ok && i < _MAXCOL_; i++)
+	{
+		m_columns[i].data.resize((size_t)nrecords);
+		if (nrecords > 0)
+			ok = fread(m_columns[i].data.data(), sizeof(float), (size_t)nrecords, fp) == (size_t)nrecords;
+	}
+
+	if (!ok)
+	{
+		m_message = "binary weather file is truncated: " + file;
+		for (size_t i = 0; i < _MAXCOL_; i++)
+		{
+			m_columns[i].index = -1;
+			m_columns[i].data.clear();
+		}
+		return false;
+	}
+
+	hdr.hasunits = hasunits != 0;
+	m_hdr = hdr;
+	m_type = type;
+	m_startYear = start_year;
+	m_hasLeapYear = leap != 0;
+	m_startSec = (size_t)start_sec;
+	m_stepSec = (size_t)step_sec;
+	m_nRecords = (size_t)nrecords;
+	m_index = 0;
+	m_message.clear();
+
+	return true;
+}
+
+bool weatherfile::open_text(const std::string &file, bool header_only)
 {
 	if (file.empty())
 	{
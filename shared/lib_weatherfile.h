@@ -239,6 +239,10 @@ private:
 	};
 	column m_columns[_MAXCOL_];
 
+	static bool sm_useBinaryCache;
+
+	bool open_text( const std::string &file, bool header_only );
+
 public:
 	weatherfile();
 	/* Detects file format, read header information, detects which data columns are available and at what index
@@ -260,6 +264,18 @@ public:
 
 	bool open( const std::string &file, bool header_only = false );
 
+	/* Binary cache: the parsed header and data columns are written to a compact binary file
+	that can be loaded with a few block reads instead of parsing text.  Files with the .wfbin
+	extension are always read as binary caches.  When the cache is enabled, opening a text weather
+	file looks for a sidecar cache <file>.wfbin that matches the size and modification time of
+	the source, and writes one after a successful parse if none was found.
+	The format is native-endian and is not meant to be moved between platforms. */
+	static void enable_binary_cache( bool b );
+	static bool binary_cache_enabled();
+	static std::string binary_cache_file( const std::string &file );
+	bool write_binary( const std::string &file, const std::string &source = "" );
+	bool read_binary( const std::string &file, const std::string &source = "" );
+
 	bool read( weather_record *r ); 
 	bool has_data_column( size_t id );
 	
@@ -48,6 +48,8 @@
 *******************************************************************************************************/
 
 #include <cmath>
+#include <memory>
+#include <thread>
 #include "lib_physics.h"
 #include "lib_util.h"
 #include "lib_windwatts.h"
@@ -62,6 +64,7 @@ bool windTurbine::setPowerCurve(std::vector<double> windSpeeds, std::vector<doub
 	powerCurveWS = windSpeeds;
 	powerCurveKW = powerOutput;
 	densityCorrectedWS.resize(powerCurveArrayLength, 0);
+	densityCorrectedFor = -999;
 	powerCurveRPM.resize(powerCurveArrayLength, -1);
 	return 1;
 }
@@ -95,17 +98,22 @@ void windTurbine::turbinePower(double windVelocity, double airDensity, double *t
 	*turbineOutput = 0.0;
 
 	//first, correct wind speeds in power curve for site air density. Using method 2 described in https://www.scribd.com/document/38818683/PO310-EWEC2010-Presentation
-	std::vector <double> temp_ws;
-	for (size_t i = 0; i < densityCorrectedWS.size(); i++)
-		densityCorrectedWS[i] = powerCurveWS[i] * pow((physics::AIR_DENSITY_SEA_LEVEL / airDensity), (1.0 / 3.0));
-	int i = 0;
-	while (powerCurveKW[i] == 0)
-		i++; //find the index of the first non-zero power output in the power curve
-	//the cut-in speed is defined where the turbine FIRST STARTS TO TURN, not where it first generates electricity! Therefore, assume that the cut-in speed is actually 1 speed BELOW where power is generated.
-	//this is consistent with the NREL Cost & Scaling model- if you specify a cut-in speed of 4 m/s, the power curve value at 4 m/s is 0, and it starts producing power at 4.25.
-	//HOWEVER, if you specify the cut-in speed BETWEEN the wind speed bins, then this method would improperly assume that the cut-in speed is lower than it actually is. But given the 0.25 m/s size of the bins, that type of
-	//specification would be false accuracy anyways, so we'll ignore it for now.
-	cutInSpeed = densityCorrectedWS[i - 1];
+	// every turbine in a timestep sees the same density, so only redo the correction when it changes
+	if (airDensity != densityCorrectedFor)
+	{
+		double densityFactor = pow((physics::AIR_DENSITY_SEA_LEVEL / airDensity), (1.0 / 3.0));
+		for (size_t i = 0; i < densityCorrectedWS.size(); i++)
+			densityCorrectedWS[i] = powerCurveWS[i] * densityFactor;
+		int i = 0;
+		while (powerCurveKW[i] == 0)
+			i++; //find the index of the first non-zero power output in the power curve
+		//the cut-in speed is defined where the turbine FIRST STARTS TO TURN, not where it first generates electricity! Therefore, assume that the cut-in speed is actually 1 speed BELOW where power is generated.
+		//this is consistent with the NREL Cost & Scaling model- if you specify a cut-in speed of 4 m/s, the power curve value at 4 m/s is 0, and it starts producing power at 4.25.
+		//HOWEVER, if you specify the cut-in speed BETWEEN the wind speed bins, then this method would improperly assume that the cut-in speed is lower than it actually is. But given the 0.25 m/s size of the bins, that type of
+		//specification would be false accuracy anyways, so we'll ignore it for now.
+		cutInSpeed = densityCorrectedWS[i - 1];
+		densityCorrectedFor = airDensity;
+	}
 
 	/*	//We will continue not to check cut-out speed because currently the model will interpolate between the last non-zero power point and zero, and we don't have a better definition of where the power cutoff should be.
 	i = m_adPowerCurveKW.size() - 1; //last index in the array
@@ -309,6 +317,20 @@ double eddyViscosityWakeModel::wakeDeficit(int upwindTurbine, double distCrosswi
 	return dTotal;
 }
 
+double eddyViscosityWakeModel::wakeDeficitBound(int upwindTurbine, double distCrosswind, double distDownwind)
+{
+	double dDef = getVelocityDeficit(upwindTurbine, distDownwind);
+	if (dDef <= 0.0)
+		return 0.0;
+
+	// wakeDeficit averages dSteps + 1 samples (+1 more from rounding in the step sum) of the Gaussian across the rotor,
+	// none closer to the centerline than the nearest edge of the rotor less a step
+	double dSteps = 25.0;
+	double dWidth = getWakeWidth(upwindTurbine, distDownwind);
+	double dNearest = max_of(0.0, distCrosswind * rotorDiameter - rotorDiameter / 2.0 - rotorDiameter / dSteps);
+	return dDef * exp(-3.56*((dNearest*dNearest) / (dWidth*dWidth))) * (dSteps + 2.0) / (dSteps + 1.0) * (1.0 + 1e-9);
+}
+
 double eddyViscosityWakeModel::getWakeWidth(int upwindTurbine, double axialDistanceInDiameters)
 {	
 	// if we're too close, it's just the initial wake width
@@ -408,7 +430,7 @@ double eddyViscosityWakeModel::totalTurbulenceIntensity(double ambientTI, double
 	//	return f;
 }
 
-bool eddyViscosityWakeModel::fillWakeArrays(int turbineIndex, double ambientVelocity, double velocityAtTurbine, double power, double thrustCoeff, double turbulenceIntensity, double metersToFurthestDownwindTurbine) {
+bool eddyViscosityWakeModel::fillWakeArrays(int turbineIndex, double ambientVelocity, double velocityAtTurbine, double power, double thrustCoeff, double turbulenceIntensity, double metersToFurthestDownwindTurbine, double m_d2U[]) {
 	if (power <= 0.0)
 		return true; // no wake effect - wind speed is below cut-in, or above cut-out
 
@@ -458,7 +480,6 @@ bool eddyViscosityWakeModel::fillWakeArrays(int turbineIndex, double ambientVelo
 	double E = F*K1*Bw*Dm*EV_SCALE + Km;
 
 	// Start major departure from Eddy-Viscosity solution using Crank-Nicolson
-	std::vector<double> m_d2U(matEVWakeDeficits.ncols());
 	m_d2U[0] = EV_SCALE*(1.0 - Dmi);
 
 	matEVWakeDeficits.at(turbineIndex, 0) = Dmi;
@@ -508,59 +529,117 @@ bool eddyViscosityWakeModel::fillWakeArrays(int turbineIndex, double ambientVelo
 void eddyViscosityWakeModel::wakeCalculations(/*INPUTS */ const double air_density, const double aDistanceDownwind[], const double aDistanceCrosswind[],
 	/*OUTPUTS*/ double power[], double eff[], double Thrust[], double adWindSpeed[], double aTurbulence_intensity[])
 {
-	double dTurbineRadius = rotorDiameter / 2;
 	matEVWakeDeficits.fill(0.0);
 	matEVWakeWidths.fill(0.0);
-	std::vector<VMLN> vmln(nTurbines);
-	std::vector<double> Iamb(nTurbines, turbulenceCoeff);
 
-	// Note that this 'i' loop starts with i=0, which is necessary to initialize stuff for turbine[0]
-	for (size_t i = 0; i<nTurbines; i++) // downwind turbines, but starting with most upwind and working downwind
+	// the density correction of the power curve is redone when the density changes, so do it here before any workers share the turbine
+	double dPower, dThrust;
+	wTurbine->turbinePower(adWindSpeed[0], air_density, &dPower, &dThrust);
+	if (wTurbine->errDetails.length() > 0){
+		errDetails = wTurbine->errDetails;
+		return;
+	}
+
+	// each worker needs enough turbines to cover the cost of starting a thread every timestep
+	size_t nWorkers = (nThreads > 0) ? nThreads : std::thread::hardware_concurrency();
+	nWorkers = std::max((size_t)1, std::min(nWorkers, nTurbines / 25));
+	if (matEVCenterline.nrows() < nWorkers || matEVCenterline.ncols() != matEVWakeDeficits.ncols())
+		matEVCenterline.resize(nWorkers, matEVWakeDeficits.ncols());
+
+	bool ok = true;
+	if (nWorkers == 1)
 	{
-		double dDeficit = 0, Iadd = 0, dTotalTI = aTurbulence_intensity[i];
-		//		double dTOut=0, dThrustCoeff=0;
-		for (size_t j = 0; j<i; j++) // upwind turbines - turbines upwind of turbine[i]
-		{
-			// distance downwind = distance from turbine i to turbine j along axis of wind direction
-			double dDistAxialInDiameters = fabs(aDistanceDownwind[i] - aDistanceDownwind[j]) / 2.0;
-			if (std::abs(dDistAxialInDiameters) <= 0.0001)
-				continue; // if this turbine isn't really upwind, move on to the next
+		for (size_t i = 0; i < nTurbines && ok; i++) // downwind turbines, but starting with most upwind and working downwind
+			ok = turbineWakeCalculations(i, 0, 0, air_density, aDistanceDownwind, aDistanceCrosswind, power, eff, Thrust, adWindSpeed, aTurbulence_intensity);
+	}
+	else
+	{
+		/**
+		Workers take the next turbine in downwind order and wait on each upwind turbine as they reach it in the upwind loop. By
+		then the workers ahead are usually finished with it, so the turbines pipeline through the farm whatever the wind direction,
+		and each turbine sees exactly the same upwind wakes as in the sequential pass.
+		*/
+		std::unique_ptr<std::atomic<bool>[]> done(new std::atomic<bool>[nTurbines]);
+		for (size_t i = 0; i < nTurbines; i++)
+			done[i] = false;
+		std::atomic<size_t> next(0);
+		std::atomic<bool> failed(false);
+
+		auto worker = [&](size_t w) {
+			for (size_t i = next++; i < nTurbines; i = next++)
+			{
+				if (!turbineWakeCalculations(i, w, done.get(), air_density, aDistanceDownwind, aDistanceCrosswind, power, eff, Thrust, adWindSpeed, aTurbulence_intensity))
+					failed = true;
+				done[i].store(true, std::memory_order_release);
+			}
+		};
+		std::vector<std::thread> threads;
+		for (size_t w = 1; w < nWorkers; w++)
+			threads.push_back(std::thread(worker, w));
+		worker(0);
+		for (size_t w = 0; w < threads.size(); w++)
+			threads[w].join();
+		ok = !failed;
+	}
 
-			// separation crosswind between turbine i and turbine j
-			double dDistRadialInDiameters = fabs(aDistanceCrosswind[i] - aDistanceCrosswind[j]) / 2.0;
+	if (!ok && errDetails.length() == 0)
+		errDetails = "Could not calculate the turbine wake arrays in the Eddy-Viscosity model.";
+}
 
-			double dWakeRadiusMeters = getWakeWidth((int)j, dDistAxialInDiameters);  // the radius of the wake
-			if (dWakeRadiusMeters <= 0.0)
-				continue;
+bool eddyViscosityWakeModel::turbineWakeCalculations(size_t i, size_t worker, const std::atomic<bool> *done, const double air_density, const double aDistanceDownwind[], const double aDistanceCrosswind[],
+	double power[], double eff[], double Thrust[], double adWindSpeed[], double aTurbulence_intensity[])
+{
+	// every turbine reads the free stream speed and output recorded by the most upwind one
+	if (done && i > 0)
+		while (!done[0].load(std::memory_order_acquire))
+			std::this_thread::yield();
 
-			// calculate the wake deficit
-			double dDef = wakeDeficit((int)j, dDistRadialInDiameters, dDistAxialInDiameters);
-			double dWindSpeedWaked = adWindSpeed[0] * (1 - dDef); // wind speed = free stream * (1-deficit)
+	double dTurbineRadius = rotorDiameter / 2;
+	double dDeficit = 0, Iadd = 0, dTotalTI = aTurbulence_intensity[i];
+	//		double dTOut=0, dThrustCoeff=0;
+	for (size_t j = 0; j<i; j++) // upwind turbines - turbines upwind of turbine[i]
+	{
+		// distance downwind = distance from turbine i to turbine j along axis of wind direction
+		double dDistAxialInDiameters = fabs(aDistanceDownwind[i] - aDistanceDownwind[j]) / 2.0;
+		if (std::abs(dDistAxialInDiameters) <= 0.0001)
+			continue; // if this turbine isn't really upwind, move on to the next
 
-			// keep it if it's bigger
-			dDeficit = max_of(dDeficit, dDef);
+		// wait for another worker to finish the upwind turbine's wake
+		if (done)
+			while (!done[j].load(std::memory_order_acquire))
+				std::this_thread::yield();
 
-			Iadd = addedTurbulenceIntensity( Thrust[j], dDistAxialInDiameters*rotorDiameter );
+		// separation crosswind between turbine i and turbine j
+		double dDistRadialInDiameters = fabs(aDistanceCrosswind[i] - aDistanceCrosswind[j]) / 2.0;
 
-			double dFractionOfOverlap = simpleIntersect(dDistRadialInDiameters*rotorDiameter, dTurbineRadius, dWakeRadiusMeters);
-			dTotalTI = max_of(dTotalTI, totalTurbulenceIntensity(aTurbulence_intensity[i], Iadd, adWindSpeed[0], dWindSpeedWaked, dFractionOfOverlap));
-		}
-		// use the max deficit found to calculate the turbine output
-		adWindSpeed[i] = adWindSpeed[0] * (1 - dDeficit);
-		aTurbulence_intensity[i] = dTotalTI;
-		wTurbine->turbinePower(adWindSpeed[i], air_density, &power[i], &Thrust[i]);
-		if (wTurbine->errDetails.length() > 0){
-			errDetails = wTurbine->errDetails;
-			return;
-		}
-		eff[i] = wTurbine->calculateEff(power[i], power[0]);
+		double dWakeRadiusMeters = getWakeWidth((int)j, dDistAxialInDiameters);  // the radius of the wake
+		if (dWakeRadiusMeters <= 0.0)
+			continue;
 
-		// now that turbine[i] wind speed, output, thrust, etc. have been calculated, calculate wake characteristics for it, because downwind turbines will need the info
-		if (!fillWakeArrays((int)i, adWindSpeed[0], adWindSpeed[i], power[i], Thrust[i], aTurbulence_intensity[i], fabs(aDistanceDownwind[nTurbines - 1] - aDistanceDownwind[i])*dTurbineRadius))
-		{
-			if (errDetails.length() == 0) errDetails = "Could not calculate the turbine wake arrays in the Eddy-Viscosity model.";
-		}
-		nearWakeRegionLength(adWindSpeed[i], Iamb[i], Thrust[i], air_density, vmln[i]);
+		// a wake that misses the rotor leaves the TI as is, so it only matters if its deficit can beat the largest so far
+		double dFractionOfOverlap = simpleIntersect(dDistRadialInDiameters*rotorDiameter, dTurbineRadius, dWakeRadiusMeters);
+		if (dFractionOfOverlap <= 0.0 && wakeDeficitBound((int)j, dDistRadialInDiameters, dDistAxialInDiameters) <= dDeficit)
+			continue;
+
+		// calculate the wake deficit
+		double dDef = wakeDeficit((int)j, dDistRadialInDiameters, dDistAxialInDiameters);
+		double dWindSpeedWaked = adWindSpeed[0] * (1 - dDef); // wind speed = free stream * (1-deficit)
+
+		// keep it if it's bigger
+		dDeficit = max_of(dDeficit, dDef);
+
+		Iadd = addedTurbulenceIntensity( Thrust[j], dDistAxialInDiameters*rotorDiameter );
+
+		dTotalTI = max_of(dTotalTI, totalTurbulenceIntensity(aTurbulence_intensity[i], Iadd, adWindSpeed[0], dWindSpeedWaked, dFractionOfOverlap));
 	}
+	// use the max deficit found to calculate the turbine output
+	adWindSpeed[i] = adWindSpeed[0] * (1 - dDeficit);
+	aTurbulence_intensity[i] = dTotalTI;
+	wTurbine->turbinePower(adWindSpeed[i], air_density, &power[i], &Thrust[i]);
+	eff[i] = wTurbine->calculateEff(power[i], power[0]);
+
+	// now that turbine[i] wind speed, output, thrust, etc. have been calculated, calculate wake characteristics for it, because downwind turbines will need the info
+	bool ok = fillWakeArrays((int)i, adWindSpeed[0], adWindSpeed[i], power[i], Thrust[i], aTurbulence_intensity[i], fabs(aDistanceDownwind[nTurbines - 1] - aDistanceDownwind[i])*dTurbineRadius, &matEVCenterline.at(worker, 0));
+	nearWakeRegionLength(adWindSpeed[i], turbulenceCoeff, Thrust[i], air_density, vmlnTurbines[i]);
+	return ok;
 }
-
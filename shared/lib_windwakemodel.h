@@ -51,6 +51,7 @@
 #define __lib_windwake
 
 #include <vector>
+#include <atomic>
 #include "lib_util.h"
 
 /**
@@ -68,6 +69,7 @@ private:
 						densityCorrectedWS,
 						powerCurveRPM;
 	double cutInSpeed;
+	double densityCorrectedFor;		// air density densityCorrectedWS was last computed for, kg/m^3
 public:
 
 	std::vector<double> getPowerCurveWS(){ return powerCurveWS; }
@@ -85,6 +87,7 @@ public:
 		rotorDiameter = -999;
 		lossesAbsolute = -999;
 		lossesPercent = -999;
+		densityCorrectedFor = -999;
 	}
 	bool setPowerCurve(std::vector<double> windSpeeds, std::vector<double> powerOutput);
 	
@@ -234,12 +237,19 @@ private:
 	/// get deficit by modeling wake beyond near wake region as axisymmetric profile with Gaussian cross-section
 	double wakeDeficit(int upwindTurbine, double distCrosswind, double distDownwind);
 
+	/// upper bound on wakeDeficit from the Gaussian at the point of the rotor closest to the wake centerline
+	double wakeDeficitBound(int upwindTurbine, double distCrosswind, double distDownwind);
+
 	/// Use the Pat Quinlan method to get added TI
 	double addedTurbulenceIntensity(double Ct, double deltaX);
 	
 	double totalTurbulenceIntensity(double ambientTI, double additionalTI, double Uo, double Uw, double partial);
 
-	bool fillWakeArrays(int turbineIndex, double ambientVelocity, double velocityAtTurbine, double power, double thrustCoeff, double turbulenceIntensity, double maxX);
+	bool fillWakeArrays(int turbineIndex, double ambientVelocity, double velocityAtTurbine, double power, double thrustCoeff, double turbulenceIntensity, double maxX, double centerlineVelocity[]);
+
+	/// Calculates the wind speed, power and wake of one turbine, once every turbine upwind of it is marked done (if done is given)
+	bool turbineWakeCalculations(size_t i, size_t worker, const std::atomic<bool> *done, const double airDensity, const double distanceDownwind[], const double distanceCrosswind[],
+		double power[], double eff[], double thrust[], double windSpeed[], double turbulenceIntensity[]);
 
 	/// Using Ii, ambient turbulence intensity, and thrust coeff, calculates the length of the near wake region
 	void nearWakeRegionLength(double U, double Ii, double Ct, double airDensity, VMLN& vmln);
@@ -247,8 +257,12 @@ private:
 	/// Returns the intersection area between the downwind turbine swept area and the wake
 	double simpleIntersect(double distToCenter, double radiusTurbine, double radiusWake);
 
+	size_t nThreads;							// worker threads for the turbine pass, 0 = one per core
+	std::vector<VMLN> vmlnTurbines;				// near wake region of each turbine
+	util::matrix_t<double> matEVCenterline;		// centerline velocity scratch for fillWakeArrays, one row per worker
+
 public:
-	eddyViscosityWakeModel(){ nTurbines = 0; }
+	eddyViscosityWakeModel(){ nTurbines = 0; nThreads = 1; }
 	eddyViscosityWakeModel(size_t numberOfTurbinesInFarm, windTurbine* wt, double turbCoeff){ 
 		wTurbine = wt;
 		rotorDiameter = wt->rotorDiameter;
@@ -269,10 +283,15 @@ public:
 		useFilterFx = true;
 		matEVWakeDeficits.resize_fill(nTurbines, (int)(maxRotorDiameters / axialResolution) + 1, 0.0); // each turbine is row, each col is wake deficit for that turbine at dist
 		matEVWakeWidths.resize_fill(nTurbines, (int)(maxRotorDiameters / axialResolution) + 1, 0.0); // each turbine is row, each col is wake deficit for that turbine at dist
+		vmlnTurbines.resize(nTurbines);
+		nThreads = 1;
 	}
 
 	std::string getModelName(){ return "FastEV"; }
 
+	/// Set the number of threads sharing the turbine pass, 0 for one per core. Small farms always run on one thread.
+	void setThreads(size_t threads){ nThreads = threads; }
+
 	void wakeCalculations(
 		/*INPUTS*/
 		const double airDensity,					// not used in this model
@@ -69,6 +69,31 @@ bool windPowerCalculator::InitializeModel(std::shared_ptr<wakeModelBase>selected
 	return false;
 }
 
+bool windPowerCalculator::InitializeWakeCache(double directionStepDeg, double speedStepMS)
+{
+	if (directionStepDeg <= 0.0 || speedStepMS <= 0.0 || !windTurb || windTurb->powerCurveArrayLength < 1){
+		errDetails = "The wake cache requires positive direction and speed steps and an initialized turbine.";
+		return false;
+	}
+
+	// nodes cover the full circle and the power curve, above which the turbines produce nothing
+	wakeCacheDirectionBins = (size_t)ceil(360.0 / directionStepDeg);
+	wakeCacheDirectionStep = 360.0 / wakeCacheDirectionBins;
+	wakeCacheSpeedStep = speedStepMS;
+	wakeCacheSpeedBins = (size_t)ceil(windTurb->getPowerCurveWS()[windTurb->powerCurveArrayLength - 1] / speedStepMS) + 1;
+
+	wakeCache.assign(wakeCacheDirectionBins * wakeCacheSpeedBins, std::vector<double>());
+	cachePower.resize(nTurbines);
+	cacheThrust.resize(nTurbines);
+	cacheEff.resize(nTurbines);
+	cacheWind.resize(nTurbines);
+	cacheTI.resize(nTurbines);
+	cacheDistDown.resize(nTurbines);
+	cacheDistCross.resize(nTurbines);
+	useWakeCache = true;
+	return true;
+}
+
 std::string windPowerCalculator::GetWakeModelName()
 {
 	if (wakeModel) return wakeModel->getModelName();
@@ -150,6 +175,17 @@ int windPowerCalculator::windPowerUsingResource(/*INPUTS */ double windSpeed, do
 		return 0;
 	}
 
+	// convert barometric pressure in ATM to air density
+	double fAirDensity = (airPressureAtm * physics::Pa_PER_Atm) / (physics::R_GAS_DRY_AIR * physics::CelciusToKelvin(TdryC));   //!Air Density, kg/m^3
+
+	if (useWakeCache)
+		return windPowerUsingWakeCache(windSpeed, windDirDeg, fAirDensity, farmPower, power, thrust, eff, adWindSpeed, TI, distanceDownwind, distanceCrosswind);
+	return windPowerUsingWakeModel(windSpeed, windDirDeg, fAirDensity, farmPower, power, thrust, eff, adWindSpeed, TI, distanceDownwind, distanceCrosswind);
+}
+
+int windPowerCalculator::windPowerUsingWakeModel(double windSpeed, double windDirDeg, double fAirDensity, double *farmPower, double power[], double thrust[],
+	double eff[], double adWindSpeed[], double TI[], double distanceDownwind[], double distanceCrosswind[])
+{
 	size_t i, j;
 	//unsigned char wt_id[MAX_WIND_TURBINES], wid; // unsigned char has 256 limit
 	size_t wt_id[MAX_WIND_TURBINES], wid;
@@ -157,9 +193,6 @@ int windPowerCalculator::windPowerUsingResource(/*INPUTS */ double windSpeed, do
 	for (i = 0; i<nTurbines; i++)
 		wt_id[i] = i;
 
-	// convert barometric pressure in ATM to air density
-	double fAirDensity = (airPressureAtm * physics::Pa_PER_Atm) / (physics::R_GAS_DRY_AIR * physics::CelciusToKelvin(TdryC));   //!Air Density, kg/m^3
-
 	// calculate output power of a turbine
 	double fTurbine_output(0.0), fThrust_coeff(0.0);
 	windTurb->turbinePower(windSpeed, fAirDensity, &fTurbine_output, &fThrust_coeff);
@@ -310,6 +343,92 @@ int windPowerCalculator::windPowerUsingResource(/*INPUTS */ double windSpeed, do
 	return (int)nTurbines;
 }
 
+const double * windPowerCalculator::wakeCacheNode(size_t directionBin, size_t speedBin)
+{
+	std::vector<double> &node = wakeCache[directionBin * wakeCacheSpeedBins + speedBin];
+	if (node.empty())
+	{
+		// run the wake model at sea level density, where the normalized speed is the actual speed
+		double speed = speedBin * wakeCacheSpeedStep, farmPower = 0;
+		if (windPowerUsingWakeModel(speed, directionBin * wakeCacheDirectionStep, physics::AIR_DENSITY_SEA_LEVEL, &farmPower, &cachePower[0], &cacheThrust[0],
+			&cacheEff[0], &cacheWind[0], &cacheTI[0], &cacheDistDown[0], &cacheDistCross[0]) != (int)nTurbines)
+			return 0;
+
+		node.resize(2 * nTurbines);
+		for (size_t i = 0; i < nTurbines; i++)
+		{
+			node[i] = (speed > 0.0) ? cacheWind[i] / speed : 1.0;
+			node[nTurbines + i] = cacheTI[i];
+		}
+	}
+	return &node[0];
+}
+
+int windPowerCalculator::windPowerUsingWakeCache(double windSpeed, double windDirDeg, double fAirDensity, double *farmPower, double power[], double thrust[],
+	double eff[], double adWindSpeed[], double TI[], double distanceDownwind[], double distanceCrosswind[])
+{
+	size_t i;
+
+	// calculate output power of a turbine in the free stream
+	double fTurbine_output(0.0), fThrust_coeff(0.0);
+	windTurb->turbinePower(windSpeed, fAirDensity, &fTurbine_output, &fThrust_coeff);
+	if (windTurb->errDetails.length() > 0){
+		errDetails = windTurb->errDetails;
+		return 0;
+	}
+
+	// normalize the wind speed to sea level density, where the power curve is defined
+	double normalizedSpeed = windSpeed * pow(fAirDensity / physics::AIR_DENSITY_SEA_LEVEL, 1.0 / 3.0);
+
+	// outside the cache the free stream output is zero, so the wake model has nothing to do either
+	if (nTurbines < 2 || fTurbine_output <= 0.0 || normalizedSpeed < 0.0 || normalizedSpeed >= (wakeCacheSpeedBins - 1) * wakeCacheSpeedStep)
+		return windPowerUsingWakeModel(windSpeed, windDirDeg, fAirDensity, farmPower, power, thrust, eff, adWindSpeed, TI, distanceDownwind, distanceCrosswind);
+
+	// bilinear weights between the surrounding nodes, wrapping direction around the circle
+	double direction = fmod(windDirDeg, 360.0);
+	if (direction < 0.0)
+		direction += 360.0;
+	double directionBins = direction / wakeCacheDirectionStep;
+	size_t d0 = (size_t)directionBins % wakeCacheDirectionBins;
+	size_t d1 = (d0 + 1) % wakeCacheDirectionBins;
+	double fd = directionBins - floor(directionBins);
+	double speedBins = normalizedSpeed / wakeCacheSpeedStep;
+	size_t s0 = (size_t)speedBins;
+	double fs = speedBins - s0;
+
+	const double *n00 = wakeCacheNode(d0, s0), *n01 = wakeCacheNode(d0, s0 + 1);
+	const double *n10 = wakeCacheNode(d1, s0), *n11 = wakeCacheNode(d1, s0 + 1);
+	if (!n00 || !n01 || !n10 || !n11)
+		return 0;
+
+	double w00 = (1 - fd)*(1 - fs), w01 = (1 - fd)*fs, w10 = fd*(1 - fs), w11 = fd*fs;
+	*farmPower = 0;
+	for (i = 0; i < nTurbines; i++)
+	{
+		adWindSpeed[i] = windSpeed * (w00*n00[i] + w01*n01[i] + w10*n10[i] + w11*n11[i]);
+		TI[i] = w00*n00[nTurbines + i] + w01*n01[nTurbines + i] + w10*n10[nTurbines + i] + w11*n11[nTurbines + i];
+		windTurb->turbinePower(adWindSpeed[i], fAirDensity, &power[i], &thrust[i]);
+		eff[i] = windTurb->calculateEff(power[i], fTurbine_output);
+		*farmPower += power[i];
+	}
+
+	// downwind, crosswind coordinates in meters from the most upwind and crosswind turbine
+	double Dmin = 0, Cmin = 0;
+	for (i = 0; i < nTurbines; i++)
+	{
+		coordtrans(YCoords[i], XCoords[i], windDirDeg, &distanceDownwind[i], &distanceCrosswind[i]);
+		Dmin = (i == 0) ? distanceDownwind[i] : min_of(distanceDownwind[i], Dmin);
+		Cmin = (i == 0) ? distanceCrosswind[i] : min_of(distanceCrosswind[i], Cmin);
+	}
+	for (i = 0; i < nTurbines; i++)
+	{
+		distanceDownwind[i] -= Dmin;
+		distanceCrosswind[i] -= Cmin;
+	}
+
+	return (int)nTurbines;
+}
+
 
 double windPowerCalculator::windPowerUsingWeibull(double weibull_k, double avg_speed, double ref_height, double energy_turbine[])
 {	// returns same units as 'power_curve'
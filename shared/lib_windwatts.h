@@ -76,6 +76,28 @@ private:
 	void coordtrans(double metersNorth, double metersEast, double fWind_dir_degrees, double *fMetersDownWind, double *metersCrosswind);
 	double gammaln(double x);
 
+	/// Runs the wake model for every turbine pair at the given air density
+	int windPowerUsingWakeModel(double windSpeed, double windDirDeg, double airDensity, double *farmPower, double power[], double thrust[],
+		double eff[], double adWindSpeed[], double TI[], double distanceDownwind[], double distanceCrosswind[]);
+
+	/// Interpolates the wake of each turbine from the wake cache, then applies the power curve at the given air density
+	int windPowerUsingWakeCache(double windSpeed, double windDirDeg, double airDensity, double *farmPower, double power[], double thrust[],
+		double eff[], double adWindSpeed[], double TI[], double distanceDownwind[], double distanceCrosswind[]);
+
+	/// Returns the wake cache node for a direction and density-normalized wind speed bin, running the wake model the first time it is needed
+	const double * wakeCacheNode(size_t directionBin, size_t speedBin);
+
+	/**
+	* Wake cache: the wind speed at each turbine as a fraction of the free stream, and the turbulence intensity at each turbine,
+	* on a grid of wind direction and wind speed normalized to sea level air density. The thrust and power coefficients only depend
+	* on the normalized speed, so the wake fractions do too, and one grid serves every air density. Nodes are filled on first use.
+	*/
+	bool useWakeCache;
+	double wakeCacheDirectionStep, wakeCacheSpeedStep;
+	size_t wakeCacheDirectionBins, wakeCacheSpeedBins;
+	std::vector<std::vector<double>> wakeCache;		// [direction bin * speed bins + speed bin][fraction 0..n-1, TI 0..n-1]
+	std::vector<double> cachePower, cacheThrust, cacheEff, cacheWind, cacheTI, cacheDistDown, cacheDistCross;
+
 public:
 	windTurbine* windTurb;
 	size_t nTurbines;
@@ -86,9 +108,12 @@ public:
 		nTurbines = 0;
 		turbulenceIntensity = 0.0;
 		errDetails="";
+		useWakeCache = false;
+		wakeCacheDirectionStep = wakeCacheSpeedStep = 0.0;
+		wakeCacheDirectionBins = wakeCacheSpeedBins = 0;
 	}
 	
-	static const int MAX_WIND_TURBINES = 300;	// Max turbines in the farm
+	static const int MAX_WIND_TURBINES = 1000;	// Max turbines in the farm
 	static const int MIN_DIAM_EV = 2;			// Minimum number of rotor diameters between turbines for EV wake modeling to work
 	static const int EV_SCALE = 1;				// Uo or 1.0 depending on how you read Ainslie 1988
 
@@ -101,6 +126,12 @@ public:
 
 	size_t GetMaxTurbines() {return MAX_WIND_TURBINES;}
 	bool InitializeModel(std::shared_ptr<wakeModelBase>selectedWakeModel);
+
+	/**
+	* Opt in to interpolating wakes from a cache of direction and speed bins instead of running the wake model every timestep.
+	* Call after the turbine, layout, turbulence intensity and wake model are set. Returns false if the steps are not positive.
+	*/
+	bool InitializeWakeCache(double directionStepDeg, double speedStepMS);
 	std::string GetWakeModelName();
 	std::string GetErrorDetails() { return errDetails; }
 
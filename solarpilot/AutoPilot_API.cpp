@@ -2524,42 +2524,51 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 
 	//------------do the multithreaded run----------------
 	
-	//Create copies of the solar field
+	//No more threads than sun positions
+	int nthreads = min(_n_threads, _sim_total);
+
+	/* 
+	Create copies of the solar field. Each thread needs its own field since Simulate() updates 
+	the heliostat state, but the first thread works on the original field just as the single-threaded
+	version does, so only nthreads-1 copies are made.
+
+	The copied heliostats share their geometry (location, panels, canting, focusing) with the 
+	original field, since Simulate() doesn't change it. Each copy holds the tracking, image and 
+	efficiency state for the sun position it's working on, and neighbor lists that point to its 
+	own heliostats.
+	*/
 	SolarField **SFarr;
-	SFarr = new SolarField*[_n_threads];
-	for(int i=0; i<_n_threads; i++){
+	SFarr = new SolarField*[nthreads];
+	SFarr[0] = _SF;
+	for(int i=1; i<nthreads; i++){
 		SFarr[i] = new SolarField(*_SF);
 	}
 
 	//Create sufficient results arrays in memory
 	sim_results results;
 	results.resize(_sim_total);
-						
-	//Calculate the number of simulations per thread
-	int npert = (int)ceil((float)_sim_total/(float)_n_threads);
+
+	//Sun positions are handed out one at a time from a shared counter rather than in fixed blocks
+	std::atomic<int> sim_queue(0);
 
 	//Create thread objects
-	_simthread = new LayoutSimThread[_n_threads];
-	_n_threads_active = _n_threads;	//Keep track of how many threads are active
+	_simthread = new LayoutSimThread[nthreads];
+	_n_threads_active = nthreads;	//Keep track of how many threads are active
 				
-	int
-		sim_first = 0,
-		sim_last = npert;
-	for(int i=0; i<_n_threads; i++){
+	for(int i=0; i<nthreads; i++){
         std::string istr = my_to_string(i);
-		_simthread[i].Setup(istr, SFarr[i], &results, &sunpos, P, sim_first, sim_last, true, false);
-		sim_first = sim_last;
-		sim_last = min(sim_last+npert, _sim_total);
+		_simthread[i].Setup(istr, SFarr[i], &results, &sunpos, P, 0, _sim_total, true, false);
+		_simthread[i].SetSharedQueue(&sim_queue);
 	}
 	//Run
-	for(int i=0; i<_n_threads; i++)
+	for(int i=0; i<nthreads; i++)
 		thread( &LayoutSimThread::StartThread, std::ref( _simthread[i] ) ).detach();
 			
 
 	//Wait loop
 	while(true){
 		int nsim_done = 0, nsim_remain=0, nthread_done=0;
-		for(int i=0; i<_n_threads; i++){
+		for(int i=0; i<nthreads; i++){
 			if( _simthread[i].IsFinished() )
 				nthread_done ++;
 					
@@ -2574,19 +2583,19 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
 			if( ! _summary_siminfo->setCurrentSimulation(nsim_done) )
 				CancelSimulation();
 		}
-		if(nthread_done == _n_threads) break;
+		if(nthread_done == nthreads) break;
 		std::this_thread::sleep_for(std::chrono::milliseconds(75));
 	}
 
 	//Check to see whether the simulation was cancelled
 	bool cancelled = false;
-	for(int i=0; i<_n_threads; i++){
+	for(int i=0; i<nthreads; i++){
 		cancelled = cancelled || _simthread[i].IsSimulationCancelled();
 	}
     
     //check to see whether simulation errored out
     bool errored_out = false;
-    for(int i=0; i<_n_threads; i++){
+    for(int i=0; i<nthreads; i++){
         errored_out = errored_out || _simthread[i].IsFinishedWithErrors();
     }
     if( errored_out )
@@ -2594,7 +2603,7 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
         CancelSimulation();
         //Get the error messages, if any
         string errmsgs;
-        for(int i=0; i<_n_threads; i++){
+        for(int i=0; i<nthreads; i++){
             for(int j=0; j<(int)_simthread[i].GetSimMessages()->size(); j++)
                 errmsgs.append( _simthread[i].GetSimMessages()->at(j) + "\n");
         }
@@ -2604,8 +2613,8 @@ bool AutoPilot_MT::CalculateOpticalEfficiencyTable(sp_optical_table &opttab)
             
     }
 
-	//Clean up dynamic memory
-	for(int i=0; i<_n_threads; i++){
+	//Clean up dynamic memory. SFarr[0] is the original field.
+	for(int i=1; i<nthreads; i++){
 		delete SFarr[i];
 	}
 	delete [] SFarr;
@@ -59,21 +59,40 @@ using namespace std;
 
 //declare referenced classes
 
+Heliostat::Heliostat()
+	: _geom( new helio_geometry() )
+{
+	_geom->is_user_canted = false;
+	_geom->var_helio = 0;
+}
+
+helio_geometry &Heliostat::editGeometry()
+{
+	/* 
+	Return the geometry for changing. Copies of the heliostat (e.g. in the solar field copies 
+	used by simulation threads) point to the same geometry, so make a private copy first if 
+	it's shared.
+	*/
+	if( _geom.use_count() > 1 )
+		_geom = std::make_shared<helio_geometry>( *_geom );
+	return *_geom;
+}
+
 //Accessors
 double Heliostat::calcTotalEfficiency(){ return eff_data.calcTotalEfficiency(); }
 int Heliostat::getId(){return _id;}
 int *Heliostat::getGroupId(){return _group;}		//(row,col) nodes
-double Heliostat::getFocalX(){return _xfocal;}
-double Heliostat::getFocalY(){return _yfocal;}
+double Heliostat::getFocalX(){return _geom->xfocal;}
+double Heliostat::getFocalY(){return _geom->yfocal;}
 double Heliostat::getSlantRange(){return _slant;}	//[m]
 Receiver *Heliostat::getWhichReceiver(){return _which_rec;}
-double Heliostat::getRadialPos(){ return sqrt( pow(_location.x, 2) + pow(_location.y, 2) + pow(_location.z, 2) ); }
-double Heliostat::getAzimuthalPos(){return atan2(_location.x, _location.y); }	//Radians
-matrix_t<Reflector> *Heliostat::getPanels(){return &_panels;}
+double Heliostat::getRadialPos(){ return sqrt( pow(_geom->location.x, 2) + pow(_geom->location.y, 2) + pow(_geom->location.z, 2) ); }
+double Heliostat::getAzimuthalPos(){return atan2(_geom->location.x, _geom->location.y); }	//Radians
+matrix_t<Reflector> *Heliostat::getPanels(){return &_geom->panels;}
 Vect *Heliostat::getTrackVector(){return &_track;}	//return the tracking vector
 Vect *Heliostat::getTowerVector(){return &_tower_vect;} // return the helio-tower unit vector
-Vect *Heliostat::getCantVector(){return &_cant_vect;}	//Return the canting vector (not normalized)
-sp_point *Heliostat::getLocation(){return &_location;} //Get location vector
+Vect *Heliostat::getCantVector(){return &_geom->cant_vect;}	//Return the canting vector (not normalized)
+sp_point *Heliostat::getLocation(){return &_geom->location;} //Get location vector
 sp_point *Heliostat::getAimPoint(){return &_aim_point;}	//Get the heliostat aim point on the receiver
 sp_point *Heliostat::getAimPointFluxPlane(){return &_aim_fluxplane;}	//aim point in the flux plane coordinates 
 helio_perf_data *Heliostat::getEfficiencyObject(){return &eff_data;}
@@ -90,8 +109,8 @@ double Heliostat::getPowerValue(){return eff_data.power_value;}
 double Heliostat::getRankingMetricValue(){return eff_data.rank_metric;}
 double Heliostat::getAzimuthTrack(){return _azimuth;}
 double Heliostat::getZenithTrack(){return _zenith;}
-double Heliostat::getCollisionRadius(){return _r_collision;}
-double Heliostat::getArea(){return _area;}
+double Heliostat::getCollisionRadius(){return _geom->r_collision;}
+double Heliostat::getArea(){return _geom->area;}
 vector<Heliostat*> *Heliostat::getNeighborList(){return _neighbors;}
 vector<sp_point> *Heliostat::getCornerCoords(){return &_corners;}
 vector<sp_point> *Heliostat::getShadowCoords(){return &_shadow;}
@@ -104,12 +123,12 @@ matrix_t<double> *Heliostat::getHermiteCoefObject(){return &_hcoef;}
 matrix_t<double> *Heliostat::getHermiteNormCoefObject(){return &_hc_tht;}
 double *Heliostat::getImageSize(){return _image_size_xy;}
 void Heliostat::getImageSize(double &sigx_n, double &sigy_n){ sigx_n = _image_size_xy[0]; sigy_n = _image_size_xy[1];}
-string *Heliostat::getHeliostatName(){return &_helio_name;}
+string *Heliostat::getHeliostatName(){return &_geom->helio_name;}
 Heliostat* Heliostat::getMasterTemplate(){return _master_template;}
-var_heliostat* Heliostat::getVarMap(){return _var_helio;}
+var_heliostat* Heliostat::getVarMap(){return _geom->var_helio;}
 
-bool Heliostat::IsUserCant(){return _is_user_canted;} //Fetch
-void Heliostat::IsUserCant(bool setting){_is_user_canted = setting;} //Set
+bool Heliostat::IsUserCant(){return _geom->is_user_canted;} //Fetch
+void Heliostat::IsUserCant(bool setting){editGeometry().is_user_canted = setting;} //Set
 bool Heliostat::IsEnabled(){return _is_enabled;}
 bool Heliostat::IsInLayout(){return _in_layout;}
 void Heliostat::IsEnabled(bool enable){_is_enabled = enable;}
@@ -133,21 +152,18 @@ void Heliostat::setTowerVector(Vect &tow){ _tower_vect = tow; } //Set the helio-
 void Heliostat::setTrackAngleZenith(double zenith){_zenith = zenith;}
 void Heliostat::setTrackAngleAzimuth(double azimuth){_azimuth = azimuth;}
 void Heliostat::setTrackAngles(double azimuth, double zenith){_zenith = zenith; _azimuth = azimuth;}
-void Heliostat::setCantVector(Vect &cant){_cant_vect.Set(cant.i, cant.j, cant.k);}
-void Heliostat::setCantVector(double cant[3]){_cant_vect.Set(cant[0], cant[1], cant[2]);}
+void Heliostat::setCantVector(Vect &cant){editGeometry().cant_vect.Set(cant.i, cant.j, cant.k);}
+void Heliostat::setCantVector(double cant[3]){editGeometry().cant_vect.Set(cant[0], cant[1], cant[2]);}
 void Heliostat::setSlantRange(double L)
 {
     _slant = L; 
-    if(_var_helio->cant_method.mapval() == var_heliostat::CANT_METHOD::ONAXIS_AT_SLANT)
-    {
-        _xfocal = L; 
-        _yfocal = L;
-    }
+    if(_geom->var_helio->cant_method.mapval() == var_heliostat::CANT_METHOD::ONAXIS_AT_SLANT)
+        setFocalLength(L);
 }
 
-void Heliostat::setFocalLengthX(double L){_xfocal = L;}
-void Heliostat::setFocalLengthY(double L){_yfocal = L;}
-void Heliostat::setFocalLength(double L){_yfocal = L; _xfocal = L;}
+void Heliostat::setFocalLengthX(double L){editGeometry().xfocal = L;}
+void Heliostat::setFocalLengthY(double L){editGeometry().yfocal = L;}
+void Heliostat::setFocalLength(double L){helio_geometry &G = editGeometry(); G.yfocal = L; G.xfocal = L;}
 void Heliostat::setWhichReceiver(Receiver *rec){_which_rec = rec;}
 void Heliostat::setPowerToReceiver(double P){eff_data.power_to_rec = P;}
 void Heliostat::setPowerValue(double P){eff_data.power_value = P;}
@@ -160,18 +176,19 @@ void Heliostat::resetMetrics(){
 
 void Heliostat::Create(var_map &V, int htnum)
 {
-    _var_helio = &V.hels.at(htnum);
+    helio_geometry &G = editGeometry();
+    G.var_helio = &V.hels.at(htnum);
 	//set some defaults for local values
-    _helio_name = _var_helio->helio_name.val;
-    _id = _var_helio->id.val;
-    _is_enabled = _var_helio->is_enabled.val;
-    _location.Set(0., 0., 0.);  //default
-    _xfocal = _var_helio->x_focal_length.val;
-    _yfocal = _var_helio->y_focal_length.val;
-    _cant_vect.Set(0., 0., 1.);
+    G.helio_name = G.var_helio->helio_name.val;
+    _id = G.var_helio->id.val;
+    _is_enabled = G.var_helio->is_enabled.val;
+    G.location.Set(0., 0., 0.);  //default
+    G.xfocal = G.var_helio->x_focal_length.val;
+    G.yfocal = G.var_helio->y_focal_length.val;
+    G.cant_vect.Set(0., 0., 1.);
 
-    eff_data.reflectivity = _var_helio->reflectivity.val;
-    eff_data.soiling = _var_helio->soiling.val;
+    eff_data.reflectivity = G.var_helio->reflectivity.val;
+    eff_data.soiling = G.var_helio->soiling.val;
 
 	_track = Vect(); //The tracking vector for the heliostat, defaults to 0,0,1
 	_tower_vect = Vect();  //Heliostat-to-tower unit vector
@@ -189,23 +206,24 @@ void Heliostat::updateCalculatedParameters(var_map &Vm, int htnum)
     double tht = Vm.sf.tht.val;
 
     var_heliostat* V = &Vm.hels.at(htnum);
+    helio_geometry &G = editGeometry();
     //Calculate the area and collision radius
 	if(V->is_round.mapval() == var_heliostat::IS_ROUND::ROUND){
-		_r_collision =  V->diameter.val/2. ;
-		_area =  PI*pow(V->diameter.val/2.,2)*V->reflect_ratio.val ;
+		G.r_collision =  V->diameter.val/2. ;
+		G.area =  PI*pow(V->diameter.val/2.,2)*V->reflect_ratio.val ;
 	}
 	else{
-        _r_collision =
+        G.r_collision =
             sqrt( V->height.val * V->height.val / 4. + V->width.val * V->width.val /4. );
-		_area =
+		G.area =
             V->width.val * V->height.val * V->reflect_ratio.val              //width * height * structural density is the base area
             - V->x_gap.val * V->height.val * (V->n_cant_x.val - 1) - V->y_gap.val * V->width.val * (V->n_cant_y.val - 1)     //subtract off gap areas
             + (V->n_cant_y.val - 1)*(V->n_cant_x.val - 1)* V->x_gap.val * V->y_gap.val 
             ;        //but don't double-count the little squares in both gaps
 	}
 
-    V->area.Setval( _area );
-    V->r_collision.Setval( _r_collision );
+    V->area.Setval( G.area );
+    V->r_collision.Setval( G.r_collision );
     
     //calculate the total convolved optical error to report back
 	double err_elevation, err_azimuth, err_surface_x, err_surface_y, err_reflect_x, err_reflect_y;
@@ -375,7 +393,8 @@ void Heliostat::installPanels() {
 	arrangement is more conveniently conceptualized as an attribute of the heliostat
 	rather than as part of the flux algorithm, so it is placed here instead.
 	*/
-    var_heliostat *V = _var_helio;
+    var_heliostat *V = _geom->var_helio;
+    matrix_t<Reflector> &panels = editGeometry().panels;
 
  //   //Calculate the collision radius
 	//if(V->is_round.val){
@@ -400,15 +419,15 @@ void Heliostat::installPanels() {
 		/* 
 		This configuration allows only 1 facet per heliostat. By default, the canting is normal.
 		*/
-        _panels.resize(1,1);
+        panels.resize(1,1);
 
-		_panels.at(0,0).setId(0);
-		_panels.at(0,0).setType(2);	//Circular
-		_panels.at(0,0).setDiameter(V->diameter.val);
-		_panels.at(0,0).setHeight(V->diameter.val);
-		_panels.at(0,0).setWidth(V->diameter.val);
-		_panels.at(0,0).setPosition(0.,0.,0.);
-		_panels.at(0,0).setAim(0.,0.,1.);
+		panels.at(0,0).setId(0);
+		panels.at(0,0).setType(2);	//Circular
+		panels.at(0,0).setDiameter(V->diameter.val);
+		panels.at(0,0).setHeight(V->diameter.val);
+		panels.at(0,0).setWidth(V->diameter.val);
+		panels.at(0,0).setPosition(0.,0.,0.);
+		panels.at(0,0).setAim(0.,0.,1.);
 
 	}
 	else{	//Rectangular heliostats
@@ -422,13 +441,13 @@ void Heliostat::installPanels() {
 		dy = (V->height.val - V->y_gap.val * (V->n_cant_y.val - 1.) ) / (double)V->n_cant_y.val;	//[m] height of each panel
 
 		int id=0;
-		_panels.resize(V->n_cant_y.val, V->n_cant_x.val);
+		panels.resize(V->n_cant_y.val, V->n_cant_x.val);
         
 		//back-calculate the aim point
         sp_point paim;     //heliostat aimpoint
-		paim.x = _location.x + _slant*_tower_vect.i;
-		paim.y = _location.y + _slant*_tower_vect.j;
-		paim.z = _location.z + _slant*_tower_vect.k;
+		paim.x = _geom->location.x + _slant*_tower_vect.i;
+		paim.y = _geom->location.y + _slant*_tower_vect.j;
+		paim.z = _geom->location.z + _slant*_tower_vect.k;
 
         //initialize X and Y location of the facet
 		y = -V->height.val/2. + dy*0.5;
@@ -439,12 +458,12 @@ void Heliostat::installPanels() {
 
 			for (int i=0; i<V->n_cant_x.val; i++) {
 				//Assign an ID
-				_panels.at(j,i).setId(id); id++;
-				_panels.at(j,i).setType(1);	//Type=1, rectangular panel
-				_panels.at(j,i).setWidth(dx);
-				_panels.at(j,i).setHeight(dy);
+				panels.at(j,i).setId(id); id++;
+				panels.at(j,i).setType(1);	//Type=1, rectangular panel
+				panels.at(j,i).setWidth(dx);
+				panels.at(j,i).setHeight(dy);
 				//Set the position in the reflector plane. Assume the centroid is in the plane (z=0)
-				_panels.at(j,i).setPosition(x, y, 0.0);
+				panels.at(j,i).setPosition(x, y, 0.0);
 				//Determine how each panel is canted
 				switch(V->cant_method.mapval())
 				{
@@ -452,18 +471,18 @@ void Heliostat::installPanels() {
                 case var_heliostat::CANT_METHOD::ONAXIS_AT_SLANT:
                 {
 					double hyp = sqrt( pow(_slant,2) + pow(x, 2) + pow(y, 2) );	//hypotenuse length
-					_panels.at(j,i).setAim(-x/hyp, -y/hyp, 2.*_slant/hyp);
+					panels.at(j,i).setAim(-x/hyp, -y/hyp, 2.*_slant/hyp);
 					break;
                 }
                 //case CANT_TYPE::FLAT:		//no canting
                 case var_heliostat::CANT_METHOD::NO_CANTING:
-					_panels.at(j,i).setAim(0.,0.,1.);
+					panels.at(j,i).setAim(0.,0.,1.);
 					break;
                 //case CANT_TYPE::ON_AXIS_USER:		//User-defined on-axis canting. Canting specified in array.
                 case var_heliostat::CANT_METHOD::ONAXIS_USERDEFINED:
                 {
 					double hyp = sqrt( V->cant_radius.Val()*V->cant_radius.Val() + x*x + y*y );	//cant focal length
-					_panels.at(j,i).setAim(-x/hyp, -y/hyp, 2.*V->cant_radius.Val()/hyp);
+					panels.at(j,i).setAim(-x/hyp, -y/hyp, 2.*V->cant_radius.Val()/hyp);
 					break;
                 }
                 //case CANT_TYPE::AT_DAY_HOUR:		//Individual off-axis cant at time defined by tracking vector
@@ -477,9 +496,9 @@ void Heliostat::installPanels() {
 					double prad = sqrt(pow(x,2)+pow(y*sin(track_zen),2));	//the radius of the panel from the heliostat centroid
 					double theta_rot = atan2(x,y);	//angle of rotation of the centroid of the point w/r/t the heliostat coordinates
                     sp_point pg;
-					pg.x = _location.x + prad*sin(track_az+theta_rot);
-					pg.y = _location.y + prad*cos(track_az+theta_rot);
-					pg.z = _location.z + y*sin(track_zen);
+					pg.x = _geom->location.x + prad*sin(track_az+theta_rot);
+					pg.y = _geom->location.y + prad*cos(track_az+theta_rot);
+					pg.z = _geom->location.z + y*sin(track_zen);
 
 					//determine the vector from the panel centroid to the aim point
 					double pslant = sqrt( pow(pg.x - paim.x, 2) + pow(pg.y - paim.y, 2) + pow(pg.z - paim.z, 2));
@@ -496,7 +515,7 @@ void Heliostat::installPanels() {
 
 					//The canting correction vector is the average of the sun vector and the reflection vector subtracting 
 					//the total heliostat tracking vector
-					_panels.at(j,i).setAim( (s_hat.i + pref.i)/2. - _track.i, (s_hat.j + pref.j)/2. - _track.j, (s_hat.k + pref.k)/2. - _track.k + 1.);
+					panels.at(j,i).setAim( (s_hat.i + pref.i)/2. - _track.i, (s_hat.j + pref.j)/2. - _track.j, (s_hat.k + pref.k)/2. - _track.k + 1.);
 				
 					break;
                 }
@@ -514,10 +533,10 @@ void Heliostat::installPanels() {
                     plane containing the heliostat in the direction of the viewer (i.e. it hits you in the face). This is -z. The if the 
                     vector tilts to the right as viewed, this is +i / +x, up is +j / +y.
                     */
-                    paim.Set( _cant_vect.i * rscale - x, _cant_vect.j * rscale - y, _cant_vect.k * rscale );
+                    paim.Set( _geom->cant_vect.i * rscale - x, _geom->cant_vect.j * rscale - y, _geom->cant_vect.k * rscale );
                     //normalize
                     Toolbox::unitvect( paim );
-                    _panels.at(j,i).setAim( paim );
+                    panels.at(j,i).setAim( paim );
 
                     break;
                 }
@@ -571,7 +590,7 @@ void Heliostat::updateTrackVector(Vect &sunvect) {
 	//Create a vector between the heliostat and the aim point
     if( _is_enabled )
     {
-        t_hat.Set(_aim_point.x - _location.x, _aim_point.y - _location.y, _aim_point.z - _location.z);
+        t_hat.Set(_aim_point.x - _geom->location.x, _aim_point.y - _geom->location.y, _aim_point.z - _geom->location.z);
 	    
         Toolbox::unitvect(t_hat);
         
@@ -598,7 +617,7 @@ void Heliostat::updateTrackVector(Vect &sunvect) {
         n_hat.Set(0., 0., 1.);
 
 	    //make tracking angles so that heliostat "faces" tower position when in stow
-	    setTrackAngles(atan2(_location.x,_location.y), 0.);
+	    setTrackAngles(atan2(_geom->location.x,_geom->location.y), 0.);
     }
 			
 	
@@ -615,9 +634,9 @@ void Heliostat::updateTrackVector(Vect &sunvect) {
 	Assume that the heliostat is starting out facing upward in the z direction with the 
 	upper and lower edges parallel to the global x axis (i.e. zenth=0, azimuth=0)
 	*/
-	if(! ( _var_helio->is_round.mapval() == var_heliostat::IS_ROUND::ROUND)){
-        double wm2 = _var_helio->width.val/2.;
-        double hm2 = _var_helio->height.val/2.;
+	if(! ( _geom->var_helio->is_round.mapval() == var_heliostat::IS_ROUND::ROUND)){
+        double wm2 = _geom->var_helio->width.val/2.;
+        double hm2 = _geom->var_helio->height.val/2.;
 		_corners.resize(4);
 	
 		_corners.at(0).Set(-wm2, -hm2, 0.);	//Upper right corner
@@ -631,7 +650,7 @@ void Heliostat::updateTrackVector(Vect &sunvect) {
 			//Now rotate about the z-axis (azimuth)
 			Toolbox::rotation(_azimuth, 2, _corners.at(i));
 			//Move from heliostat coordinates to global coordinates
-			_corners.at(i).Add(_location.x, _location.y, _location.z); 
+			_corners.at(i).Add(_geom->location.x, _geom->location.y, _geom->location.z); 
 		}
 	}
 	else{ 
@@ -669,9 +688,10 @@ void Heliostat::calcAndSetAimPointFluxPlane(sp_point &aimpos_abs, Receiver &Rec,
 void Heliostat::setLocation(double x, double y, double z)
 {
 	//Set the location 
-	_location.x = x;
-	_location.y = y;
-	_location.z = z;
+	sp_point &location = editGeometry().location;
+	location.x = x;
+	location.y = y;
+	location.z = z;
 }
 
 //--------------Reflector class methods ----------------------
@@ -738,26 +758,26 @@ void Reflector::setOrientation(PointVect &PV){
 
 Reflector *Heliostat::getPanelById(int id){
     size_t ncantx, ncanty;
-    _panels.size(ncantx, ncanty);  //is this the right order?
+    _geom->panels.size(ncantx, ncanty);  //is this the right order?
 
 	for (int j=0; j<(int)ncantx; j++) {
 		for (int i=0; i<(int)ncanty; i++) {
-		  	if (_panels.at(j,i).getId() == id) {
-			  	return &_panels.at(j,i);
+		  	if (_geom->panels.at(j,i).getId() == id) {
+			  	return &_geom->panels.at(j,i);
 			}
 		}
 	}
 
 	//#####call an error here
-	return &_panels.at(0, 0);
+	return &_geom->panels.at(0, 0);
 }
 
 Reflector *Heliostat::getPanel(int row, int col){
 	int nr, nc;
-	nr = (int)_panels.nrows();
-	nc = (int)_panels.ncols();
+	nr = (int)_geom->panels.nrows();
+	nc = (int)_geom->panels.ncols();
 	if(row < nr && col < nc) {
-	  	return &_panels.at(row, col);
+	  	return &_geom->panels.at(row, col);
 	}
 	else{
 		//FLAG -- this should be an error
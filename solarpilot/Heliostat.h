@@ -50,6 +50,7 @@
 #ifndef _HELIOSTAT_H_
 #define _HELIOSTAT_H_ 1
 #include <vector>
+#include <memory>
 #include <math.h>
 #include "heliodata.h"
 #include "mod_base.h"
@@ -62,21 +63,44 @@ class SolarField;
 class Receiver;
 class Ambient;
 
+/* 
+Heliostat properties that are set up with the layout and don't change with the sun position. 
+Copies of a heliostat share one geometry object, which the Heliostat setters copy before 
+changing it if it's shared. The pointers returned by the Heliostat getters are only for reading.
+*/
+struct helio_geometry
+{
+	sp_point
+		location; //Location of heliostat in the field (0,0,Zt) is the location of the tower base
+	Vect
+		cant_vect;	//Canting vector (not normalized)
+	matrix_t<Reflector>
+		panels; //Array of cant panels
+	bool
+		is_user_canted;	//Are the panels canted according to user-specified values?
+	double
+		xfocal, //[m] focal length in the i^ direction
+		yfocal, //[m] focal length in the j^ direction
+        r_collision,   //[m] Collision radius of the heliostat
+        area;          //[m2] reflective area of the heliostat
+	std::string
+		helio_name;		//Heliostat template name
+    var_heliostat *var_helio; //pointer to applicable variable map
+};
+
 class Heliostat : public mod_base
  {
 
+	std::shared_ptr<helio_geometry>
+		_geom;	//Geometry, shared with copies of this heliostat until one of them changes it
 	sp_point
-		_location, //Location of heliostat in the field (0,0,Zt) is the location of the tower base
 		_aim_point,	//constant aim point for the heliostat
 		_aim_fluxplane;	//Aim point with respect to the flux plane
 	Vect
 		_track, //The tracking vector for the heliostat
-		_tower_vect,  //Heliostat-to-tower unit vector
-		_cant_vect;	//Canting vector (not normalized)
+		_tower_vect;  //Heliostat-to-tower unit vector
 	std::vector<Heliostat*>
 		*_neighbors; //pointer to a vector of neighboring heliostats
-	matrix_t<Reflector>
-		_panels; //Array of cant panels
 	std::vector<sp_point>
 		_corners,	//Position in global coordinates of the heliostat corners (used for blocking and shadowing)
 		_shadow;	//Position in global coordinates of the heliostat shadow
@@ -93,7 +117,6 @@ class Heliostat : public mod_base
 
 	bool
 		_in_layout, // Is the heliostat included in the final layout?
-		_is_user_canted,	//Are the panels canted according to user-specified values?
 		_is_enabled;		//Is template enabled?
 
 
@@ -101,27 +124,21 @@ class Heliostat : public mod_base
 		_id, //Unique ID number for the heliostat/surface
 		_group[2];	//Integers {row,col} used to determine which local group the heliostat is in. 
 
-	double
-		_xfocal, //[m] focal length in the i^ direction
-		_yfocal; //[m] focal length in the j^ direction
-
 	helio_perf_data
 		eff_data;
 	double
 		_slant,		//[m] Heliostat slant range - path length from centroid to receiver aim point
 		_zenith,	//[rad] Heliostat tracking zenith angle
 		_azimuth,	//[rad] Heliostat tracking azimuth angle
-        _r_collision,   //[m] Collision radius of the heliostat
-        _area,          //[m2] reflective area of the heliostat
 		_image_size_xy[2];	//[m/m] Image size on the receiver plane in {x,y}, normalized by tower height
-	std::string
-		_helio_name;		//Heliostat template name
 	Receiver *_which_rec;	//Which of the receivers is the heliostat pointing at?
 
-    var_heliostat *_var_helio; //pointer to applicable variable map
+	helio_geometry &editGeometry();	//Geometry to change, copied first if other heliostats share it
 		
 public:
 
+	Heliostat();
+
 	//Declare other subroutines
 	void Create(var_map &V, int htemp_number);
     void updateCalculatedParameters(var_map &V, int htemp_number);
@@ -67,6 +67,7 @@ void LayoutSimThread::Setup(string &tname, SolarField *SF, sim_results *results,
 	_sol_azzen = 0;
 	_sim_first = sim_first;
 	_sim_last = sim_last;
+	_sim_queue = 0;
 	Finished = false;
 	CancelFlag = false;
 	Nsim_complete = 0;
@@ -104,6 +105,7 @@ void LayoutSimThread::Setup(string &tname, SolarField *SF, sim_results *results,
 	_sol_azzen = sol_azzen;
 	_sim_first = sim_first;
 	_sim_last = sim_last;
+	_sim_queue = 0;
 	Finished = false;
 	CancelFlag = false;
 	Nsim_complete = 0;
@@ -120,6 +122,18 @@ void LayoutSimThread::IsFluxmapNormalized(bool is_normal)
 	_is_flux_normalized = is_normal;
 }
 
+void LayoutSimThread::SetSharedQueue(std::atomic<int> *sim_queue)
+{
+	/* 
+	Rather than simulating the fixed range [sim_first, sim_last), take the next unclaimed 
+	simulation index from a counter shared with the other threads until it reaches sim_last.
+	Threads that draw cheap sun positions keep working instead of sitting idle.
+
+	The caller initializes the counter to sim_first.
+	*/
+	_sim_queue = sim_queue;
+}
+
 void LayoutSimThread::CancelSimulation()
 {
 	CancelLock.lock();
@@ -219,7 +233,9 @@ void LayoutSimThread::StartThread() //Entry()
 	    if(_sim_last < 0) _sim_last = _wdata->size();
 
 	    int nsim = _sim_last - _sim_first + 1;
-	    for(int i=_sim_first; i<_sim_last; i++){
+	    int nsim_done = 0;
+	    int i = _sim_queue != 0 ? (*_sim_queue)++ : _sim_first;
+	    for( ; i<_sim_last; i = _sim_queue != 0 ? (*_sim_queue)++ : i+1){
 		    //_SF->getSimInfoObject()->setCurrentSimulation(i+1);
 		    //double args[5];
             sim_params P;
@@ -299,7 +315,9 @@ void LayoutSimThread::StartThread() //Entry()
 			    _results->at(i).process_flux(_SF, _is_flux_normalized);
 
 		    //Update progress
-		    UpdateStatus(i-_sim_first+1,nsim);
+		    nsim_done++;
+		    UpdateStatus(_sim_queue != 0 ? nsim_done : i-_sim_first+1, nsim);
+
 		    //Check for user cancel
 		    StatusLock.lock();
 		    is_cancel = this->CancelFlag; 
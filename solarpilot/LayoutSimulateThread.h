@@ -56,6 +56,7 @@
 #ifdef SP_USE_THREADS
 #include <thread>
 #include <mutex>
+#include <atomic>
 
 
 class Heliostat;	//Forward declaration
@@ -81,6 +82,7 @@ class LayoutSimThread
 
 	SolarField *_SF;
 	int _sim_first, _sim_last, _sort_metric;
+	std::atomic<int> *_sim_queue;	//Optional next-simulation counter shared between threads (null for a fixed range)
 	WeatherData *_wdata;
 	sim_results *_results;
 	matrix_t<double> *_sol_azzen;
@@ -104,6 +106,9 @@ public:
 
 	void IsFluxmapNormalized(bool is_normal);	//set whether the fluxmap should be normalized (default TRUE)
 
+	void SetSharedQueue(std::atomic<int> *sim_queue);	//take simulations from a counter shared with other threads instead of a fixed range
+
+
 	void CancelSimulation();
 
 	bool IsSimulationCancelled();
@@ -157,7 +157,7 @@ SolarField::SolarField( const SolarField &sf )
 	_cancel_flag( sf._cancel_flag ),
 	_is_created( sf._is_created ),
 	_layout( sf._layout ),
-	_helio_objects( sf._helio_objects ),	//This contains the heliostat objects. The heliostat constructor will handle all internal pointer copy operations
+	_helio_objects( sf._helio_objects ),	//This contains the heliostat objects. The heliostat constructor will handle all internal pointer copy operations. The copies share the heliostat geometry.
 	_helio_template_objects( sf._helio_template_objects ),	//This contains the heliostat template objects.
 	_land( sf._land ),
 	_financial( sf._financial ),
@@ -568,12 +568,39 @@ bool SolarField::UpdateNeighborList(double lims[4], double zen){
 	dcol = (xmax - xmin)/float(ncol);
 	drow = (ymax - ymin)/float(nrow);			//The column and row node width
 
+	int col, row;	//indicates which node the heliostat is in
+	int Npos = (int)_helio_objects.size();
+
+	/* 
+	The mesh only depends on the sun position through the interaction radius, which is set by blocking rather 
+	than shadowing for most of the day. If every heliostat still falls in the node it was assigned to in the
+	previous call, the existing groups and neighbor lists are still valid and don't need to be rebuilt.
+	*/
+	if((int)_neighbors.nrows() == nrow && (int)_neighbors.ncols() == ncol){
+		bool is_current = true;
+		int ngrouped = 0;
+		for(int i=0; i<nrow; i++)
+			for(int j=0; j<ncol; j++)
+				ngrouped += (int)_helio_groups.at(i,j).size();
+		if(ngrouped != Npos) is_current = false;
+
+		for(int i=0; i<Npos && is_current; i++){
+			Heliostat *hptr = &_helio_objects.at(i);
+			row = (int)(floor((hptr->getLocation()->y - ymin)/drow));
+			row = (int)fmax(0., fmin(row, nrow-1));
+			col = (int)(floor((hptr->getLocation()->x - xmin)/dcol));
+			col = (int)fmax(0., fmin(col, ncol-1));
+			int *group = hptr->getGroupId();
+			is_current = group[0] == row && group[1] == col && hptr->getNeighborList() == &_neighbors.at(row,col);
+		}
+		if(is_current) return true;
+	}
+
 	//resize the mesh array accordingly
 	_helio_groups.resize_fill(nrow, ncol, Hvector());
 
-	int col, row;	//indicates which node the heliostat is in
-	int Npos = (int)_helio_objects.size();
 	for(int i=0; i<Npos; i++){
+
 		Heliostat *hptr = &_helio_objects.at(i);
 		//Find which node to add this heliostat to
 		row = (int)(floor((hptr->getLocation()->y - ymin)/drow));
@@ -3279,8 +3306,8 @@ double SolarField::calcShadowBlock(Heliostat *H, Heliostat *HI, int mode, Vect &
 			*HIt = HI->getTrackVector(),	//Interfering heliostat track vector
 			*Ht = H->getTrackVector();	//Base heliostat track vector
 		double HIh = HI->getVarMap()->height.val;
-		//Interfering heliostat tracking zenith 
-		double HIzen = acos(HIt->k);	//zenith angle 
+		//Interfering heliostat tracking zenith. Only its sine is needed: sin(acos(k)) = sqrt(1-k^2)
+		double sinHIzen = sqrt(fmax(1. - HIt->k*HIt->k, 0.));
 		//double HIaz = atan2(HIt->i,HIt->j);	//azimuth angle
 
 		/*
@@ -3291,42 +3318,45 @@ double SolarField::calcShadowBlock(Heliostat *H, Heliostat *HI, int mode, Vect &
 		*/
 		HIloc = HI->getLocation();
 		Hloc = H->getLocation();
-		//double l_max = (HIloc->z - Hloc->z + HIh*sin(HIzen))/tan(PI/2.-zen) + HIh*cos(HIzen);
-		double tanpi2zen = H_inter->k/sqrt(H_inter->i*H_inter->i + H_inter->j*H_inter->j);
-		double l_max = (HIloc->z - Hloc->z + HIh*sin(HIzen))/tanpi2zen + HIh*HIt->k;
-		l_max = fmin(l_max, interaction_limit*HIh);	//limit to a reasonable number
 
 		//Create a vector pointing from the heliostat to the interfering neighbor
 		Vect Hnn;
 		Hnn.Set(HIloc->x - Hloc->x, HIloc->y - Hloc->y, HIloc->z - Hloc->z);
 
-		//How close are the heliostats?
-		double hdist = sqrt(Hnn.i*Hnn.i + Hnn.j*Hnn.j + Hnn.k*Hnn.k);
+		//If the heliostat is not in front of the other with respect to the solar position, it also can't shadow.
+		//This is the cheapest test and rejects about half of the neighbors, so do it first.
+		if( Toolbox::dotprod(Hnn, *H_inter) < 0.) return 0.; 
+
+		//double l_max = (HIloc->z - Hloc->z + HIh*sin(HIzen))/tan(PI/2.-zen) + HIh*cos(HIzen);
+		double tanpi2zen = H_inter->k/sqrt(H_inter->i*H_inter->i + H_inter->j*H_inter->j);
+		double l_max = (HIloc->z - Hloc->z + HIh*sinHIzen)/tanpi2zen + HIh*HIt->k;
+		l_max = fmin(l_max, interaction_limit*HIh);	//limit to a reasonable number
+
+		//How close are the heliostats? Compare squared distances to avoid the square root.
+		double hdist2 = Hnn.i*Hnn.i + Hnn.j*Hnn.j + Hnn.k*Hnn.k;
 		
-		if(hdist > l_max) return 0.;	//No possibility of interfering, return here.
+		if(l_max < 0. || hdist2 > l_max*l_max) return 0.;	//No possibility of interfering, return here.
 		//Check for collision radius
 		double 
 			Hh = H->getVarMap()->height.val,	//Shaded heliostat height
 			Hw = H->getVarMap()->width.val;	//Shaded heliostat width
 		//double Hr = sqrt(pow(Hh/2.,2) + pow(Hw/2.,2));
-		//If the heliostat is not in front of the other with respect to the solar position, it also can't shadow
-		if( Toolbox::dotprod(Hnn, *H_inter) < 0.) return 0.; 
 
 
 		//-----------test
 		vector<sp_point> 
-			*cobj = HI->getCornerCoords(),
-			ints(2);	//intersection points
-		vector<bool> hits(2, false);	//track whether either point hit
+			*cobj = HI->getCornerCoords();
+		sp_point ints[2];	//intersection points
+		bool hits[2] = {false, false};	//track whether either point hit
 		int i;
 		for(i=0; i<2; i++){
-			if( Toolbox::plane_intersect(*Hloc, *Ht, cobj->at(i), *H_inter, ints.at(i)) ){
+			if( Toolbox::plane_intersect(*Hloc, *Ht, cobj->at(i), *H_inter, ints[i]) ){
 				//An intercept on the plane was detected. Is the intercept within the heliostat area?
-				hits.at(i) = Toolbox::pointInPolygon(*H->getCornerCoords(), ints.at(i) );
+				hits[i] = Toolbox::pointInPolygon(*H->getCornerCoords(), ints[i] );
 			}
 		}
 		//Do either of the corners shadow/block the heliostat?
-		if(hits.at(0) || hits.at(1)){
+		if(hits[0] || hits[1]){
 			//interfering detected. 
 			double dx_inter, dy_inter;
 			
@@ -3334,30 +3364,30 @@ double SolarField::calcShadowBlock(Heliostat *H, Heliostat *HI, int mode, Vect &
 			To calculate the fraction of energy lost, we first transform the intersection point into heliostat coordinates
 			so that it's easier to find how the shadow is cast on the heliostat.
 			*/
-			vector<sp_point> ints_trans(2);	//Copy of the intersection points for heliostat coordinate transform
+			sp_point ints_trans[2];	//Copy of the intersection points for heliostat coordinate transform
 			for(i=0; i<2; i++){
 				//Express each point of HI in global coords relative to the centroid of H
 				//i.e. (ints_trans.x - H->x, ... )
-				ints_trans.at(i).Set(ints.at(i).x - Hloc->x, ints.at(i).y - Hloc->y, ints.at(i).z - Hloc->z);
+				ints_trans[i].Set(ints[i].x - Hloc->x, ints[i].y - Hloc->y, ints[i].z - Hloc->z);
 
 				//First rotate azimuthally back to the north position
-				Toolbox::rotation(-H->getAzimuthTrack(), 2, ints_trans.at(i));
+				Toolbox::rotation(-H->getAzimuthTrack(), 2, ints_trans[i]);
 				//Next rotate in zenith to get it into heliostat coords. The z component should be very small or zero. 
 				//Y components should be relatively close for rectangular heliostats
-				Toolbox::rotation(-H->getZenithTrack(), 0, ints_trans.at(i));
+				Toolbox::rotation(-H->getZenithTrack(), 0, ints_trans[i]);
 			}
 			
 			//Based on how the image appears, determine interfering. 
 			//Recall that after transformation, the positive y edge corresponds to the bottom of the heliostat.
 			int which_is_off, which_is_on;
-			if(hits.at(0) && hits.at(1)) {
+			if(hits[0] && hits[1]) {
 				//Both corners are active in interfering (i.e. the shadow image is contained within the shadowed heliostat
-				dy_inter = ( Hh - (ints_trans.at(0).y + ints_trans.at(1).y) ) / (2. * Hh);	//Use the average z position of both points
-				dx_inter = fabs(ints_trans.at(0).x - ints_trans.at(1).x ) / Hw;
+				dy_inter = ( Hh - (ints_trans[0].y + ints_trans[1].y) ) / (2. * Hh);	//Use the average z position of both points
+				dx_inter = fabs(ints_trans[0].x - ints_trans[1].x ) / Hw;
 
 				return dy_inter * dx_inter;
 			}
-			else if(hits.at(0)) { 
+			else if(hits[0]) { 
 				//Only the first corner appears in the shadow/blocking image
 				which_is_off = 1;
 				which_is_on = 0;
@@ -3368,14 +3398,15 @@ double SolarField::calcShadowBlock(Heliostat *H, Heliostat *HI, int mode, Vect &
 				which_is_on = 1;
 			}
 			
-			dy_inter = (Hh/2. - ints_trans.at(which_is_on).y) / Hh;	//The z-interfering component	
-			if( ints_trans.at(which_is_off).x > Hw/2. ){ // The shadow image spills off the +x side of the heliostat
-				dx_inter = .5 - ints_trans.at(which_is_on).x / Hw;
+			dy_inter = (Hh/2. - ints_trans[which_is_on].y) / Hh;	//The z-interfering component	
+			if( ints_trans[which_is_off].x > Hw/2. ){ // The shadow image spills off the +x side of the heliostat
+				dx_inter = .5 - ints_trans[which_is_on].x / Hw;
 			}
 			else {	//The shadow image spills off the -x side of the heliostat
-				dx_inter = ints_trans.at(which_is_on).x / Hw + .5;
+				dx_inter = ints_trans[which_is_on].x / Hw + .5;
 			}
 
+
 			return dy_inter * dx_inter;
 		}
 		else{	//No interfering
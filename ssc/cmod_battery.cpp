@@ -168,6 +168,7 @@ var_info vtab_battery_inputs[] = {
 	{ SSC_INPUT,        SSC_NUMBER,     "batt_auto_gridcharge_max_daily",              "Allowed grid charging percent per day for automated dispatch","kW",  "",                     "Battery",       "",                           "",                             "" },
 	{ SSC_INPUT,        SSC_NUMBER,     "batt_look_ahead_hours",                       "Hours to look ahead in automated dispatch",              "hours",    "",                     "Battery",       "",                           "",                             "" },
 	{ SSC_INPUT,        SSC_NUMBER,     "batt_dispatch_update_frequency_hours",        "Frequency to update the look-ahead dispatch",            "hours",    "",                     "Battery",       "",                           "",                             "" },
+	{ SSC_INPUT,        SSC_NUMBER,     "batt_dispatch_auto_optimal",                  "Solve front-of-meter automated dispatch exactly over the look-ahead", "0/1", "0=HeuristicRules,1=DynamicProgram", "Battery", "?=0",                  "BOOLEAN",                      "" },
 
 	//  cycle cost inputs
 	{ SSC_INPUT,        SSC_NUMBER,     "batt_cycle_cost_choice",                      "Use SAM model for cycle costs or input custom",           "0/1",     "0=UseCostModel,1=InputCost", "Battery", "",                           "",                             "" },
@@ -392,6 +393,7 @@ battstor::battstor(compute_module &cm, bool setup_model, size_t nrec, double dt_
 				{
 					batt_vars->batt_look_ahead_hours = cm.as_unsigned_long("batt_look_ahead_hours");
 					batt_vars->batt_dispatch_update_frequency_hours = cm.as_double("batt_dispatch_update_frequency_hours");
+					batt_vars->batt_dispatch_auto_optimal = cm.as_boolean("batt_dispatch_auto_optimal");
 				}
 				else if (batt_vars->batt_dispatch == dispatch_t::FOM_CUSTOM_DISPATCH)
 				{
@@ -862,6 +864,12 @@ battstor::battstor(compute_module &cm, bool setup_model, size_t nrec, double dt_
 			batt_vars->ppa_factors, batt_vars->ppa_weekday_schedule, batt_vars->ppa_weekend_schedule, utilityRate,
 			batt_vars->batt_dc_dc_bms_efficiency, efficiencyCombined , efficiencyCombined);
 
+		if (batt_vars->batt_dispatch_auto_optimal)
+		{
+			if (dispatch_automatic_front_of_meter_t * dispatch_fom = dynamic_cast<dispatch_automatic_front_of_meter_t*>(dispatch_model))
+				dispatch_fom->set_optimal_dispatch(true);
+		}
+
 		if (batt_vars->batt_dispatch == dispatch_t::CUSTOM_DISPATCH)
 		{
 			if (dispatch_automatic_front_of_meter_t * dispatch_fom = dynamic_cast<dispatch_automatic_front_of_meter_t*>(dispatch_model))
@@ -120,6 +120,9 @@ struct batt_variables
 	/*! The frequency to update the look-ahead automated dispatch */
 	double batt_dispatch_update_frequency_hours;
 
+	/*! Solve the front-of-meter look-ahead with the dynamic program instead of the heuristic rules */
+	bool batt_dispatch_auto_optimal;
+
 	util::matrix_t<double>  batt_lifetime_matrix;
 	util::matrix_t<double> batt_calendar_lifetime_matrix;
 	util::matrix_t<double> batt_voltage_matrix;
@@ -73,6 +73,7 @@ static var_info _cm_vtab_pvsamv1[] = {
 	{ SSC_INPUT,        SSC_ARRAY,       "dc_lifetime_losses",                          "Lifetime daily DC losses",                             "%",        "",                              "pvsamv1",             "en_dc_lifetime_losses=1",    "",                             "" },
 	{ SSC_INPUT,        SSC_NUMBER,      "en_ac_lifetime_losses",                       "Enable lifetime daily AC losses",                      "0/1",      "",                              "pvsamv1",             "?=0",                        "INTEGER,MIN=0,MAX=1",          "" },
 	{ SSC_INPUT,        SSC_ARRAY,       "ac_lifetime_losses",                          "Lifetime daily AC losses",                             "%",        "",                              "pvsamv1",             "en_ac_lifetime_losses=1",    "",                             "" },
+	{ SSC_INPUT,        SSC_NUMBER,      "en_lifetime_irrad_replay",                    "Reuse year 1 irradiance for lifetime simulation",      "0/1",      "",                              "pvsamv1",             "?=0",                        "INTEGER,MIN=0,MAX=1",          "" },
 
 	//SEV: Activating the snow model
 	{ SSC_INPUT,        SSC_NUMBER,      "en_snow_model",                               "Toggle snow loss estimation",                          "0/1",      "",                              "snowmodel",            "?=0",                       "BOOLEAN",                      "" },
@@ -1195,6 +1196,20 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 	std::vector<double> dcVoltagePerMppt; //Voltage in V at each MPPT input on the system for THIS TIMESTEP ONLY	
 	std::vector<std::vector<double>> dcStringVoltage; // Voltage of string for each subarray
 	double dcPowerNetTotalSystem = 0; //Net DC power in W for the entire system (sum of all subarrays)
+	std::vector<double> dcShadeFactor(num_subarrays, 1.0); //DC shading database derate for each subarray for THIS TIMESTEP ONLY
+
+	// lifetime irradiance replay: weather and array geometry repeat every year, so the sun position, POA, shading,
+	// and rear-side results of the first year are stored and reused in later years. only the electrical models are re-run.
+	bool replayIrradiance = system_use_lifetime_output && nyears > 1 && as_boolean("en_lifetime_irrad_replay");
+	std::vector<poa_replay_t> poaReplay;
+	std::vector<double> replaySolarZenith;
+	std::vector<int> replaySunUp;
+	if (replayIrradiance)
+	{
+		poaReplay.resize(nrec * num_subarrays);
+		replaySolarZenith.resize(nrec);
+		replaySunUp.resize(nrec);
+	}
 
 	for (int mpptInput = 0; mpptInput < PVSystem->Inverter->nMpptInputs; mpptInput++)
 	{
@@ -1266,6 +1281,14 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 				double solazi = 0, solzen = 0, solalt = 0;
 				int sunup = 0;
 
+				size_t irec = idx % nrec;
+				bool replayStep = replayIrradiance && iyear > 0;
+				if (replayStep)
+				{
+					solzen = replaySolarZenith[irec];
+					sunup = replaySunUp[irec];
+				}
+
 				// accumulators for radiation power (W) over this 
 				// timestep from each subarray
 				double ts_accum_poa_front_nom = 0.0;
@@ -1294,6 +1317,24 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 						|| Subarrays[nn]->nStrings < 1)
 						continue; // skip disabled subarrays
 
+					if (replayStep)
+					{
+						const poa_replay_t &replay = poaReplay[irec * num_subarrays + nn];
+						Subarrays[nn]->poa.poaBeamFront = replay.poaBeamFront;
+						Subarrays[nn]->poa.poaDiffuseFront = replay.poaDiffuseFront;
+						Subarrays[nn]->poa.poaGroundFront = replay.poaGroundFront;
+						Subarrays[nn]->poa.poaRear = replay.poaRear;
+						Subarrays[nn]->poa.poaTotal = replay.poaTotal;
+						Subarrays[nn]->poa.angleOfIncidenceDegrees = replay.angleOfIncidenceDegrees;
+						Subarrays[nn]->poa.sunUp = replay.sunUp;
+						Subarrays[nn]->poa.surfaceTiltDegrees = replay.surfaceTiltDegrees;
+						Subarrays[nn]->poa.surfaceAzimuthDegrees = replay.surfaceAzimuthDegrees;
+						Subarrays[nn]->poa.nonlinearDCShadingDerate = replay.nonlinearDCShadingDerate;
+						Subarrays[nn]->poa.usePOAFromWF = replay.usePOAFromWF;
+						dcShadeFactor[nn] = replay.dcShadeFactor;
+						continue;
+					}
+
 					irrad irr(Irradiance, Subarrays[nn]);
 					
 					int code = irr.calc();
@@ -1652,6 +1693,30 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 					Subarrays[nn]->poa.sunUp = sunup;
 					Subarrays[nn]->poa.surfaceTiltDegrees = stilt;
 					Subarrays[nn]->poa.surfaceAzimuthDegrees = sazi;
+					dcShadeFactor[nn] = Subarrays[nn]->shadeCalculator.dc_shade_factor();
+
+					if (replayIrradiance && iyear == 0)
+					{
+						poa_replay_t &replay = poaReplay[irec * num_subarrays + nn];
+						replay.poaBeamFront = Subarrays[nn]->poa.poaBeamFront;
+						replay.poaDiffuseFront = Subarrays[nn]->poa.poaDiffuseFront;
+						replay.poaGroundFront = Subarrays[nn]->poa.poaGroundFront;
+						replay.poaRear = Subarrays[nn]->poa.poaRear;
+						replay.poaTotal = Subarrays[nn]->poa.poaTotal;
+						replay.angleOfIncidenceDegrees = aoi;
+						replay.sunUp = (sunup != 0);
+						replay.surfaceTiltDegrees = stilt;
+						replay.surfaceAzimuthDegrees = sazi;
+						replay.nonlinearDCShadingDerate = Subarrays[nn]->poa.nonlinearDCShadingDerate;
+						replay.usePOAFromWF = Subarrays[nn]->poa.usePOAFromWF;
+						replay.dcShadeFactor = dcShadeFactor[nn];
+					}
+				}
+
+				if (replayIrradiance && iyear == 0)
+				{
+					replaySolarZenith[irec] = solzen;
+					replaySunUp[irec] = sunup;
 				}
 
 				std::vector<double> mpptVoltageClipping; //a vector to store power that is clipped due to the inverter MPPT low & high voltage limits for each subarray
@@ -1856,7 +1921,7 @@ void cm_pvsamv1::exec( ) throw (compute_module::general_error)
 
 					// Sara 1/25/16 - shading database derate applied to dc only
 					// shading loss applied to beam if not from shading database
-					Subarrays[nn]->Module->dcPowerW *= Subarrays[nn]->shadeCalculator.dc_shade_factor();
+					Subarrays[nn]->Module->dcPowerW *= dcShadeFactor[nn];
 
 					// Calculate and apply snow coverage losses if activated
 					if (PVSystem->enableSnowModel)
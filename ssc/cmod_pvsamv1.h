@@ -82,6 +82,28 @@
 // comment following define if do not want shading database validation outputs
 //#define SHADE_DB_OUTPUTS
 
+/**
+* Plane-of-array irradiance, geometry, and shading factors for one subarray at one timestep.
+* Recorded during the first year of a lifetime simulation and replayed for the later years,
+* which then only re-run the module, inverter, and battery models.
+*/
+struct poa_replay_t
+{
+	double poaBeamFront;
+	double poaDiffuseFront;
+	double poaGroundFront;
+	double poaRear;
+	double poaTotal;
+	double angleOfIncidenceDegrees;
+	double surfaceTiltDegrees;
+	double surfaceAzimuthDegrees;
+	double nonlinearDCShadingDerate;
+	double dcShadeFactor;
+	bool sunUp;
+	bool usePOAFromWF;
+};
+
+
 /**
 * Detailed photovoltaic model in SAM, version 1
 * Contains calculations to process a weather file, parse the irradiance, and evaluate PV subarray power production with AC or DC connected batteries
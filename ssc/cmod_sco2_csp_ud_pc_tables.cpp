@@ -70,6 +70,9 @@ static var_info _cm_vtab_sco2_csp_ud_pc_tables[] = {
 	{ SSC_INOUT,  SSC_NUMBER,  "m_dot_htf_ND_low",	   "Lower level of normalized HTF mass flow rate",			  "",		   "",    "",      "",     "",       "" },
 	{ SSC_INOUT,  SSC_NUMBER,  "m_dot_htf_ND_high",	   "Upper level of normalized HTF mass flow rate",			  "",		   "",    "",      "",     "",       "" },
 	{ SSC_INOUT,  SSC_NUMBER,  "n_m_dot_htf_ND",	   "Number of normalized HTF mass flow rate parametric runs", "",		   "",    "",      "",     "",       "" },
+	{ SSC_INPUT,  SSC_NUMBER,  "udpc_n_threads",       "Number of threads solving off-design points, each with its own copy of the cycle, 0 = all cores", "", "", "", "?=1", "INTEGER,MIN=0", "" },
+	{ SSC_INPUT,  SSC_NUMBER,  "is_udpc_warm_start",   "1 = start the low and high levels of each table row from the solved reference level, 0 = no", "", "", "", "?=0", "", "" },
+	{ SSC_INPUT,  SSC_STRING,  "udpc_checkpoint_file", "File saving solved off-design points; a rerun with the same levels resumes from it", "", "", "", "?", "", "" },
 
 	// Power Cycle Tables
 	{ SSC_OUTPUT, SSC_MATRIX,  "T_htf_ind",            "Parametric of HTF temperature w/ ND HTF mass flow rate levels",     "",       "",    "",      "?=[[0,1,2,3,4,5,6,7,8,9,10,11,12][0,1,2,3,4,5,6,7,8,9,10,11,12]]",     "",       "" },
@@ -184,6 +187,14 @@ public:
 
 		util::matrix_t<double> T_htf_parametrics, T_amb_parametrics, m_dot_htf_ND_parametrics;
 
+		int udpc_n_threads = as_integer("udpc_n_threads");
+		bool is_udpc_warm_start = as_boolean("is_udpc_warm_start");
+		std::string udpc_checkpoint_file = "";
+		if (is_assigned("udpc_checkpoint_file"))
+		{
+			udpc_checkpoint_file = as_string("udpc_checkpoint_file");
+		}
+
 		// For try/catch below
 		int out_type = -1;
 		std::string out_msg = "";
@@ -193,7 +204,8 @@ public:
 			c_sco2_cycle.generate_ud_pc_tables(T_htf_hot_low, T_htf_hot_high, n_T_htf_hot_in,
 							T_amb_low, T_amb_high, n_T_amb_in,
 							m_dot_htf_ND_low, m_dot_htf_ND_high, n_m_dot_htf_ND_in,
-							T_htf_parametrics, T_amb_parametrics, m_dot_htf_ND_parametrics);
+							T_htf_parametrics, T_amb_parametrics, m_dot_htf_ND_parametrics,
+							udpc_n_threads, is_udpc_warm_start, udpc_checkpoint_file);
 		}
 		catch( C_csp_exception &csp_exception )
 		{
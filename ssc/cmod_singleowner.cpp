@@ -852,6 +852,19 @@ static var_info _cm_vtab_singleowner[] = {
 	{ SSC_OUTPUT, SSC_NUMBER, "min_dscr", "Minimum DSCR", "", "", "DSCR", "", "" },
 	{ SSC_OUTPUT, SSC_ARRAY, "cf_pretax_dscr", "DSCR (pre-tax)", "", "", "DSCR", "*", "LENGTH_EQUAL=cf_length", "" },
 
+/* scenario sweeps */
+	{ SSC_INPUT,        SSC_MATRIX,     "scenario_inputs",                        "Scenario input values",                     "",                    "One row per scenario, one column per entry in scenario_input_names", "Scenarios", "?", "", "" },
+	{ SSC_INPUT,        SSC_STRING,     "scenario_input_names",                   "Scalar inputs varied by scenario",          "",                    "Comma separated list of numeric input names", "Scenarios", "?", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_ppa",                           "Scenario PPA price (Year 1)",               "cents/kWh",           "", "Scenarios", "", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_lppa_nom",                      "Scenario levelized PPA price (nominal)",    "cents/kWh",           "", "Scenarios", "", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_lcoe_nom",                      "Scenario levelized cost (nominal)",         "cents/kWh",           "", "Scenarios", "", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_lcoe_real",                     "Scenario levelized cost (real)",            "cents/kWh",           "", "Scenarios", "", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_project_return_aftertax_irr",   "Scenario internal rate of return (after-tax)", "%",                "", "Scenarios", "", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_project_return_aftertax_npv",   "Scenario net present value (after-tax)",    "$",                   "", "Scenarios", "", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_flip_actual_irr",               "Scenario IRR in target year",               "%",                   "", "Scenarios", "", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_size_of_debt",                  "Scenario size of debt",                     "$",                   "", "Scenarios", "", "", "" },
+	{ SSC_OUTPUT,       SSC_ARRAY,      "scenario_min_dscr",                      "Scenario minimum DSCR",                     "",                    "", "Scenarios", "", "", "" },
+
 
 var_info_invalid };
 
@@ -1048,6 +1061,11 @@ private:
 	dispatch_calculations m_disp_calcs;
 	hourly_energy_calculation hourly_energy_calcs;
 
+	// annual net energy and dispatch binning carried between scenario_inputs rows
+	bool m_reuse_energy;
+	bool m_energy_ready;
+	std::vector<double> m_energy_net;
+
 
 public:
 	cm_singleowner()
@@ -1059,9 +1077,123 @@ public:
 //		add_var_info(vtab_advanced_financing_cost);
 		add_var_info( _cm_vtab_singleowner );
 		add_var_info(vtab_battery_replacement_cost);
+		m_reuse_energy = false;
+		m_energy_ready = false;
 	}
 
 	void exec( ) throw( general_error )
+	{
+		m_reuse_energy = false;
+		m_energy_ready = false;
+
+		if (is_assigned("scenario_inputs"))
+			exec_scenarios();
+		else
+			exec_case();
+	}
+
+	/* evaluates every row of scenario_inputs against the same generation profile.
+	   the hourly energy aggregation and TOD binning are done for the first row only
+	   unless a scenario changes one of the inputs they depend on.  the regular
+	   outputs are left at the values of the last scenario. */
+	void exec_scenarios() throw( general_error )
+	{
+		size_t nrows = 0, ncols = 0;
+		ssc_number_t *scen = as_matrix("scenario_inputs", &nrows, &ncols);
+
+		std::vector<std::string> names;
+		if (is_assigned("scenario_input_names"))
+			names = util::split(as_string("scenario_input_names"), ",");
+		for (size_t j = 0; j < names.size(); j++)
+		{
+			size_t first = names[j].find_first_not_of(" \t");
+			size_t last = names[j].find_last_not_of(" \t");
+			names[j] = (first == std::string::npos) ? std::string() : names[j].substr(first, last - first + 1);
+		}
+		if (names.size() != ncols)
+			throw exec_error("singleowner", util::format("scenario_inputs has %d columns but scenario_input_names lists %d inputs.", (int)ncols, (int)names.size()));
+
+		// inputs read by hourly_energy_calculation and dispatch_calculations::init
+		static const char *energy_inputs[] = { "analysis_period", "system_use_lifetime_output", "ppa_multiplier_model",
+			"en_batt", "batt_meter_position", "dispatch_factor1", "dispatch_factor2", "dispatch_factor3", "dispatch_factor4",
+			"dispatch_factor5", "dispatch_factor6", "dispatch_factor7", "dispatch_factor8", "dispatch_factor9", 0 };
+
+		m_reuse_energy = true;
+		std::vector<var_data> saved(ncols);
+		std::vector<bool> was_assigned(ncols, false);
+		for (size_t j = 0; j < ncols; j++)
+		{
+			const var_info &vi = info(names[j]);
+			if (vi.var_type == SSC_OUTPUT || vi.data_type != SSC_NUMBER)
+				throw exec_error("singleowner", "scenario input '" + names[j] + "' is not a numeric input.");
+			for (int k = 0; energy_inputs[k] != 0; k++)
+				if (names[j] == energy_inputs[k]) m_reuse_energy = false;
+			if (var_data *v = lookup(names[j]))
+			{
+				saved[j].copy(*v);
+				was_assigned[j] = true;
+			}
+		}
+
+		static const char *metrics[][2] = {
+			{ "scenario_ppa", "ppa" },
+			{ "scenario_lppa_nom", "lppa_nom" },
+			{ "scenario_lcoe_nom", "lcoe_nom" },
+			{ "scenario_lcoe_real", "lcoe_real" },
+			{ "scenario_project_return_aftertax_irr", "project_return_aftertax_irr" },
+			{ "scenario_project_return_aftertax_npv", "project_return_aftertax_npv" },
+			{ "scenario_flip_actual_irr", "flip_actual_irr" },
+			{ "scenario_size_of_debt", "size_of_debt" },
+			{ "scenario_min_dscr", "min_dscr" } };
+		const size_t nmetrics = sizeof(metrics) / sizeof(metrics[0]);
+		util::matrix_t<ssc_number_t> results(nmetrics, nrows, std::numeric_limits<ssc_number_t>::quiet_NaN());
+
+		try
+		{
+			for (size_t r = 0; r < nrows; r++)
+			{
+				// overrides are checked the same way compute() checks the inputs before exec
+				for (size_t j = 0; j < ncols; j++)
+				{
+					assign(names[j], var_data(scen[r*ncols + j]));
+					std::string fail_text;
+					if (!check_constraints(names[j], fail_text))
+						throw exec_error("singleowner", util::format("scenario %d: ", (int)(r + 1)) + fail_text);
+				}
+
+				exec_case();
+
+				for (size_t k = 0; k < nmetrics; k++)
+				{
+					var_data *v = lookup(metrics[k][1]);
+					if (v && v->type == SSC_NUMBER) results.at(k, r) = v->num;
+				}
+			}
+		}
+		catch (...)
+		{
+			restore_inputs(names, saved, was_assigned);
+			throw;
+		}
+		restore_inputs(names, saved, was_assigned);
+
+		for (size_t k = 0; k < nmetrics; k++)
+		{
+			ssc_number_t *p = allocate(metrics[k][0], nrows);
+			for (size_t r = 0; r < nrows; r++) p[r] = results.at(k, r);
+		}
+	}
+
+	void restore_inputs(const std::vector<std::string> &names, const std::vector<var_data> &saved, const std::vector<bool> &was_assigned)
+	{
+		for (size_t j = 0; j < names.size(); j++)
+		{
+			if (was_assigned[j]) assign(names[j], saved[j]);
+			else unassign(names[j]);
+		}
+	}
+
+	void exec_case( ) throw( general_error )
 	{
 		int i = 0;
 
@@ -1229,39 +1361,51 @@ public:
 
 
 
-		hourly_energy_calcs.calculate(this);
-
-
-		// dispatch
-		if (as_integer("system_use_lifetime_output") == 1)
+		if (m_energy_ready)
 		{
-			// hourly_enet includes all curtailment, availability
-			for (size_t y = 1; y <= (size_t)nyears; y++)
-			{
-				for (size_t h = 0; h<8760; h++)
-				{
-					cf.at(CF_energy_net, y) += hourly_energy_calcs.hourly_energy()[(y - 1) * 8760 + h] * cf.at(CF_degradation, y);
-				}
-			}
+			// same generation, degradation and dispatch inputs as the previous scenario
+			for (i = 0; i <= nyears; i++)
+				cf.at(CF_energy_net, i) = m_energy_net[i];
 		}
 		else
 		{
-			for (i = 0; i<8760; i++) first_year_energy += hourly_energy_calcs.hourly_energy()[i]; // sum up hourly kWh to get total annual kWh first year production includes first year curtailment, availability 
-			cf.at(CF_energy_net, 1) = first_year_energy;
-			for (i = 1; i <= nyears; i++)
-				cf.at(CF_energy_net, i) = first_year_energy * cf.at(CF_degradation, i);
-		}
+			hourly_energy_calcs.calculate(this);
 
-		first_year_energy = cf.at(CF_energy_net, 1);
 
+			// dispatch
+			if (as_integer("system_use_lifetime_output") == 1)
+			{
+				// hourly_enet includes all curtailment, availability
+				for (size_t y = 1; y <= (size_t)nyears; y++)
+				{
+					for (size_t h = 0; h<8760; h++)
+					{
+						cf.at(CF_energy_net, y) += hourly_energy_calcs.hourly_energy()[(y - 1) * 8760 + h] * cf.at(CF_degradation, y);
+					}
+				}
+			}
+			else
+			{
+				for (i = 0; i<8760; i++) first_year_energy += hourly_energy_calcs.hourly_energy()[i]; // sum up hourly kWh to get total annual kWh first year production includes first year curtailment, availability 
+				cf.at(CF_energy_net, 1) = first_year_energy;
+				for (i = 1; i <= nyears; i++)
+					cf.at(CF_energy_net, i) = first_year_energy * cf.at(CF_degradation, i);
+			}
 
+			std::vector<double> degrade_cf;
+			for (i = 0; i <= nyears; i++)
+			{
+				degrade_cf.push_back(cf.at(CF_degradation, i));
+			}
+			m_disp_calcs.init(this, degrade_cf, hourly_energy_calcs.hourly_energy());
 
-		std::vector<double> degrade_cf;
-		for (i = 0; i <= nyears; i++)
-		{
-			degrade_cf.push_back(cf.at(CF_degradation, i));
+			m_energy_net.resize(nyears + 1);
+			for (i = 0; i <= nyears; i++)
+				m_energy_net[i] = cf.at(CF_energy_net, i);
+			m_energy_ready = m_reuse_energy;
 		}
-		m_disp_calcs.init(this, degrade_cf, hourly_energy_calcs.hourly_energy());
+
+		first_year_energy = cf.at(CF_energy_net, 1);
 		// end of energy and dispatch initialization
 
 
@@ -1898,6 +2042,7 @@ public:
 		bool irr_greater_than_target = false;
 		double w0=1.0;
 		double w1=1.0;
+		int ppa_last_side=0; // endpoint replaced on the previous interval update: -1=x0, 1=x1
 		double x0=ppa_min;
 		double x1=ppa_max;
 		double ppa_coarse_interval=10; // 10 cents/kWh
@@ -2515,9 +2660,6 @@ public:
 			cf.at(CF_project_return_pretax,i) = cf.at(CF_pretax_cashflow,i);
 			if (i==0) cf.at(CF_project_return_pretax,i) -= (issuance_of_equity); 
 
-			cf.at(CF_project_return_pretax_irr,i) = irr(CF_project_return_pretax,i)*100.0;
-			cf.at(CF_project_return_pretax_npv,i) = npv(CF_project_return_pretax,i,nom_discount_rate) +  cf.at(CF_project_return_pretax,0) ;
-
 			cf.at(CF_project_return_aftertax_cash,i) = cf.at(CF_project_return_pretax,i);
 		}
 
@@ -2658,12 +2800,18 @@ public:
 			// set endpoint of weighted interval x0<x1
 						x1 = ppa;
 						w1 = irr_weighting_factor;
+			// Illinois modification - halve the retained endpoint weight when the same side moves twice in a row
+						if (ppa_last_side == 1) w0 *= 0.5;
+						ppa_last_side = 1;
 					}
 					else // too small
 					{
 			// set endpoint of weighted interval x0<x1
 						x0 = ppa;
 						w0 = irr_weighting_factor;
+			// Illinois modification - halve the retained endpoint weight when the same side moves twice in a row
+						if (ppa_last_side == -1) w1 *= 0.5;
+						ppa_last_side = -1;
 					}
 
 				}
@@ -2727,6 +2875,13 @@ public:
 		// 12/14/12 - address issue from Eric Lantz - ppa solution when target mode and ppa < 0
 	if (ppa < 0) ppa = ppa_old;	
 
+	// cumulative pre-tax project returns are reporting only and do not feed the ppa solution, so evaluate them once on the final cash flows
+	for (i=0; i<=nyears; i++)
+	{
+		cf.at(CF_project_return_pretax_irr,i) = irr(CF_project_return_pretax,i)*100.0;
+		cf.at(CF_project_return_pretax_npv,i) = npv(CF_project_return_pretax,i,nom_discount_rate) +  cf.at(CF_project_return_pretax,0) ;
+	}
+
 /***************** end iterative solution *********************************************************************/
 
 //	log(util::format("after loop  - size of debt =%lg .", size_of_debt), SSC_WARNING);
@@ -3889,178 +4044,15 @@ public:
 	}
 
 	double npv( int cf_line, int nyears, double rate ) throw ( general_error )
-	{		
-		//if (rate == -1.0) throw general_error("cannot calculate NPV with discount rate equal to -1.0");
-		double rr = 1.0;
-		if (rate != -1.0) rr = 1.0/(1.0+rate);
-		double result = 0;
-		for (int i=nyears;i>0;i--)
-			result = rr * result + cf.at(cf_line,i);
-
-		return result*rr;
-	}
-
-/* ported from http://code.google.com/p/irr-newtonraphson-calculator/ */
-	bool is_valid_iter_bound(double estimated_return_rate)
-	{
-		return estimated_return_rate != -1 && (estimated_return_rate < std::numeric_limits<int>::max()) && (estimated_return_rate > std::numeric_limits<int>::min());
-	}
-
-	double irr_poly_sum(double estimated_return_rate, int cf_line, int count)
-	{
-		double sum_of_polynomial = 0;
-		if (is_valid_iter_bound(estimated_return_rate))
-		{
-			for (int j = 0; j <= count ; j++)
-			{
-				double val = (pow((1 + estimated_return_rate), j));
-				if (val != 0.0)
-					sum_of_polynomial += cf.at(cf_line,j)/val;
-				else
-					break;
-			}
-		}
-		return sum_of_polynomial;
-	}
-
-	double irr_derivative_sum(double estimated_return_rate,int cf_line, int count)
-	{
-		double sum_of_derivative = 0;
-		if (is_valid_iter_bound(estimated_return_rate))
-			for (int i = 1; i <= count ; i++)
-			{
-				sum_of_derivative += cf.at(cf_line,i)*(i)/pow((1 + estimated_return_rate), i+1);
-			}
-		return sum_of_derivative*-1;
-	}
-
-	double irr_scale_factor( int cf_unscaled, int count)
-	{
-		// scale to max value for better irr convergence
-		if (count<1) return 1.0;
-		int i=0;
-		double max=fabs(cf.at(cf_unscaled,0));
-		for (i=0;i<=count;i++) 
-			if (fabs(cf.at(cf_unscaled,i))> max) max =fabs(cf.at(cf_unscaled,i));
-		return (max>0 ? max:1);
-	}
-
-	bool is_valid_irr( int cf_line, int count, double residual, double tolerance, int number_of_iterations, int max_iterations, double calculated_irr, double scale_factor )
 	{
-		double npv_of_irr = npv(cf_line,count,calculated_irr)+cf.at(cf_line,0);
-		double npv_of_irr_plus_delta = npv(cf_line,count,calculated_irr+0.001)+cf.at(cf_line,0);
-		bool is_valid = ( (number_of_iterations<max_iterations) && (fabs(residual)<tolerance) && (npv_of_irr>npv_of_irr_plus_delta) && (fabs(npv_of_irr/scale_factor)<tolerance) );
-				//if (!is_valid)
-				//{
-				//std::stringstream outm;
-				//outm <<  "cf_line=" << cf_line << "count=" << count << "residual=" << residual << "number_of_iterations=" << number_of_iterations << "calculated_irr=" << calculated_irr
-				//	<< "npv of irr=" << npv_of_irr << "npv of irr plus delta=" << npv_of_irr_plus_delta;
-				//log( outm.str() );
-				//}
-		return is_valid;
+		return cf_npv( cf, cf_line, nyears, rate );
 	}
 
 	double irr( int cf_line, int count, double initial_guess=-2, double tolerance=1e-6, int max_iterations=100 )
 	{
-		int number_of_iterations=0;
-//		double calculated_irr = 0;
-		double calculated_irr = std::numeric_limits<double>::quiet_NaN();
-//		double calculated_irr = -999;
-
-
-		if (count < 1) 
-			return calculated_irr;
-
-		// only possible for first value negative
-		if ( (cf.at(cf_line,0) <= 0))
-		{
-			// initial guess from http://zainco.blogspot.com/2008/08/internal-rate-of-return-using-newton.html
-			if ((initial_guess < -1) && (count > 1))// second order
-			{
-				if (cf.at(cf_line,0) !=0) 
-				{
-					double b = 2.0+ cf.at(cf_line,1)/cf.at(cf_line,0);
-					double c = 1.0+cf.at(cf_line,1)/cf.at(cf_line,0)+cf.at(cf_line,2)/cf.at(cf_line,0);
-					initial_guess = -0.5*b - 0.5*sqrt(b*b-4.0*c);
-					if ((initial_guess <= 0) || (initial_guess >= 1)) initial_guess = -0.5*b + 0.5*sqrt(b*b-4.0*c);
-				}
-			}
-			else if (initial_guess < 0) // first order
-			{
-				if (cf.at(cf_line,0) !=0) initial_guess = -(1.0 + cf.at(cf_line,1)/cf.at(cf_line,0));
-			}
-
-			double scale_factor = irr_scale_factor(cf_line,count);
-			double residual=DBL_MAX;
-
-			calculated_irr = irr_calc(cf_line,count,initial_guess,tolerance,max_iterations,scale_factor,number_of_iterations,residual);
-
-			if (!is_valid_irr(cf_line,count,residual,tolerance,number_of_iterations,max_iterations,calculated_irr,scale_factor)) // try 0.1 as initial guess
-			{
-				initial_guess=0.1;
-				number_of_iterations=0;
-				residual=0;
-				calculated_irr = irr_calc(cf_line,count,initial_guess,tolerance,max_iterations,scale_factor,number_of_iterations,residual);
-			}
-
-			if (!is_valid_irr(cf_line,count,residual,tolerance,number_of_iterations,max_iterations,calculated_irr,scale_factor)) // try -0.1 as initial guess
-			{
-				initial_guess=-0.1;
-				number_of_iterations=0;
-				residual=0;
-				calculated_irr = irr_calc(cf_line,count,initial_guess,tolerance,max_iterations,scale_factor,number_of_iterations,residual);
-			}
-			if (!is_valid_irr(cf_line,count,residual,tolerance,number_of_iterations,max_iterations,calculated_irr,scale_factor)) // try 0 as initial guess
-			{
-				initial_guess=0;
-				number_of_iterations=0;
-				residual=0;
-				calculated_irr = irr_calc(cf_line,count,initial_guess,tolerance,max_iterations,scale_factor,number_of_iterations,residual);
-			}
-
-			if (!is_valid_irr(cf_line,count,residual,tolerance,number_of_iterations,max_iterations,calculated_irr,scale_factor)) // try 0.1 as initial guess
-			{
-//				calculated_irr = 0.0; // did not converge
-				calculated_irr = std::numeric_limits<double>::quiet_NaN(); // did not converge
-//				double calculated_irr = -999;
-			}
-
-		}
-		return calculated_irr;
-	}
-
-
-	double irr_calc( int cf_line, int count, double initial_guess, double tolerance, int max_iterations, double scale_factor, int &number_of_iterations, double &residual )
-	{
-//		double calculated_irr = 0;
-		double calculated_irr = std::numeric_limits<double>::quiet_NaN();
-//		double calculated_irr = -999;
-		double deriv_sum = irr_derivative_sum(initial_guess, cf_line, count);
-		if (deriv_sum != 0.0)
-			calculated_irr = initial_guess - irr_poly_sum(initial_guess,cf_line,count)/deriv_sum;
-		else
-			return initial_guess;
-
-		number_of_iterations++;
-
-
-		residual = irr_poly_sum(calculated_irr,cf_line,count) / scale_factor;
-
-		while (!(fabs(residual) <= tolerance) && (number_of_iterations < max_iterations))
-		{
-			deriv_sum = irr_derivative_sum(initial_guess,cf_line,count);
-			if (deriv_sum != 0.0)
-				calculated_irr = calculated_irr - irr_poly_sum(calculated_irr,cf_line,count)/deriv_sum;
-			else
-				break;
-
-			number_of_iterations++;
-			residual = irr_poly_sum(calculated_irr,cf_line,count) / scale_factor;
-		}
-		return calculated_irr;
+		return cf_irr( cf, cf_line, count, initial_guess, tolerance, max_iterations );
 	}
 
-
 	double min(double a, double b)
 	{ // handle NaN
 		if ((a != a) || (b != b))
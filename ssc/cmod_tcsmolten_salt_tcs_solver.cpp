@@ -52,6 +52,7 @@ static var_info _cm_vtab_tcsmolten_salt[] = {
     { SSC_INPUT,        SSC_NUMBER,      "v_wind_max",           "Max. wind velocity",                                                "m/s",          "",            "heliostat",      "*",                       "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "interp_nug",           "Interpolation nugget",                                              "-",            "",            "heliostat",      "?=0",                     "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "interp_beta",          "Interpolation beta coef.",                                          "-",            "",            "heliostat",      "?=1.99",                  "",                     "" },
+    { SSC_INPUT,        SSC_NUMBER,      "is_eta_map_grid",      "1 = Precompute field efficiency interpolation on a grid, 0 = Interpolate every call", "-", "", "heliostat", "?=1",                     "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "n_flux_x",             "Flux map X resolution",                                             "-",            "",            "heliostat",      "?=12",                    "",                     "" },
     { SSC_INPUT,        SSC_NUMBER,      "n_flux_y",             "Flux map Y resolution",                                             "-",            "",            "heliostat",      "?=1",                     "",                     "" },
     { SSC_INPUT,        SSC_MATRIX,      "helio_positions",      "Heliostat position table",                                          "m",            "",            "heliostat",      "run_type=1",              "",                     "" },
@@ -778,6 +779,7 @@ public:
 		set_unit_value_ssc_double(type_hel_field, "p_track");//, 0.055);
 		set_unit_value_ssc_double(type_hel_field, "hel_stow_deploy");//, 8);
 		set_unit_value_ssc_double(type_hel_field, "v_wind_max");//, 25.);
+		set_unit_value_ssc_double(type_hel_field, "is_eta_map_grid");
 		set_unit_value_ssc_double(type_hel_field, "n_flux_x");//, 10);
 		set_unit_value_ssc_double(type_hel_field, "n_flux_y");//, 1);
 		set_unit_value_ssc_double(type_hel_field, "c_atm_0");
@@ -350,6 +350,14 @@ static var_info vtab_utility_rate5[] = {
 	{ SSC_OUTPUT, SSC_MATRIX, "monthly_tou_demand_charge_w_sys", "Demand peak charge with system", "$", "", "Charges by Month", "*", "", "ROW_LABEL=MONTHS,COL_LABEL=UR_MONTH_TOU_DEMAND,FORMAT_SPEC=CURRENCY,GROUP=UR_DMP" },
 	{ SSC_OUTPUT, SSC_MATRIX, "monthly_tou_demand_charge_wo_sys", "Demand peak charge without system", "$", "", "Charges by Month", "*", "", "ROW_LABEL=MONTHS,COL_LABEL=UR_MONTH_TOU_DEMAND,FORMAT_SPEC=CURRENCY,GROUP=UR_DMP" },
 
+	// first year bills for many customers on the same tariff - split large sets across ssc_batch cases to use several cores
+	{ SSC_INPUT, SSC_MATRIX, "batch_load", "Batch electricity load profiles", "kW", "One profile per row with one year of gen records per row", "Batch", "?", "", "" },
+	{ SSC_INPUT, SSC_MATRIX, "batch_gen", "Batch system power generated", "kW", "Same size as batch_load, no generation if not assigned", "Batch", "?", "", "" },
+	{ SSC_OUTPUT, SSC_MATRIX, "batch_monthly_utility_bill_wo_sys", "Batch first year electricity bill without system", "$/mo", "One row per batch_load profile", "Batch", "", "", "" },
+	{ SSC_OUTPUT, SSC_MATRIX, "batch_monthly_utility_bill_w_sys", "Batch first year electricity bill with system", "$/mo", "One row per batch_load profile", "Batch", "", "", "" },
+	{ SSC_OUTPUT, SSC_ARRAY, "batch_utility_bill_wo_sys", "Batch first year annual electricity bill without system", "$", "", "Batch", "", "", "" },
+	{ SSC_OUTPUT, SSC_ARRAY, "batch_utility_bill_w_sys", "Batch first year annual electricity bill with system", "$", "", "Batch", "", "", "" },
+
 
 	var_info_invalid };
 
@@ -408,6 +416,10 @@ private:
 	// schedule outputs
 	std::vector<int> m_ec_tou_sched;
 	std::vector<int> m_dc_tou_sched;
+	// schedules compiled to the row of each timestep's period in its month's
+	// ec_periods and dc_periods, -1 where the month does not define the period
+	std::vector<int> m_ec_tou_row;
+	std::vector<int> m_dc_tou_row;
 	std::vector<ur_month> m_month;
 	std::vector<int> m_ec_periods; // period number
 	// time step sell rate
@@ -652,6 +664,10 @@ public:
 		// tiers and periods determined by input matrices 
 
 		setup();
+		// tariff state before any bill has been calculated, the starting point for each batch profile
+		std::vector<ur_month> compiled_months;
+		if (is_assigned("batch_load"))
+			compiled_months = m_month;
 
 
 		// note that ec_charge and not ec_energy_use have the correct dimensions after setup
@@ -760,6 +776,7 @@ public:
 		int metering_option = as_integer("ur_metering_option");
 		bool two_meter = (metering_option == 4 );
 		bool timestep_reconciliation = (metering_option == 2 || metering_option == 3 || metering_option == 4);
+		bool lifetime_output = (as_integer("system_use_lifetime_output") == 1);
 
 
 		idx = 0;
@@ -794,7 +811,7 @@ public:
 
 
 				// update e_sys per year if lifetime output
-				if ((as_integer("system_use_lifetime_output") == 1) && ( idx < nrec_gen ))
+				if (lifetime_output && ( idx < nrec_gen ))
 				{
 //					e_sys[j] = p_sys[j] = 0.0;
 //					ts_power = (idx < nrec_gen) ? pgen[idx] : 0;
@@ -1325,6 +1342,83 @@ public:
 		assign("elec_cost_with_system_year1", annual_elec_cost_w_sys[1]);
 		assign("elec_cost_without_system_year1", annual_elec_cost_wo_sys[1]);
 		assign("savings_year1", annual_elec_cost_wo_sys[1] - annual_elec_cost_w_sys[1]);
+
+		if (is_assigned("batch_load"))
+			ur_batch(compiled_months, ts_hour_gen, load_scale[0], sys_scale[0], rate_scale[0], timestep_reconciliation, two_meter);
+	}
+
+	/* first year bills for each row of batch_load (and batch_gen) using the tariff already
+	   compiled by setup(). every profile starts from the same compiled month state, so its
+	   bills match a separate utilityrate5 run with that load and generation. */
+	void ur_batch(const std::vector<ur_month> &compiled_months, ssc_number_t ts_hour, ssc_number_t load_scale,
+		ssc_number_t sys_scale, ssc_number_t rate_esc, bool timestep_reconciliation, bool two_meter)
+	{
+		size_t nprofiles, ncols, gen_rows = 0, gen_cols = 0;
+		ssc_number_t *batch_load = as_matrix("batch_load", &nprofiles, &ncols);
+		if (ncols != m_num_rec_yearly)
+			throw exec_error("utilityrate5", util::format("batch_load has %d columns, must have one year of gen records (%d)", (int)ncols, (int)m_num_rec_yearly));
+		ssc_number_t *batch_gen = 0;
+		if (is_assigned("batch_gen"))
+		{
+			batch_gen = as_matrix("batch_gen", &gen_rows, &gen_cols);
+			if (gen_rows != nprofiles || gen_cols != ncols)
+				throw exec_error("utilityrate5", util::format("batch_gen is %dx%d, must be the same size as batch_load (%dx%d)", (int)gen_rows, (int)gen_cols, (int)nprofiles, (int)ncols));
+		}
+
+		ssc_number_t *bill_wo_sys = allocate("batch_monthly_utility_bill_wo_sys", nprofiles, 12);
+		ssc_number_t *bill_w_sys = allocate("batch_monthly_utility_bill_w_sys", nprofiles, 12);
+		ssc_number_t *annual_wo_sys = allocate("batch_utility_bill_wo_sys", nprofiles);
+		ssc_number_t *annual_w_sys = allocate("batch_utility_bill_w_sys", nprofiles);
+
+		std::vector<ssc_number_t> e_load(ncols), p_load(ncols), e_sys(ncols), p_sys(ncols), e_grid(ncols), p_grid(ncols);
+		std::vector<ssc_number_t> revenue(ncols), payment(ncols), income(ncols), demand_charge(ncols), energy_charge(ncols), dc_hourly_peak(ncols);
+		ssc_number_t monthly[13][12];
+
+		for (size_t r = 0; r < nprofiles; r++)
+		{
+			for (size_t j = 0; j < ncols; j++)
+			{
+				// note: load is assumed to have negative sign
+				p_load[j] = -batch_load[r*ncols + j] * load_scale;
+				e_load[j] = p_load[j] * ts_hour;
+				p_sys[j] = (batch_gen ? batch_gen[r*ncols + j] : 0) * sys_scale;
+				e_sys[j] = p_sys[j] * ts_hour;
+				e_grid[j] = e_sys[j] + e_load[j];
+				p_grid[j] = p_sys[j] + p_load[j];
+			}
+
+			// the with system bill sees the month state left by the bill without system, as in exec
+			m_month = compiled_months;
+			for (int pass = 0; pass < 2; pass++)
+			{
+				bool with_sys = (pass == 1);
+				bool gen_only = with_sys && two_meter;
+				ssc_number_t *e_in = !with_sys ? &e_load[0] : (two_meter ? &e_sys[0] : &e_grid[0]);
+				ssc_number_t *p_in = !with_sys ? &p_load[0] : (two_meter ? &p_sys[0] : &p_grid[0]);
+				ssc_number_t *bill = with_sys ? &bill_w_sys[r * 12] : &bill_wo_sys[r * 12];
+
+				if (timestep_reconciliation)
+					ur_calc_timestep(e_in, p_in, &revenue[0], &payment[0], &income[0], &demand_charge[0], &energy_charge[0],
+						monthly[0], monthly[1], monthly[2], monthly[3], monthly[4], monthly[5], monthly[6], monthly[7], monthly[8], monthly[9],
+						&dc_hourly_peak[0], monthly[10], monthly[11], bill, rate_esc, !gen_only, !gen_only, gen_only);
+				else
+					ur_calc(e_in, p_in, &revenue[0], &payment[0], &income[0], &demand_charge[0], &energy_charge[0],
+						monthly[0], monthly[1], monthly[2], monthly[3], monthly[4], monthly[5], monthly[6], monthly[7], monthly[8], monthly[9],
+						&dc_hourly_peak[0], monthly[10], monthly[11], bill, rate_esc, 1, !gen_only, !gen_only, gen_only);
+
+				// two meters - the load meter bill is part of the bill with system
+				if (gen_only)
+					for (int m = 0; m < 12; m++)
+						bill[m] += bill_wo_sys[r * 12 + m];
+			}
+
+			annual_wo_sys[r] = annual_w_sys[r] = 0;
+			for (int m = 0; m < 12; m++)
+			{
+				annual_wo_sys[r] += bill_wo_sys[r * 12 + m];
+				annual_w_sys[r] += bill_w_sys[r * 12 + m];
+			}
+		}
 	}
 
 	void monthly_outputs(ssc_number_t *e_load, ssc_number_t *e_sys, ssc_number_t *e_grid, ssc_number_t *salespurchases, ssc_number_t monthly_load[12], ssc_number_t monthly_generation[12], ssc_number_t monthly_elec_to_grid[12], ssc_number_t monthly_elec_needed_from_grid[12], ssc_number_t monthly_salespurchases[12])
@@ -1873,6 +1967,29 @@ public:
 
 		}
 
+		compile_tou_rows();
+	}
+
+	void compile_tou_rows()
+	{
+		m_ec_tou_row.assign(m_num_rec_yearly, -1);
+		m_dc_tou_row.assign(m_num_rec_yearly, -1);
+
+		size_t steps_per_hour = m_num_rec_yearly / 8760;
+		size_t c = 0;
+		for (size_t m = 0; m < m_month.size(); m++)
+		{
+			size_t nsteps = util::nday[m] * 24 * steps_per_hour;
+			for (size_t k = 0; k < nsteps && c < m_num_rec_yearly; k++, c++)
+			{
+				std::vector<int>::iterator ec = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), m_ec_tou_sched[c]);
+				if (ec != m_month[m].ec_periods.end())
+					m_ec_tou_row[c] = (int)(ec - m_month[m].ec_periods.begin());
+				std::vector<int>::iterator dc = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), m_dc_tou_sched[c]);
+				if (dc != m_month[m].dc_periods.end())
+					m_dc_tou_row[c] = (int)(dc - m_month[m].dc_periods.begin());
+			}
+		}
 	}
 
 
@@ -2110,15 +2227,13 @@ public:
 						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 						{
 							mon_e_net += e_in[c];
-							int toup = m_ec_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), toup);
-							if (per_num == m_month[m].ec_periods.end())
+							int row = m_ec_tou_row[c];
+							if (row < 0)
 							{
 								std::ostringstream ss;
-								ss << "Energy rate TOU Period " << toup << " not found for Month " << util::schedule_int_to_month(m) << ".";
+								ss << "Energy rate TOU Period " << m_ec_tou_sched[c] << " not found for Month " << util::schedule_int_to_month(m) << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].ec_periods.begin());
 							// place all in tier 0 initially and then update appropriately
 							// net energy per period per month
 							m_month[m].ec_energy_use(row, 0) += e_in[c];
@@ -2305,15 +2420,13 @@ public:
 					{
 						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 						{
-							int todp = m_dc_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
-							if (per_num == m_month[m].dc_periods.end())
+							int row = m_dc_tou_row[c];
+							if (row < 0)
 							{
 								std::ostringstream ss;
-								ss << "Demand rate Period " << todp << " not found for Month " << m << ".";
+								ss << "Demand rate Period " << m_dc_tou_sched[c] << " not found for Month " << m << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].dc_periods.begin());
 							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
 							{
 								m_month[m].dc_tou_peak[row] = -p_in[c];
@@ -2864,15 +2977,13 @@ public:
 					{
 						for (s = 0; s < (int)steps_per_hour && c < (int)m_num_rec_yearly; s++)
 						{
-							int todp = m_dc_tou_sched[c];
-							std::vector<int>::iterator per_num = std::find(m_month[m].dc_periods.begin(), m_month[m].dc_periods.end(), todp);
-							if (per_num == m_month[m].dc_periods.end())
+							int row = m_dc_tou_row[c];
+							if (row < 0)
 							{
 								std::ostringstream ss;
-								ss << "Demand charge Period " << todp << " not found for Month " << m << ".";
+								ss << "Demand charge Period " << m_dc_tou_sched[c] << " not found for Month " << m << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].dc_periods.begin());
 							if (p_in[c] < 0 && p_in[c] < -m_month[m].dc_tou_peak[row])
 							{
 								m_month[m].dc_tou_peak[row] = -p_in[c];
@@ -2905,16 +3016,14 @@ public:
 						if (ec_enabled)
 						{
 							period = m_ec_tou_sched[c];
-							// find corresponding monthly period
-							// check for valid period
-							std::vector<int>::iterator per_num = std::find(m_month[m].ec_periods.begin(), m_month[m].ec_periods.end(), period);
-							if (per_num == m_month[m].ec_periods.end())
+							// corresponding monthly period from the compiled schedule
+							int row = m_ec_tou_row[c];
+							if (row < 0)
 							{
 								std::ostringstream ss;
 								ss << "Energy rate Period " << period << " not found for Month " << m << ".";
 								throw exec_error("utilityrate5", ss.str());
 							}
-							int row = (int)(per_num - m_month[m].ec_periods.begin());
 
 							if (e_in[c] >= 0.0)
 							{ // calculate income or credit
@@ -78,6 +78,10 @@ static var_info _cm_vtab_windpower[] = {
 	{ SSC_INPUT, SSC_ARRAY,   "wind_farm_yCoordinates",				"Turbine Y coordinates",					"m",		"",		"WindPower",	"*",							"LENGTH_EQUAL=wind_farm_xCoordinates",				"" },
 	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_losses_percent",			"Percentage losses",						"%",		"",		"WindPower",	"*",							"",													"" },
 	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_model",				"Wake Model",								"0/1/2",	"",		"WindPower",	"*",							"INTEGER",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_cache",				"Interpolate wakes from direction and speed bins",	"0/1",	"",		"WindPower",	"?=0",							"INTEGER",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_cache_dir_step",		"Wake cache wind direction bin width",		"deg",		"",		"WindPower",	"?=1",							"POSITIVE",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_cache_speed_step",	"Wake cache wind speed bin width",			"m/s",		"",		"WindPower",	"?=0.5",						"POSITIVE",											"" },
+	{ SSC_INPUT, SSC_NUMBER,  "wind_farm_wake_threads",				"Eddy-viscosity wake model threads",		"",			"0=all cores",	"WindPower",	"?=1",							"INTEGER,MIN=0",									"" },
 	{ SSC_INPUT, SSC_NUMBER,  "en_low_temp_cutoff",					"Enable Low Temperature Cutoff",			"0/1",		"",		"WindPower",	"?=0",							"INTEGER",											"" },
 	{ SSC_INPUT, SSC_NUMBER,  "low_temp_cutoff",					"Low Temperature Cutoff",					"C",		"",		"WindPower",	"en_low_temp_cutoff=1",			"",													"" },
 	{ SSC_INPUT, SSC_NUMBER,  "en_icing_cutoff",					"Enable Icing Cutoff",						"0/1",		"",		"WindPower",	"?=0",							"INTEGER",											"" },
@@ -354,11 +358,17 @@ void cm_windpower::exec() throw(general_error)
 	else if (wakeModelChoice == 2)
 	{
 		wpc.turbulenceIntensity *= 100;	
-		wakeModel = std::make_shared<eddyViscosityWakeModel>(eddyViscosityWakeModel(wpc.nTurbines, &wt, as_double("wind_resource_turbulence_coeff")));
+		std::shared_ptr<eddyViscosityWakeModel> evModel = std::make_shared<eddyViscosityWakeModel>(eddyViscosityWakeModel(wpc.nTurbines, &wt, as_double("wind_resource_turbulence_coeff")));
+		evModel->setThreads((size_t)as_integer("wind_farm_wake_threads"));
+		wakeModel = evModel;
 	}
 	if (!wpc.InitializeModel(wakeModel))
 		throw exec_error("windpower", util::format("Wake model choice must be 0, 1 or 2"));
 
+	// optionally interpolate the wakes from bins of direction and speed, filled by the wake model as they are first used
+	if (as_boolean("wind_farm_wake_cache") && !wpc.InitializeWakeCache(as_double("wind_farm_wake_cache_dir_step"), as_double("wind_farm_wake_cache_speed_step")))
+		throw exec_error("windpower", wpc.GetErrorDetails());
+
 	// allocate output data
 	ssc_number_t *farmpwr = allocate("gen", nstep);
 	ssc_number_t *wspd = allocate("wind_speed", nstep);
@@ -290,6 +290,7 @@ bool dispatch_calculations::init(compute_module *cm, std::vector<double>& degrad
 	m_cm = cm;
 	m_degradation = degradation;
 	m_hourly_energy = hourly_energy;
+	m_dispatch_processed = false;
 	m_timestep = (m_cm->as_integer("ppa_multiplier_model")==1);
 
 	m_nyears = m_cm->as_integer("analysis_period");
@@ -389,10 +390,15 @@ bool dispatch_calculations::compute_outputs( std::vector<double>& ppa)
 	double dispatch_factor8 = m_cm->as_double("dispatch_factor8");
 	double dispatch_factor9 = m_cm->as_double("dispatch_factor9");
 
-	if (m_cm->as_integer("system_use_lifetime_output"))
-		process_lifetime_dispatch_output();
-	else
-		process_dispatch_output();
+	// binning is independent of the ppa price, so callers evaluating several ppa price
+	// streams against the same init() only pay for it once
+	if (!m_dispatch_processed)
+	{
+		if (m_cm->as_integer("system_use_lifetime_output"))
+			m_dispatch_processed = process_lifetime_dispatch_output();
+		else
+			m_dispatch_processed = process_dispatch_output();
+	}
 
 
 // outputs
@@ -3292,3 +3298,145 @@ bool hourly_energy_calculation::calculate(compute_module *cm)
 	return true;
 }
 
+double cf_npv(const util::matrix_t<double> &cf, int cf_line, int nyears, double rate)
+{
+	double rr = 1.0;
+	if (rate != -1.0) rr = 1.0 / (1.0 + rate);
+	double result = 0;
+	for (int i = nyears; i > 0; i--)
+		result = rr * result + cf.at(cf_line, i);
+
+	return result*rr;
+}
+
+/* ported from http://code.google.com/p/irr-newtonraphson-calculator/
+   powers of (1+r) are accumulated year by year rather than recomputed with pow() for every term */
+static bool is_valid_iter_bound(double estimated_return_rate)
+{
+	return estimated_return_rate != -1 && (estimated_return_rate < std::numeric_limits<int>::max()) && (estimated_return_rate > std::numeric_limits<int>::min());
+}
+
+static double irr_poly_sum(const util::matrix_t<double> &cf, double estimated_return_rate, int cf_line, int count)
+{
+	double sum_of_polynomial = 0;
+	if (is_valid_iter_bound(estimated_return_rate))
+	{
+		double val = 1.0;
+		for (int j = 0; j <= count; j++)
+		{
+			if (val != 0.0)
+				sum_of_polynomial += cf.at(cf_line, j) / val;
+			else
+				break;
+			val *= (1 + estimated_return_rate);
+		}
+	}
+	return sum_of_polynomial;
+}
+
+static double irr_derivative_sum(const util::matrix_t<double> &cf, double estimated_return_rate, int cf_line, int count)
+{
+	double sum_of_derivative = 0;
+	if (is_valid_iter_bound(estimated_return_rate))
+	{
+		double val = (1 + estimated_return_rate);
+		for (int i = 1; i <= count; i++)
+		{
+			val *= (1 + estimated_return_rate);
+			sum_of_derivative += cf.at(cf_line, i)*(i) / val;
+		}
+	}
+	return sum_of_derivative*-1;
+}
+
+static double irr_scale_factor(const util::matrix_t<double> &cf, int cf_unscaled, int count)
+{
+	// scale to max value for better irr convergence
+	if (count<1) return 1.0;
+	double max = fabs(cf.at(cf_unscaled, 0));
+	for (int i = 0; i <= count; i++)
+		if (fabs(cf.at(cf_unscaled, i))> max) max = fabs(cf.at(cf_unscaled, i));
+	return (max>0 ? max : 1);
+}
+
+static bool is_valid_irr(const util::matrix_t<double> &cf, int cf_line, int count, double residual, double tolerance, int number_of_iterations, int max_iterations, double calculated_irr, double scale_factor)
+{
+	double npv_of_irr = cf_npv(cf, cf_line, count, calculated_irr) + cf.at(cf_line, 0);
+	double npv_of_irr_plus_delta = cf_npv(cf, cf_line, count, calculated_irr + 0.001) + cf.at(cf_line, 0);
+	return ((number_of_iterations<max_iterations) && (fabs(residual)<tolerance) && (npv_of_irr>npv_of_irr_plus_delta) && (fabs(npv_of_irr / scale_factor)<tolerance));
+}
+
+static double irr_calc(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess, double tolerance, int max_iterations, double scale_factor, int &number_of_iterations, double &residual)
+{
+	double calculated_irr = std::numeric_limits<double>::quiet_NaN();
+	// the derivative is only evaluated at the initial guess
+	double deriv_sum = irr_derivative_sum(cf, initial_guess, cf_line, count);
+	if (deriv_sum != 0.0)
+		calculated_irr = initial_guess - irr_poly_sum(cf, initial_guess, cf_line, count) / deriv_sum;
+	else
+		return initial_guess;
+
+	number_of_iterations++;
+
+	double poly_sum = irr_poly_sum(cf, calculated_irr, cf_line, count);
+	residual = poly_sum / scale_factor;
+
+	while (!(fabs(residual) <= tolerance) && (number_of_iterations < max_iterations))
+	{
+		calculated_irr = calculated_irr - poly_sum / deriv_sum;
+
+		number_of_iterations++;
+		poly_sum = irr_poly_sum(cf, calculated_irr, cf_line, count);
+		residual = poly_sum / scale_factor;
+	}
+	return calculated_irr;
+}
+
+double cf_irr(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess, double tolerance, int max_iterations)
+{
+	int number_of_iterations = 0;
+	double calculated_irr = std::numeric_limits<double>::quiet_NaN();
+
+	if (count < 1)
+		return calculated_irr;
+
+	// only possible for first value negative
+	if ((cf.at(cf_line, 0) <= 0))
+	{
+		// initial guess from http://zainco.blogspot.com/2008/08/internal-rate-of-return-using-newton.html
+		if ((initial_guess < -1) && (count > 1))// second order
+		{
+			if (cf.at(cf_line, 0) != 0)
+			{
+				double b = 2.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0);
+				double c = 1.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0) + cf.at(cf_line, 2) / cf.at(cf_line, 0);
+				initial_guess = -0.5*b - 0.5*sqrt(b*b - 4.0*c);
+				if ((initial_guess <= 0) || (initial_guess >= 1)) initial_guess = -0.5*b + 0.5*sqrt(b*b - 4.0*c);
+			}
+		}
+		else if (initial_guess < 0) // first order
+		{
+			if (cf.at(cf_line, 0) != 0) initial_guess = -(1.0 + cf.at(cf_line, 1) / cf.at(cf_line, 0));
+		}
+
+		double scale_factor = irr_scale_factor(cf, cf_line, count);
+		double residual = DBL_MAX;
+
+		calculated_irr = irr_calc(cf, cf_line, count, initial_guess, tolerance, max_iterations, scale_factor, number_of_iterations, residual);
+
+		// retry with fixed initial guesses of 0.1, -0.1, and 0
+		double retry_guess[3] = { 0.1, -0.1, 0 };
+		for (int k = 0; k < 3; k++)
+		{
+			if (is_valid_irr(cf, cf_line, count, residual, tolerance, number_of_iterations, max_iterations, calculated_irr, scale_factor))
+				break;
+			number_of_iterations = 0;
+			residual = 0;
+			calculated_irr = irr_calc(cf, cf_line, count, retry_guess[k], tolerance, max_iterations, scale_factor, number_of_iterations, residual);
+		}
+
+		if (!is_valid_irr(cf, cf_line, count, residual, tolerance, number_of_iterations, max_iterations, calculated_irr, scale_factor))
+			calculated_irr = std::numeric_limits<double>::quiet_NaN(); // did not converge
+	}
+	return calculated_irr;
+}
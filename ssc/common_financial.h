@@ -56,6 +56,12 @@
 
 void save_cf(compute_module *cm, util::matrix_t<double>& mat, int cf_line, int nyears, const std::string &name);
 
+/* Net present value and internal rate of return of a cash flow line (row) in a financial model's cash flow
+matrix, shared by the single owner, partnership flip, sale leaseback, and host developer models.
+The year 0 value is not included in the net present value. */
+double cf_npv(const util::matrix_t<double> &cf, int cf_line, int nyears, double rate);
+double cf_irr(const util::matrix_t<double> &cf, int cf_line, int count, double initial_guess = -2, double tolerance = 1e-6, int max_iterations = 100);
+
 
 
 class dispatch_calculations
@@ -73,9 +79,10 @@ private:
 	ssc_number_t *m_multipliers;
 	size_t m_ngen;
 	size_t m_nmultipliers;
+	bool m_dispatch_processed; // TOD energy binning only depends on init() inputs
 
 public:
-	dispatch_calculations() {};
+	dispatch_calculations() : m_dispatch_processed(false) {};
 	dispatch_calculations(compute_module *cm, std::vector<double>& degradation, std::vector<double>& hourly_energy);
 	bool init(compute_module *cm, std::vector<double>& degradation, std::vector<double>& hourly_energy);
 	bool setup();
@@ -257,6 +257,7 @@ public:
 	bool is_ssc_array_output( const std::string &name ) throw( general_error );
 	var_data *lookup( const std::string &name ) throw( general_error );
 	var_data *assign( const std::string &name, const var_data &value ) throw( general_error );
+	void unassign( const std::string &name ) throw( general_error );
 	ssc_number_t *allocate( const std::string &name, size_t length ) throw( general_error );
 	ssc_number_t *allocate( const std::string &name, size_t nrows, size_t ncols ) throw( general_error );
 	util::matrix_t<ssc_number_t>& allocate_matrix( const std::string &name, size_t nrows, size_t ncols ) throw( general_error );
@@ -283,6 +284,9 @@ public:
 	bool get_matrix(const std::string &name, util::matrix_t<ssc_number_t> &mat) throw(general_error);
 
 	size_t check_timestep_seconds( double t_start, double t_end, double t_step ) throw( timestep_error );
+
+	// checks an assigned variable against the constraints in its var_info entry
+	bool check_constraints( const std::string &name, std::string &fail_text ) throw( general_error );
 	
 	ssc_number_t accumulate_annual(const std::string &hourly_var, const std::string &annual_var, double scale=1.0) throw(exec_error);
 	ssc_number_t *accumulate_monthly(const std::string &hourly_var, const std::string &annual_var, double scale=1.0) throw(exec_error);
@@ -295,7 +299,6 @@ private:
 	bool verify(const std::string &phase, int var_types) throw( general_error );
 	
 	bool check_required( const std::string &name ) throw( general_error );
-	bool check_constraints( const std::string &name, std::string &fail_text ) throw( general_error );
 
 	// helper functions for check_required
 	ssc_number_t get_operand_value( const std::string &input, const std::string &cur_var_name ) throw( general_error );
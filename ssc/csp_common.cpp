@@ -594,6 +594,8 @@ var_info vtab_sco2_design[] = {
 	{ SSC_INPUT,  SSC_NUMBER,  "des_objective",        "[2] = hit min phx deltat then max eta, [else] max eta",  "",           "",    "",      "?=0",   "",       "" },
 	{ SSC_INPUT,  SSC_NUMBER,  "min_phx_deltaT",       "Minimum design temperature difference across PHX",       "C",          "",    "",      "?=0",   "",       "" },	
 	{ SSC_INPUT,  SSC_NUMBER,  "rel_tol",              "Baseline solver and optimization relative tolerance exponent (10^-rel_tol)", "-", "", "", "?=3","",       "" },	
+	{ SSC_INPUT,  SSC_NUMBER,  "des_n_multi_start",    "Number of design optimization starting points, >1 runs multi-start", "", "",    "",      "?=1",   "",       "" },
+	{ SSC_INPUT,  SSC_NUMBER,  "des_n_threads",        "Threads for multi-start design optimization, <=0 uses all", "",     "",    "",      "?=0",   "",       "" },
 		// Cycle Design
 	{ SSC_INPUT,  SSC_NUMBER,  "eta_isen_mc",          "Design main compressor isentropic efficiency",           "-",          "",    "",      "*",     "",       "" },
 	{ SSC_INPUT,  SSC_NUMBER,  "eta_isen_rc",          "Design re-compressor isentropic efficiency",             "-",          "",    "",      "*",     "",       "" },
@@ -790,6 +792,9 @@ int sco2_design_cmod_common(compute_module *cm, C_sco2_recomp_csp & c_sco2_cycle
 
 	sco2_rc_des_par.m_is_recomp_ok = cm->as_integer("is_recomp_ok");
 
+	sco2_rc_des_par.m_n_multi_start = cm->as_integer("des_n_multi_start");	//[-]
+	sco2_rc_des_par.m_n_threads = cm->as_integer("des_n_threads");			//[-]
+
 	sco2_rc_des_par.m_P_high_limit = cm->as_double("P_high_limit")*1000.0;		//[kPa], convert from MPa
 	sco2_rc_des_par.m_fixed_P_mc_out = cm->as_integer("is_P_high_fixed");		//[-]
 	double mc_PR_in = cm->as_double("is_PR_fixed");		//[-]
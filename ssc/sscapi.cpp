@@ -49,6 +49,9 @@
 
 #include <stdio.h>
 #include <cstring>
+#include <thread>
+#include <mutex>
+#include <deque>
 
 #include "core.h"
 #include "sscapi.h"
@@ -402,6 +405,20 @@ SSCEXPORT ssc_data_t ssc_data_get_table( ssc_data_t p_data, const char *name )
 	return static_cast<ssc_data_t>( &(dat->table) );
 }
 
+SSCEXPORT ssc_bool_t ssc_data_write_binary( ssc_data_t p_data, const char *file )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt || !file) return 0;
+	return vt->write_binary( std::string(file) ) ? 1 : 0;
+}
+
+SSCEXPORT ssc_bool_t ssc_data_read_binary( ssc_data_t p_data, const char *file )
+{
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!vt || !file) return 0;
+	return vt->read_binary( std::string(file) ) ? 1 : 0;
+}
+
 SSCEXPORT ssc_entry_t ssc_module_entry( int index )
 {
 	int max=0;
@@ -682,6 +699,222 @@ SSCEXPORT const char *ssc_module_log( ssc_module_t p_mod, int index, int *item_t
 	return l->text.c_str();
 }
 
+/*************************** batch execution ***************************/
+
+class batch_runner
+{
+public:
+	struct batch_case
+	{
+		batch_case( var_table *vt ) : data(vt), status(SSC_BATCH_PENDING) {  }
+
+		var_table *data;
+		int status;
+		std::vector< compute_module::log_item > log;
+	};
+
+	batch_runner( const std::string &name, size_t nthreads )
+		: m_name(name), m_nthreads(nthreads) {  }
+
+	size_t add( var_table *vt )
+	{
+		m_cases.push_back( batch_case(vt) );
+		return m_cases.size()-1;
+	}
+
+	std::vector< batch_case > &cases() { return m_cases; }
+
+	bool run()
+	{
+		std::vector<size_t> pending;
+		for( size_t i=0;i<m_cases.size();i++ )
+			if ( m_cases[i].status == SSC_BATCH_PENDING )
+				pending.push_back( i );
+
+		if ( pending.size() == 0 ) return all_succeeded();
+
+		size_t nworkers = std::min( m_nthreads, pending.size() );
+
+		// deal the cases out round robin so each worker starts with its own share
+		m_queues.clear();
+		for( size_t i=0;i<nworkers;i++ )
+			m_queues.push_back( std::unique_ptr<work_queue>( new work_queue ) );
+		for( size_t i=0;i<pending.size();i++ )
+			m_queues[ i % nworkers ]->items.push_back( pending[i] );
+
+		if ( nworkers == 1 )
+			worker( 0 );
+		else
+		{
+			std::vector<std::thread> threads;
+			for( size_t i=0;i<nworkers;i++ )
+				threads.push_back( std::thread( &batch_runner::worker, this, i ) );
+			for( size_t i=0;i<threads.size();i++ )
+				threads[i].join();
+		}
+
+		m_queues.clear();
+		return all_succeeded();
+	}
+
+private:
+	struct work_queue
+	{
+		std::mutex lock;
+		std::deque<size_t> items;
+	};
+
+	bool all_succeeded()
+	{
+		for( size_t i=0;i<m_cases.size();i++ )
+			if ( m_cases[i].status != SSC_BATCH_SUCCESS )
+				return false;
+		return true;
+	}
+
+	bool next_case( size_t worker, size_t *index )
+	{
+		// take from the front of our own queue first
+		{
+			work_queue &q = *m_queues[worker];
+			std::lock_guard<std::mutex> guard( q.lock );
+			if ( q.items.size() > 0 )
+			{
+				*index = q.items.front();
+				q.items.pop_front();
+				return true;
+			}
+		}
+
+		// otherwise steal from the back of another worker's queue
+		for( size_t k=1;k<m_queues.size();k++ )
+		{
+			work_queue &q = *m_queues[ (worker+k) % m_queues.size() ];
+			std::lock_guard<std::mutex> guard( q.lock );
+			if ( q.items.size() > 0 )
+			{
+				*index = q.items.back();
+				q.items.pop_back();
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void worker( size_t id )
+	{
+		compute_module *cm = 0;
+		size_t index;
+		while( next_case( id, &index ) )
+		{
+			batch_case &bc = m_cases[index];
+
+			if ( !cm ) cm = static_cast<compute_module*>( ssc_module_create( m_name.c_str() ) );
+			if ( !cm )
+			{
+				bc.log.push_back( compute_module::log_item( SSC_ERROR, "could not create compute module: " + m_name ) );
+				bc.status = SSC_BATCH_FAILED;
+				continue;
+			}
+
+			cm->clear_log();
+
+			bool ok = false;
+			try {
+				ok = ssc_module_exec_with_handler( static_cast<ssc_module_t>(cm), static_cast<ssc_data_t>(bc.data),
+					default_internal_handler_no_print, 0 ) ? true : false;
+			} catch( std::exception &e ) {
+				cm->log( std::string("unhandled exception: ") + e.what(), SSC_ERROR );
+			} catch( ... ) {
+				cm->log( "unhandled exception", SSC_ERROR );
+			}
+
+			int i=0;
+			compute_module::log_item *item;
+			while( (item = cm->log(i++)) )
+				bc.log.push_back( *item );
+
+			bc.status = ok ? SSC_BATCH_SUCCESS : SSC_BATCH_FAILED;
+
+			// a module that failed part way through may hold stale state, so start the next case with a new instance
+			if ( !ok )
+			{
+				delete cm;
+				cm = 0;
+			}
+		}
+
+		if ( cm ) delete cm;
+	}
+
+	std::string m_name;
+	size_t m_nthreads;
+	std::vector< batch_case > m_cases;
+	std::vector< std::unique_ptr<work_queue> > m_queues;
+};
+
+SSCEXPORT ssc_batch_t ssc_batch_create( const char *name, int nthreads )
+{
+	// make sure the module exists before accepting any cases
+	ssc_module_t p_mod = ssc_module_create( name );
+	if ( !p_mod ) return 0;
+	ssc_module_free( p_mod );
+
+	if ( nthreads < 1 ) nthreads = (int) std::thread::hardware_concurrency();
+	if ( nthreads < 1 ) nthreads = 1;
+
+	return static_cast<ssc_batch_t>( new batch_runner( name, (size_t)nthreads ) );
+}
+
+SSCEXPORT void ssc_batch_free( ssc_batch_t p_batch )
+{
+	batch_runner *br = static_cast<batch_runner*>(p_batch);
+	if (br) delete br;
+}
+
+SSCEXPORT int ssc_batch_add( ssc_batch_t p_batch, ssc_data_t p_data )
+{
+	batch_runner *br = static_cast<batch_runner*>(p_batch);
+	var_table *vt = static_cast<var_table*>(p_data);
+	if (!br || !vt) return -1;
+	return (int) br->add( vt );
+}
+
+SSCEXPORT int ssc_batch_count( ssc_batch_t p_batch )
+{
+	batch_runner *br = static_cast<batch_runner*>(p_batch);
+	return br ? (int) br->cases().size() : 0;
+}
+
+SSCEXPORT ssc_bool_t ssc_batch_run( ssc_batch_t p_batch )
+{
+	batch_runner *br = static_cast<batch_runner*>(p_batch);
+	if (!br) return 0;
+	return br->run() ? 1 : 0;
+}
+
+SSCEXPORT int ssc_batch_status( ssc_batch_t p_batch, int case_index )
+{
+	batch_runner *br = static_cast<batch_runner*>(p_batch);
+	if (!br || case_index < 0 || case_index >= (int)br->cases().size()) return SSC_INVALID;
+	return br->cases()[case_index].status;
+}
+
+SSCEXPORT const char *ssc_batch_log( ssc_batch_t p_batch, int case_index, int index, int *item_type, float *time )
+{
+	batch_runner *br = static_cast<batch_runner*>(p_batch);
+	if (!br || case_index < 0 || case_index >= (int)br->cases().size()) return 0;
+
+	std::vector< compute_module::log_item > &log = br->cases()[case_index].log;
+	if (index < 0 || index >= (int)log.size()) return 0;
+
+	if (item_type) *item_type = log[index].type;
+	if (time) *time = log[index].time;
+
+	return log[index].text.c_str();
+}
+
 SSCEXPORT void __ssc_segfault()
 {
 	std::string *pstr = 0;
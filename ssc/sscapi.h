@@ -186,6 +186,17 @@ SSCEXPORT ssc_number_t *ssc_data_get_matrix( ssc_data_t p_data, const char *name
 SSCEXPORT ssc_data_t ssc_data_get_table( ssc_data_t p_data, const char *name );
 /**@}*/ 
 
+/** @name Binary storage of data objects.
+All variables in a data object, including nested tables, are written in a versioned binary format that is much faster to write and read than text. The format uses the native byte order and size of @a ssc_number_t, and files written on an incompatible platform are rejected by the reader.
+*/
+/**@{*/
+/** Writes the data object to a binary file. Returns 1 on success, 0 on failure. */
+SSCEXPORT ssc_bool_t ssc_data_write_binary( ssc_data_t p_data, const char *file );
+
+/** Replaces the contents of the data object with the variables stored in a binary file written by ssc_data_write_binary. Returns 1 on success, 0 on failure, in which case the data object is left empty. */
+SSCEXPORT ssc_bool_t ssc_data_read_binary( ssc_data_t p_data, const char *file );
+/**@}*/ 
+
 /** The opaque data structure that stores information about a compute module. */
 typedef void* ssc_entry_t;
 
@@ -324,6 +335,52 @@ SSCEXPORT ssc_bool_t ssc_module_exec_with_handler(
 /** Retrive notices, warnings, and error messages from the simulation. Returns a NULL-terminated ASCII C string with the message text, or NULL if the index passed in was invalid. */
 SSCEXPORT const char *ssc_module_log( ssc_module_t p_mod, int index, int *item_type, float *time );
 
+/** An opaque reference to a batch of data sets that are all run through the same compute module. */
+typedef void* ssc_batch_t;
+
+/** @name Batch case status values returned by ssc_batch_status:*/
+/**@{*/
+#define SSC_BATCH_PENDING 1
+#define SSC_BATCH_SUCCESS 2
+#define SSC_BATCH_FAILED 3
+/**@}*/
+
+/** Creates a batch that runs the named compute module over many data sets on a fixed-size pool of worker threads. If nthreads is less than 1, the number of hardware threads is used. Returns 0 (NULL) if the module name is invalid. Example:
+
+	\verbatim
+	ssc_batch_t p_batch = ssc_batch_create( "pvsamv1", 0 );
+	for( int i=0;i<ncases;i++ )
+		ssc_batch_add( p_batch, cases[i] );
+
+	if ( !ssc_batch_run( p_batch ) )
+	{
+		for( int i=0;i<ncases;i++ )
+			if ( ssc_batch_status( p_batch, i ) == SSC_BATCH_FAILED )
+				printf("case %d failed\n", i );
+	}
+	ssc_batch_free( p_batch );
+	\endverbatim
+*/
+SSCEXPORT ssc_batch_t ssc_batch_create( const char *name, int nthreads );
+
+/** Releases a batch created with ssc_batch_create. The data sets that were added to the batch are not freed. */
+SSCEXPORT void ssc_batch_free( ssc_batch_t p_batch );
+
+/** Adds a data set to the batch and returns its case index, or -1 on failure. The batch does not take ownership of the data set. It must stay valid until ssc_batch_run returns, and outputs are written into it as with ssc_module_exec. */
+SSCEXPORT int ssc_batch_add( ssc_batch_t p_batch, ssc_data_t p_data );
+
+/** Returns the number of cases in the batch. */
+SSCEXPORT int ssc_batch_count( ssc_batch_t p_batch );
+
+/** Runs all pending cases in the batch and returns when they are finished. Each worker thread creates one instance of the compute module and reuses it for every case it runs. Cases are dealt out to the workers up front, and a worker that runs out steals pending cases from the others. Returns 1 if every case succeeded, otherwise 0. The compute module must be thread-safe, see ssc_module_exec_simple. */
+SSCEXPORT ssc_bool_t ssc_batch_run( ssc_batch_t p_batch );
+
+/** Returns the status of a case: SSC_BATCH_PENDING, SSC_BATCH_SUCCESS, or SSC_BATCH_FAILED. Returns SSC_INVALID for an invalid case index. */
+SSCEXPORT int ssc_batch_status( ssc_batch_t p_batch, int case_index );
+
+/** Retrieves the notices, warnings, and error messages logged while running a case, in the same way as ssc_module_log. */
+SSCEXPORT const char *ssc_batch_log( ssc_batch_t p_batch, int case_index, int index, int *item_type, float *time );
+
 /** DO NOT CALL THIS FUNCTION: immediately causes a segmentation fault within the library. This is only useful for testing crash handling from an external application that is dynamically linked to the SSC library */
 SSCEXPORT void __ssc_segfault();
 
@@ -55,6 +55,7 @@ tcKernel::tcKernel(tcstypeprovider *prov)
 {
 	m_storeArrMatData = false;
 	m_storeAllParameters = false;
+	m_storeSinglePrecision = false;
 }
 
 tcKernel::~tcKernel()
@@ -98,52 +99,46 @@ bool tcKernel::converged( double time )
 		}
 	}
 
-	std::string buf;
-	char ibuf[128];
-	size_t j,k;
+	size_t k, n;
 	for ( size_t i=0;i<m_results.size(); i++ )
 	{
-		tcsvalue &v = m_results[i].u->values[ m_results[i].idx ];
-		switch( m_results[i].type )
+		dataset &d = m_results[i];
+		tcsvalue &v = d.u->values[ d.idx ];
+		switch( d.type )
 		{
 		case TCS_NUMBER:
-			m_results[i].values[ m_dataIndex ].dval = v.data.value;
+			if ( m_storeSinglePrecision )
+				d.fvalues[ m_dataIndex ] = (float)v.data.value;
+			else
+				d.dvalues[ m_dataIndex ] = v.data.value;
 			break;
 		case TCS_STRING:
-			m_results[i].values[ m_dataIndex ].sval = v.data.cstr;
+			d.svalues[ m_dataIndex ] = v.data.cstr;
 			break;
 		case TCS_ARRAY:
+		case TCS_MATRIX:
 			if ( m_storeArrMatData )
 			{
-				buf = "[ ";
-				for (j=0;j<v.data.array.length;j++)
+				const double *p;
+				if ( d.type == TCS_ARRAY )
 				{
-					mysnprintf(ibuf, 126, "%lg%c", v.data.array.values[j],
-						j < v.data.array.length-1 ? ',' : ' ');
-					buf += ibuf;
+					p = v.data.array.values;
+					n = v.data.array.length;
+					d.nrows[ m_dataIndex ] = 1;
+					d.ncols[ m_dataIndex ] = (int)n;
 				}
-				buf += "]";
-				m_results[i].values[ m_dataIndex ].sval = buf;
-			}
-			break;
-		case TCS_MATRIX:
-			if ( m_storeArrMatData )
-			{
-				mysnprintf( ibuf, 126, "{ %dx%d ", v.data.matrix.nrows, v.data.matrix.ncols );
-				buf = ibuf;
-				for (j=0;j<v.data.matrix.nrows;j++)
+				else
 				{
-					buf += " [";
-					for (k=0;k<v.data.matrix.ncols;k++)
-					{
-						mysnprintf(ibuf, 126, "%lg%c", TCS_MATRIX_INDEX(&v, j, k),
-							k < v.data.matrix.ncols-1 ? ',' : ' ');
-						buf += ibuf;
-					}
-					buf += "]";
+					p = v.data.matrix.values;
+					n = v.data.matrix.nrows * v.data.matrix.ncols;
+					d.nrows[ m_dataIndex ] = v.data.matrix.nrows;
+					d.ncols[ m_dataIndex ] = v.data.matrix.ncols;
 				}
-				buf += " }";
-				m_results[i].values[ m_dataIndex ].sval = buf;		
+
+				// avalues was reserved for the first step's size, so this only reallocates if the shape grows
+				for ( k=0;k<n;k++ )
+					d.avalues.push_back( p[k] );
+				d.offsets[ m_dataIndex+1 ] = d.avalues.size();
 			}
 			break;
 		}
@@ -154,6 +149,13 @@ bool tcKernel::converged( double time )
 	return true;
 }
 
+static size_t array_reserve_length( const tcsvalue &v )
+{
+	if ( v.type == TCS_ARRAY ) return (size_t)v.data.array.length;
+	if ( v.type == TCS_MATRIX ) return (size_t)(v.data.matrix.nrows * v.data.matrix.ncols);
+	return 0;
+}
+
 int tcKernel::simulate( double start, double end, double step, int max_iter )
 {
 
@@ -205,7 +207,36 @@ int tcKernel::simulate( double start, double end, double step, int max_iter )
 				d.name = vars[idx].name;
 				d.units = vars[idx].units;
 				d.type = vars[idx].data_type;
-				d.values.resize( nsteps, dataitem(0.0) );
+				d.nsteps = (size_t)nsteps;
+				d.dvalues.clear();
+				d.fvalues.clear();
+				d.svalues.clear();
+				d.avalues.clear();
+				d.offsets.clear();
+				d.nrows.clear();
+				d.ncols.clear();
+				switch( d.type )
+				{
+				case TCS_NUMBER:
+					if ( m_storeSinglePrecision )
+						d.fvalues.resize( nsteps, 0.0f );
+					else
+						d.dvalues.resize( nsteps, 0.0 );
+					break;
+				case TCS_STRING:
+					d.svalues.resize( nsteps );
+					break;
+				case TCS_ARRAY:
+				case TCS_MATRIX:
+					if ( m_storeArrMatData )
+					{
+						d.offsets.resize( nsteps+1, 0 );
+						d.nrows.resize( nsteps, 0 );
+						d.ncols.resize( nsteps, 0 );
+						d.avalues.reserve( (size_t)nsteps * array_reserve_length( m_units[i].values[idx] ) );
+					}
+					break;
+				}
 			}
 			idx++;
 		}
@@ -332,10 +363,10 @@ bool tcKernel::set_output_array(const char *ssc_output_name, const char *tcs_out
 	ssc_number_t *output_array = allocate( ssc_output_name, len );
 	while( tcKernel::dataset *d = get_results(idx++) )
 	{
-		if ( (d->type == TCS_NUMBER) && (d->name == tcs_output_name) && (d->values.size() == len ) )
+		if ( (d->type == TCS_NUMBER) && (d->name == tcs_output_name) && (d->size() == len ) )
 		{
 			for (size_t i=0;i<len;i++)
-				output_array[i] = (ssc_number_t)(d->values[i].dval * scaling);
+				output_array[i] = (ssc_number_t)(d->value(i) * scaling);
 			return true;
 		}
 	}
@@ -352,9 +383,9 @@ bool tcKernel::set_all_output_arrays()
 		// if there is an SSC_OUTPUT with the same name
 		if ( (d->type == TCS_NUMBER) && ( is_ssc_array_output(d->name) ) )
 		{
-			ssc_number_t *output_array = allocate( d->name, d->values.size() );
-			for (size_t i=0; i<d->values.size(); i++)
-				output_array[i] = (ssc_number_t) d->values[i].dval;
+			ssc_number_t *output_array = allocate( d->name, d->size() );
+			for (size_t i=0; i<d->size(); i++)
+				output_array[i] = (ssc_number_t) d->value(i);
 		}
 	}
 
@@ -64,6 +64,7 @@ public:
 	virtual bool converged( double time );
 	void set_store_array_matrix_data( bool b ) { m_storeArrMatData = b; }
 	void set_store_all_parameters( bool b ) { m_storeAllParameters = b; }
+	void set_store_single_precision( bool b ) { m_storeSinglePrecision = b; }
 	virtual int simulate( double start, double end, double step, int max_iter = 100 );
 	void set_unit_value_ssc_string( int id, const char *name );
 	void set_unit_value_ssc_double( int id, const char *name );
@@ -83,14 +84,7 @@ public:
 	bool set_output_array(const char *ssc_output_name, const char *tcs_output_name, size_t len, double scaling = 1);
 	bool set_all_output_arrays();
 
-	struct dataitem {
-		dataitem( const char *s ) : sval(s) { }
-		dataitem( const std::string &s ) : sval(s) { }
-		dataitem( double d ) : dval(d) { }
-		std::string sval;
-		double dval;
-	};
-
+	// results are stored column-wise, one typed buffer per output preallocated for all time steps
 	struct dataset {
 		unit *u;
 		int uidx;
@@ -99,13 +93,28 @@ public:
 		std::string units;
 		std::string group;
 		int type;
-		std::vector<dataitem> values;
+		size_t nsteps;
+
+		std::vector<double> dvalues; // TCS_NUMBER
+		std::vector<float> fvalues; // TCS_NUMBER, if single precision storage is enabled
+		std::vector<std::string> svalues; // TCS_STRING
+
+		// TCS_ARRAY and TCS_MATRIX values for all steps stored back to back,
+		// step i occupies [ offsets[i], offsets[i+1] ) and has shape nrows[i] x ncols[i]
+		std::vector<double> avalues;
+		std::vector<size_t> offsets;
+		std::vector<int> nrows;
+		std::vector<int> ncols;
+
+		size_t size() const { return nsteps; }
+		double value( size_t i ) const { return dvalues.size() > 0 ? dvalues[i] : (double)fvalues[i]; }
 	};
 
 	dataset *get_results(int idx);
 
 private:
 	bool m_storeArrMatData;
+	bool m_storeSinglePrecision; // true = TCS_NUMBER results are stored as float to halve the memory used for long subhourly runs
 	bool m_storeAllParameters; // true = all inputs/outputs for all units will be saved for every time step; false = only store values that match SSC parameters defined as SSC_OUTPUT or SSC_INOUT
 	std::vector< dataset > m_results;
 	double m_start, m_end, m_step;
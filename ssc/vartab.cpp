@@ -47,6 +47,9 @@
 *  THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 *******************************************************************************************************/
 
+#include <cstdio>
+#include <cstring>
+
 #include "lib_util.h"
 #include "vartab.h"
 
@@ -299,3 +302,221 @@ const char *var_table::next()
 	return NULL;
 }
 
+/* binary format:
+	header: 8 byte magic, uint32 version, uint32 byte order mark, uint32 sizeof(ssc_number_t), uint32 reserved
+	table:  uint64 variable count, then for each variable:
+		uint32 name length, name, uint8 type, padding to 8 bytes, and the value:
+			SSC_STRING: uint64 length, characters, padding to 8 bytes
+			SSC_NUMBER, SSC_ARRAY, SSC_MATRIX: uint64 rows, uint64 cols, rows*cols ssc_number_t, padding to 8 bytes
+			SSC_TABLE: nested table
+	all values are in native byte order, which the byte order mark records */
+
+static const char vtbin_magic[8] = { 'S', 'S', 'C', 'V', 'T', 'B', 'I', 'N' };
+static const unsigned int vtbin_version = 1;
+static const unsigned int vtbin_byte_order = 0x01020304;
+static const int vtbin_max_depth = 64;
+
+static void vtbin_put( std::vector<unsigned char> &buf, const void *p, size_t len )
+{
+	if (len == 0) return;
+	const unsigned char *c = static_cast<const unsigned char*>(p);
+	buf.insert( buf.end(), c, c + len );
+}
+
+template<typename T> static void vtbin_put_pod( std::vector<unsigned char> &buf, T v )
+{
+	vtbin_put( buf, &v, sizeof(T) );
+}
+
+static void vtbin_pad( std::vector<unsigned char> &buf )
+{
+	while( buf.size() % 8 != 0 )
+		buf.push_back( 0 );
+}
+
+static bool vtbin_get( const unsigned char *buf, size_t len, size_t &pos, void *p, size_t n )
+{
+	if ( n > len || pos > len - n ) return false;
+	if ( n > 0 ) memcpy( p, buf + pos, n );
+	pos += n;
+	return true;
+}
+
+template<typename T> static bool vtbin_get_pod( const unsigned char *buf, size_t len, size_t &pos, T *v )
+{
+	return vtbin_get( buf, len, pos, v, sizeof(T) );
+}
+
+static bool vtbin_skip_pad( size_t len, size_t &pos )
+{
+	size_t next = (pos + 7) / 8 * 8;
+	if ( next > len ) return false;
+	pos = next;
+	return true;
+}
+
+void var_table::write_binary_table( std::vector<unsigned char> &buf ) const
+{
+	vtbin_put_pod<unsigned long long>( buf, (unsigned long long)m_hash.size() );
+
+	for ( var_hash::const_iterator it = m_hash.begin(); it != m_hash.end(); ++it )
+	{
+		const std::string &name = it->first;
+		var_data &v = *(it->second);
+
+		vtbin_put_pod<unsigned int>( buf, (unsigned int)name.length() );
+		vtbin_put( buf, name.c_str(), name.length() );
+		vtbin_put_pod<unsigned char>( buf, v.type );
+		vtbin_pad( buf );
+
+		switch( v.type )
+		{
+		case SSC_STRING:
+			vtbin_put_pod<unsigned long long>( buf, (unsigned long long)v.str.length() );
+			vtbin_put( buf, v.str.c_str(), v.str.length() );
+			vtbin_pad( buf );
+			break;
+		case SSC_NUMBER:
+		case SSC_ARRAY:
+		case SSC_MATRIX:
+			vtbin_put_pod<unsigned long long>( buf, (unsigned long long)v.num.nrows() );
+			vtbin_put_pod<unsigned long long>( buf, (unsigned long long)v.num.ncols() );
+			vtbin_put( buf, v.num.data(), v.num.nrows()*v.num.ncols()*sizeof(ssc_number_t) );
+			vtbin_pad( buf );
+			break;
+		case SSC_TABLE:
+			v.table.write_binary_table( buf );
+			break;
+		}
+	}
+}
+
+bool var_table::read_binary_table( const unsigned char *buf, size_t len, size_t &pos, int depth )
+{
+	if ( depth > vtbin_max_depth ) return false;
+
+	unsigned long long count = 0;
+	if ( !vtbin_get_pod( buf, len, pos, &count ) ) return false;
+
+	for ( unsigned long long i = 0; i < count; i++ )
+	{
+		unsigned int name_len = 0;
+		if ( !vtbin_get_pod( buf, len, pos, &name_len ) || name_len > len - pos ) return false;
+		std::string name( (const char*)buf + pos, name_len );
+		pos += name_len;
+
+		unsigned char type = SSC_INVALID;
+		if ( !vtbin_get_pod( buf, len, pos, &type ) || !vtbin_skip_pad( len, pos ) ) return false;
+
+		var_data *v = assign( name, var_data() );
+		v->type = type;
+
+		switch( type )
+		{
+		case SSC_INVALID:
+			break;
+		case SSC_STRING:
+			{
+				unsigned long long n = 0;
+				if ( !vtbin_get_pod( buf, len, pos, &n ) || n > len - pos ) return false;
+				v->str.assign( (const char*)buf + pos, (size_t)n );
+				pos += (size_t)n;
+				if ( !vtbin_skip_pad( len, pos ) ) return false;
+			}
+			break;
+		case SSC_NUMBER:
+		case SSC_ARRAY:
+		case SSC_MATRIX:
+			{
+				unsigned long long nr = 0, nc = 0;
+				if ( !vtbin_get_pod( buf, len, pos, &nr ) || !vtbin_get_pod( buf, len, pos, &nc ) ) return false;
+				if ( nc != 0 && nr > (len - pos) / sizeof(ssc_number_t) / nc ) return false;
+				size_t nn = (size_t)(nr*nc);
+				v->num.resize( (size_t)nr, (size_t)nc );
+				if ( nn > 0 && !vtbin_get( buf, len, pos, v->num.data(), nn*sizeof(ssc_number_t) ) ) return false;
+				if ( !vtbin_skip_pad( len, pos ) ) return false;
+			}
+			break;
+		case SSC_TABLE:
+			if ( !v->table.read_binary_table( buf, len, pos, depth + 1 ) ) return false;
+			break;
+		default:
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void var_table::write_binary( std::vector<unsigned char> &buf ) const
+{
+	buf.clear();
+	vtbin_put( buf, vtbin_magic, sizeof(vtbin_magic) );
+	vtbin_put_pod<unsigned int>( buf, vtbin_version );
+	vtbin_put_pod<unsigned int>( buf, vtbin_byte_order );
+	vtbin_put_pod<unsigned int>( buf, (unsigned int)sizeof(ssc_number_t) );
+	vtbin_put_pod<unsigned int>( buf, 0 );
+	write_binary_table( buf );
+}
+
+bool var_table::read_binary( const unsigned char *buf, size_t len )
+{
+	clear();
+
+	size_t pos = 0;
+	char magic[sizeof(vtbin_magic)];
+	unsigned int version = 0, byte_order = 0, num_size = 0, reserved = 0;
+	if ( !buf
+		|| !vtbin_get( buf, len, pos, magic, sizeof(magic) )
+		|| memcmp( magic, vtbin_magic, sizeof(magic) ) != 0
+		|| !vtbin_get_pod( buf, len, pos, &version )
+		|| !vtbin_get_pod( buf, len, pos, &byte_order )
+		|| !vtbin_get_pod( buf, len, pos, &num_size )
+		|| !vtbin_get_pod( buf, len, pos, &reserved )
+		|| version != vtbin_version
+		|| byte_order != vtbin_byte_order
+		|| num_size != sizeof(ssc_number_t) )
+		return false;
+
+	if ( !read_binary_table( buf, len, pos, 0 ) )
+	{
+		clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool var_table::write_binary( const std::string &file ) const
+{
+	std::vector<unsigned char> buf;
+	write_binary( buf );
+
+	FILE *fp = fopen( file.c_str(), "wb" );
+	if ( !fp ) return false;
+	bool ok = fwrite( &buf[0], 1, buf.size(), fp ) == buf.size();
+	ok = ( fclose( fp ) == 0 ) && ok;
+	return ok;
+}
+
+bool var_table::read_binary( const std::string &file )
+{
+	clear();
+
+	FILE *fp = fopen( file.c_str(), "rb" );
+	if ( !fp ) return false;
+
+	std::vector<unsigned char> buf;
+	bool ok = fseek( fp, 0, SEEK_END ) == 0;
+	long len = ok ? ftell( fp ) : -1;
+	ok = ok && len > 0 && fseek( fp, 0, SEEK_SET ) == 0;
+	if ( ok )
+	{
+		buf.resize( (size_t)len );
+		ok = fread( &buf[0], 1, buf.size(), fp ) == buf.size();
+	}
+	fclose( fp );
+
+	return ok && read_binary( &buf[0], buf.size() );
+}
+
@@ -52,6 +52,7 @@
 
 #include "../shared/lib_util.h"
 #include <string>
+#include <vector>
 #include "sscapi.h"
 
 
@@ -82,7 +83,18 @@ public:
 	unsigned int size() { return (unsigned int)m_hash.size(); }
 	var_table &operator=( const var_table &rhs );
 
+	// Versioned binary format for the whole table, including nested tables. Numeric data is stored
+	// as raw 8-byte aligned ssc_number_t blocks, so the reader only has to copy each block into place
+	// and can work directly on a memory-mapped file
+	void write_binary( std::vector<unsigned char> &buf ) const;
+	bool read_binary( const unsigned char *buf, size_t len );
+	bool write_binary( const std::string &file ) const;
+	bool read_binary( const std::string &file );
+
 private:
+	void write_binary_table( std::vector<unsigned char> &buf ) const;
+	bool read_binary_table( const unsigned char *buf, size_t len, size_t &pos, int depth );
+
 	var_hash m_hash;
 	var_hash::iterator m_iterator;
 };
@@ -46,6 +46,10 @@ thermodynamic property functions are:
   int CO2_HS( double H, double S, CO2_state * state )
   int CO2_TQ( double T, double Q, CO2_state * state )
 
+Array versions of CO2_TD, CO2_PH, and CO2_PS (CO2_TD_array, etc.) take the number of states and
+arrays of the two known properties, fill an array of CO2_state structures, and return the first
+nonzero error code.
+
 The first two arguments correspond to the known independent properties:
 
   T -- temperature (K)
@@ -127,6 +131,11 @@ int CO2_PS( double P, double S, CO2_state * state );
 int CO2_HS( double H, double S, CO2_state * state );
 int CO2_TQ( double T, double Q, CO2_state * state );
 
+// Array versions: evaluate n states and return the first nonzero error code (0 if all succeed).
+int CO2_TD_array( int n, const double * T, const double * D, CO2_state * states );
+int CO2_PH_array( int n, const double * P, const double * H, CO2_state * states );
+int CO2_PS_array( int n, const double * P, const double * S, CO2_state * states );
+
 // Miscellaneous functions (will return -9.0e99 if the input is not valid).
 double CO2_visc( double D, double T);	//(uPa-s)
 double CO2_cond( double D, double T);	//(W/m-K)
@@ -179,7 +188,7 @@ namespace N_co2_props
 		double * __restrict dfdT
 		);
 
-	void find_element(const double T, const double D, Element * __restrict e);
+	const Element * find_element(const double T, const double D);
 
 	void get_prop_derivatives(
 		const double T,
@@ -187,6 +187,38 @@ void csp_dispatch_opt::clear_output_arrays()
     outputs.delta_rs.clear();
 }
 
+csp_dispatch_opt::s_lp_model::s_lp_model()
+{
+    lp = NULL;
+    clear();
+}
+
+csp_dispatch_opt::s_lp_model::~s_lp_model()
+{
+    clear();
+}
+
+void csp_dispatch_opt::s_lp_model::clear()
+{
+    if( lp != NULL )
+        delete_lp(lp);
+    lp = NULL;
+    nt = 0;
+    key.clear();
+    rhs.clear();
+    basis.clear();
+    
+    row_wdot0 = row_rec_op0 = row_pb_op0 = row_pb_sb0 = row_tes0 = 0;
+    row_pwr.clear();
+    row_rec_su.clear();
+    row_rec_lim.clear();
+    row_rec_mode.clear();
+    row_rec_avail.clear();
+    row_tes_su.clear();
+    row_wdot_max.clear();
+    row_wnet_max.clear();
+}
+
 bool csp_dispatch_opt::check_setup(int nstep)
 {
     //check parameters and inputs to make sure everything has been set up correctly
@@ -424,876 +456,977 @@ static void calculate_parameters(csp_dispatch_opt *optinst, unordered_map<std::s
         pars["pen_delta_w"] = optinst->params.pen_delta_w; //0.1;
 };
 
-bool csp_dispatch_opt::optimize()
+void csp_dispatch_opt::build_lp_model(optimization_vars &O, unordered_map<std::string, double> &P, int nt)
 {
-
-    //First check to see whether we should call the AMPL engine instead. 
-    if( solver_params.is_ampl_engine )
-    {
-        return optimize_ampl();
-    }
-
     /* 
-    Formulate the optimization problem for dispatch generation. We are trying to maximize revenue subject to inventory
-    constraints.
-    
-    
-    Variables
-    -------------------------------------------------------------
-    Continuous
-    -------------------------------------------------------------
-    xr          kWt     Power delivered by the receiver at time t
-    xrsu        kWt     Power used by the reciever for start up
-    ursu        kWt     Receiver accumulated start-up thermal power at time t
-    x           kWt	    Cycle thermal power consumption at time t 
-    ucsu        kWt     Cycle accumulated start-up thermal power at time t
-    s           kWht    TES reserve quantity at time t (auxiliary variable) 
-    wdot        kWe     Electrical power production at time t
-    delta_w     kWe     Positive change in power production at time t w/r/t t-1
-    -------------------------------------------------------------
-    Binary
-    -------------------------------------------------------------
-    yr              1 if receiver is generating ``usable'' thermal power at time t; 0 otherwise 
-    yrsu            1 if receiver is starting up at time t; 0 otherwise 
-    yrsb            1 if receiver is in standby at time t; 0 otherwise
-    yrsup           1 if reciever startup penalty is enforced at time t; 0 otherwise
-    yrhsp           1 if receiver hot startup penalty is enforced at time t; 0 otherwise
-    y               1 if cycle is generating electric power at time t; 0 otherwise
-    ycsu            1 if cycle is starting up at time t; 0 otherwise
-    ycsb            1 if cycle is in standby mode at time t; 0 otherwise
-    ycsup           1 if cycle startup penalty is enforced at time t; 0 otherwise
-    ychsp           1 if cycle hot startup penalty is enforced at time t; 0 otherwise
-    -------------------------------------------------------------
+    Build the dispatch problem structure for a horizon of nt periods. Coefficients and right-hand sides that 
+    change between windows are set to the current values here and rewritten by optimize() for later windows.
     */
-    lprec *lp;
-    int ret = 0;
-
-
-    try{
-
-        //Calculate the number of variables
-        int nt = (int)m_nstep_opt;
-
-        //set up the variable structure
-        optimization_vars O;
-        O.add_var("xr", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("xrsu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("ursu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("yr", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("yrsu", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        //O.add_var("yrsb", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        //O.add_var("yrsd", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("yrsup", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        //O.add_var("yrhsp", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+    m_lp_model.clear();
 
-        O.add_var("x", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0.);
-        O.add_var("y", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("s", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("ucsu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
-        O.add_var("ycsu", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("ycsb", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-#ifdef MOD_CYCLE_SHUTDOWN
-        O.add_var("ycsd", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-#endif
-        O.add_var("ycsup", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("ychsp", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
-        O.add_var("wdot", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. ); //0 lower bound?
-        O.add_var("delta_w", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. ); 
-        
-        unordered_map<std::string, double> P;
-        calculate_parameters(this, P, nt);
+    int nvar = O.get_total_var_count(); //total number of variables in the problem
 
-        O.construct();  //allocates memory for data array
+    lprec *lp = m_lp_model.lp = make_lp(0, nvar);  //build the context
 
-        int nvar = O.get_total_var_count(); //total number of variables in the problem
+    if(lp == NULL)
+        throw C_csp_exception("Failed to create a new CSP dispatch optimization problem context.");
 
-        lp = make_lp(0, nvar);  //build the context
+    //set variable names and types for each column
+    for(int i=0; i<O.get_num_varobjs(); i++)
+    {
+        optimization_vars::opt_var *v = O.get_var(i);
 
-        if(lp == NULL)
-            throw C_csp_exception("Failed to create a new CSP dispatch optimization problem context.");
+        string name_base = v->name;
 
-        //set variable names and types for each column
-        for(int i=0; i<O.get_num_varobjs(); i++)
+        if( v->var_dim == optimization_vars::VAR_DIM::DIM_T )
         {
-            optimization_vars::opt_var *v = O.get_var(i);
-
-            string name_base = v->name;
-
-            if( v->var_dim == optimization_vars::VAR_DIM::DIM_T )
+            for(int t=0; t<nt; t++)
             {
-                for(int t=0; t<nt; t++)
-                {
-                    char s[40];
-                    sprintf(s, "%s-%d", name_base.c_str(), t);
-                    set_col_name(lp, O.column(i, t), s);
-                    
-                }
+                char s[40];
+                sprintf(s, "%s-%d", name_base.c_str(), t);
+                set_col_name(lp, O.column(i, t), s);
+                
             }
-            else if( v->var_dim == optimization_vars::VAR_DIM::DIM_NT ) 
+        }
+        else if( v->var_dim == optimization_vars::VAR_DIM::DIM_NT ) 
+        {
+            for(int t1=0; t1<v->var_dim_size; t1++)
             {
-                for(int t1=0; t1<v->var_dim_size; t1++)
+                for(int t2=0; t2<v->var_dim_size2; t2++)
                 {
-                    for(int t2=0; t2<v->var_dim_size2; t2++)
-                    {
-                        char s[40];
-                        sprintf(s, "%s-%d-%d", name_base.c_str(), t1, t2);
-                        set_col_name(lp, O.column(i, t1,t2 ), s);
-                    }
+                    char s[40];
+                    sprintf(s, "%s-%d-%d", name_base.c_str(), t1, t2);
+                    set_col_name(lp, O.column(i, t1,t2 ), s);
                 }
             }
-            else
+        }
+        else
+        {
+            for(int t1=0; t1<nt; t1++)
             {
-                for(int t1=0; t1<nt; t1++)
+                for(int t2=t1; t2<nt; t2++)
                 {
-                    for(int t2=t1; t2<nt; t2++)
-                    {
-                        char s[40];
-                        sprintf(s, "%s-%d-%d", name_base.c_str(), t1, t2);
-                        set_col_name(lp, O.column(i, t1, t2 ), s);
-                    }
+                    char s[40];
+                    sprintf(s, "%s-%d-%d", name_base.c_str(), t1, t2);
+                    set_col_name(lp, O.column(i, t1, t2 ), s);
                 }
             }
         }
+    }
 
-        /* 
-        --------------------------------------------------------------------------------
-        set up the objective function first (per lpsolve guidance)
-        --------------------------------------------------------------------------------
-        */
-		{
-            int *col = new int[12 * nt];
-            REAL *row = new REAL[12 * nt];
-            double tadj = P["disp_time_weighting"];
-            int i = 0;
+    m_lp_model.row_pwr.resize(nt, 0);
+    m_lp_model.row_rec_su.resize(nt, 0);
+    m_lp_model.row_rec_lim.resize(nt, 0);
+    m_lp_model.row_rec_mode.resize(nt, 0);
+    m_lp_model.row_rec_avail.resize(nt, 0);
+    m_lp_model.row_tes_su.resize(nt, 0);
+    m_lp_model.row_wdot_max.resize(nt, 0);
+    m_lp_model.row_wnet_max.resize(nt, 0);
 
-            //calculate the mean price to appropriately weight the receiver production timing derate
-            double pmean =0;
-            for(int t=0; t<(int)price_signal.size(); t++)
-                pmean += price_signal.at(t);
-            pmean /= (double)price_signal.size();
-            //--
-            
-            for(int t=0; t<nt; t++)
-            {
-                i = 0;
-                col[ t + nt*(i  ) ] = O.column("wdot", t);
-                row[ t + nt*(i++) ] = P["delta"] * price_signal.at(t)*tadj*(1.-outputs.w_condf_expected.at(t));
+    //set the row mode
+    set_add_rowmode(lp, TRUE);
 
-                col[ t + nt*(i  ) ] = O.column("xr", t);
-                row[ t + nt*(i++) ] = -(P["delta"] * price_signal.at(t) * P["Lr"])+tadj*pmean;  // tadj added to prefer receiver production sooner (i.e. delay dumping)
+    /* 
+    --------------------------------------------------------------------------------
+    set up the variable properties
+    --------------------------------------------------------------------------------
+    */
+    for(int i=0; i<O.get_num_varobjs(); i++)
+    {
+        optimization_vars::opt_var *v = O.get_var(i);
+        if( v->var_type == optimization_vars::VAR_TYPE::BINARY_T )
+        {
+            for(int i=v->ind_start; i<v->ind_end; i++)
+                set_binary(lp, i+1, TRUE);
+        }
+        //upper and lower variable bounds
+        for(int i=v->ind_start; i<v->ind_end; i++)
+        {
+            set_upbo(lp, i+1, v->upper_bound);
+            set_lowbo(lp, i+1, v->lower_bound);
+        }
+    }
 
-                col[ t + nt*(i  ) ] = O.column("xrsu", t);
-                row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * P["Lr"];
 
-                col[ t + nt*(i  ) ] = O.column("yrsu", t);
-                row[ t + nt*(i++) ] = -price_signal.at(t) * (params.w_rec_ht + params.w_stow);
+    /* 
+    --------------------------------------------------------------------------------
+    set up the constraints
+    --------------------------------------------------------------------------------
+    */
+    //cycle production change
+    {
+        REAL row[3];
+        int col[3];
+        
+        for(int t=0; t<nt; t++)
+        {
+            col[0] = O.column("delta_w", t);
+            row[0] = 1.;
 
-                col[ t + nt*(i  ) ] = O.column("yr", t);
-                row[ t + nt*(i++) ] = -(P["delta"] * price_signal.at(t) * params.w_track) + tadj;	// tadj added to prefer receiver operation in nearer term to longer term
+            col[1] = O.column("wdot", t);
+            row[1] = -1.;
 
-                col[ t + nt*(i  ) ] = O.column("x", t);
-                row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * params.w_cycle_pump;
+            if(t>0)
+            {
+                col[2] = O.column("wdot", t-1);
+                row[2] = 1.;
+                
+                add_constraintex(lp, 3, row, col, GE, 0.);
+            }
+            else
+            {
+                add_constraintex(lp, 2, row, col, GE, -P["Wdot0"]);
+                m_lp_model.row_wdot0 = get_Nrows(lp);
+            }
+        }
+    }
 
-                col[ t + nt*(i  ) ] = O.column("ycsb", t);
-                row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * params.w_cycle_standby;
 
-                //xxcol[ t + nt*(i   ] = O.column("yrsb", t);
-                //xxrow[ t + nt*(i++) ] = -delta * price_signal.at(t) * (Lr * Qrl + (params.w_stow / delta));
+    
+    {
+        //Linearization of the implementation of the piecewise efficiency equation 
+        REAL row[3];
+        int col[3];
 
-                //xxcol[ t + nt*(i   ] = O.column("yrsd", t);
-                //xxrow[ t + nt*(i++) ] = -0.5 - (params.w_stow);
+        for(int t=0; t<nt; t++)
+        {
+            int i=0;
+            //power production curve
+            row[i  ] = 1.;
+            col[i++] = O.column("wdot", t);
 
-                //xxcol[ t + nt*(i   ] = O.column("ycsd", t);
-                //xxrow[ t + nt*(i++) ] = -0.5;
+            row[i  ] = -P["etap"]*outputs.eta_pb_expected.at(t)/params.eta_cycle_ref;
+            col[i++] = O.column("x", t);
 
-                col[ t + nt*(i  ) ] = O.column("yrsup", t);
-                row[ t + nt*(i++) ] = -P["rsu_cost"]*tadj;
+            row[i  ] = -(P["Wdotu"] - P["etap"]*P["Qu"])*outputs.eta_pb_expected.at(t)/params.eta_cycle_ref;
+            col[i++] = O.column("y", t);
 
-                //xxcol[ t + nt*(i   ] = O.column("yrhsp", t);
-                //xxrow[ t + nt*(i++) ] = -tadj;
+            //row[i  ] = -outputs.eta_pb_expected.at(t);
+            //col[i++] = O.column("x", t);
 
-                col[ t + nt*(i  ) ] = O.column("ycsup", t);
-                row[ t + nt*(i++) ] = -P["csu_cost"]*tadj;
+            add_constraintex(lp, i, row, col, EQ, 0.);
+            m_lp_model.row_pwr.at(t) = get_Nrows(lp);
 
-                col[ t + nt*(i  ) ] = O.column("ychsp", t);
-                row[ t + nt*(i++) ] = -P["csu_cost"]*tadj * 0.1;
+        }
+    }
 
-                col[ t + nt*(i  ) ] = O.column("delta_w", t);
-                row[ t + nt*(i++) ] = -P["pen_delta_w"]*tadj;
+    // ******************** Receiver constraints *******************
+    //{ //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+    //    REAL row[5];
+    //    int col[5];
 
-                tadj *= P["disp_time_weighting"];
-            }
+    //    for(int t=0; t<nt; t++)
+    //    {
+    //        int i=0; 
+    //        row[i  ] = qrecmaxobs*1.01;
+    //        col[i++] = O.column("yd", t);
 
-            set_obj_fnex(lp, i*nt, row, col);
+    //        row[i  ] = 1.;
+    //        col[i++] = O.column("xr", t);
 
-            delete[] col;
-            delete[] row;
-        }
+    //        row[i  ] = 1.;
+    //        col[i++] = O.column("xrsu", t);
 
-        //set the row mode
-        set_add_rowmode(lp, TRUE);
+    //        add_constraintex(lp, i, row, col, GE, outputs.q_sfavail_expected.at(t)*0.999 );
+    //    }
+    //} //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
 
-        /* 
-        --------------------------------------------------------------------------------
-        set up the variable properties
-        --------------------------------------------------------------------------------
-        */
-        for(int i=0; i<O.get_num_varobjs(); i++)
+
+    {
+        REAL row[5];
+        int col[5];
+
+        for(int t=0; t<nt; t++)
         {
-            optimization_vars::opt_var *v = O.get_var(i);
-            if( v->var_type == optimization_vars::VAR_TYPE::BINARY_T )
+
+            //Receiver startup inventory
+            row[0] = 1.;
+            col[0] = O.column("ursu", t);
+
+            row[1] = -P["delta"];
+            col[1] = O.column("xrsu", t);
+
+            if(t>0)
             {
-                for(int i=v->ind_start; i<v->ind_end; i++)
-                    set_binary(lp, i+1, TRUE);
+                row[2] = -1.;
+                col[2] = O.column("ursu", t-1);
+
+                add_constraintex(lp, 3, row, col, LE, 0);
             }
-            //upper and lower variable bounds
-            for(int i=v->ind_start; i<v->ind_end; i++)
+            else
             {
-                set_upbo(lp, i+1, v->upper_bound);
-                set_lowbo(lp, i+1, v->lower_bound);
+                add_constraintex(lp, 2, row, col, LE, 0.);
             }
-        }
 
+            //-----
 
-        /* 
-        --------------------------------------------------------------------------------
-        set up the constraints
-        --------------------------------------------------------------------------------
-        */
-        //cycle production change
-        {
-            REAL row[3];
-            int col[3];
+            //inventory nonzero
+            row[0] = 1.;
+            col[0] = O.column("ursu", t);
+
+            row[1] = -P["Er"];
+            col[1] = O.column("yrsu", t);
+
+            add_constraintex(lp, 2, row, col, LE, 0.);
+
+            //Receiver operation allowed when:
+            row[0] = 1.;
+            col[0] = O.column("yr", t);
             
-            for(int t=0; t<nt; t++)
+            row[1] = -1.0/P["Er"]; 
+            col[1] = O.column("ursu", t);
+
+            if(t>0)
+            {
+                row[2] = -1.;
+                col[2] = O.column("yr", t-1);
+
+                add_constraintex(lp, 3, row, col, LE, 0.); 
+            }
+            else
+            {
+                add_constraintex(lp, 2, row, col, LE, (params.is_rec_operating0 ? 1. : 0.) );
+                m_lp_model.row_rec_op0 = get_Nrows(lp);
+            }
+
+            //Receiver startup can't be enabled after a time step where the Receiver was operating
+            if(t>0)
             {
-                col[0] = O.column("delta_w", t);
                 row[0] = 1.;
+                col[0] = O.column("yrsu", t);
 
-                col[1] = O.column("wdot", t);
-                row[1] = -1.;
+                row[1] = 1.;
+                col[1] = O.column("yr", t-1);
 
-                if(t>0)
-                {
-                    col[2] = O.column("wdot", t-1);
-                    row[2] = 1.;
-                    
-                    add_constraintex(lp, 3, row, col, GE, 0.);
-                }
-                else
-                {
-                    add_constraintex(lp, 2, row, col, GE, -P["Wdot0"]);
-                }
+                add_constraintex(lp, 2, row, col, LE, 1.);
             }
-        }
 
+            //Receiver startup energy consumption
+            row[0] = 1.;
+            col[0] = O.column("xrsu", t);
 
-        
-        {
-            //Linearization of the implementation of the piecewise efficiency equation 
-            REAL row[3];
-            int col[3];
+            row[1] = -P["Qru"];
+            col[1] = O.column("yrsu", t);
 
-            for(int t=0; t<nt; t++)
-            {
-                int i=0;
-                //power production curve
-                row[i  ] = 1.;
-                col[i++] = O.column("wdot", t);
+            add_constraintex(lp, 2, row, col, LE, 0.);
 
-                row[i  ] = -P["etap"]*outputs.eta_pb_expected.at(t)/params.eta_cycle_ref;
-                col[i++] = O.column("x", t);
+            //Receiver startup only during solar positive periods
+            row[0] = 1.;
+            col[0] = O.column("yrsu", t);
 
-                row[i  ] = -(P["Wdotu"] - P["etap"]*P["Qu"])*outputs.eta_pb_expected.at(t)/params.eta_cycle_ref;
-                col[i++] = O.column("y", t);
+            add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );
+            m_lp_model.row_rec_su.at(t) = get_Nrows(lp);
 
-                //row[i  ] = -outputs.eta_pb_expected.at(t);
-                //col[i++] = O.column("x", t);
+            //Receiver consumption limit
+            row[0] = 1.;
+            col[0] = O.column("xr", t);
 
-                add_constraintex(lp, i, row, col, EQ, 0.);
+            row[1] = 1.;
+            col[1] = O.column("xrsu", t);
+            
+            add_constraintex(lp, 2, row, col, LE, outputs.q_sfavail_expected.at(t));
+            m_lp_model.row_rec_lim.at(t) = get_Nrows(lp);
 
-            }
-        }
+            //Receiver operation mode requirement
+            row[0] = 1.;
+            col[0] = O.column("xr", t);
 
-        // ******************** Receiver constraints *******************
-        //{ //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
-        //    REAL row[5];
-        //    int col[5];
+            row[1] = -outputs.q_sfavail_expected.at(t);
+            col[1] = O.column("yr", t);
 
-        //    for(int t=0; t<nt; t++)
-        //    {
-        //        int i=0; 
-        //        row[i  ] = qrecmaxobs*1.01;
-        //        col[i++] = O.column("yd", t);
+            add_constraintex(lp, 2, row, col, LE, 0.);
+            m_lp_model.row_rec_mode.at(t) = get_Nrows(lp);
 
-        //        row[i  ] = 1.;
-        //        col[i++] = O.column("xr", t);
+            //Receiver minimum operation requirement
+            row[0] = 1.;
+            col[0] = O.column("xr", t);
 
-        //        row[i  ] = 1.;
-        //        col[i++] = O.column("xrsu", t);
+            row[1] = -P["Qrl"];
+            col[1] = O.column("yr", t);
 
-        //        add_constraintex(lp, i, row, col, GE, outputs.q_sfavail_expected.at(t)*0.999 );
-        //    }
-        //} //<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<
+            add_constraintex(lp, 2, row, col, GE, 0.);
 
+            //Receiver can't continue operating when no energy is available
+            row[0] = 1.;
+            col[0] = O.column("yr", t);
 
-        {
-            REAL row[5];
-            int col[5];
+            add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );  //if any measurable energy, y^r can be 1
+            m_lp_model.row_rec_avail.at(t) = get_Nrows(lp);
 
-            for(int t=0; t<nt; t++)
-            {
+            // --- new constraints ---
 
-                //Receiver startup inventory
-                row[0] = 1.;
-                col[0] = O.column("ursu", t);
+            //receiver startup/standby persist
+            /*row[0] = 1.;
+            col[0] = O.column("yrsu", t);
 
-                row[1] = -P["delta"];
-                col[1] = O.column("xrsu", t);
+            row[1] = 1.;
+            col[1] = O.column("yrsb", t);
 
-                if(t>0)
-                {
-                    row[2] = -1.;
-                    col[2] = O.column("ursu", t-1);
+            add_constraintex(lp, 2, row, col, LE, 1.);*/
 
-                    add_constraintex(lp, 3, row, col, LE, 0);
-                }
-                else
-                {
-                    add_constraintex(lp, 2, row, col, LE, 0.);
-                }
+            //recever standby partition
+            /*row[0] = 1.;
+            col[0] = O.column("yr", t);
+
+            row[1] = 1.;
+            col[1] = O.column("yrsb", t);
+
+            add_constraintex(lp, 2, row, col, LE, 1.);*/
 
-                //-----
+            if( t > 0 )
+            {
+                //rsb_persist
+                /*row[0] = 1.;
+                col[0] = O.column("yrsb", t);
+
+                row[1] = -1.;
+                col[1] = O.column("yr", t-1);
+
+                row[2] = -1.;
+                col[2] = O.column("yrsb", t-1);
+
+                add_constraintex(lp, 3, row, col, LE, 0.);*/
 
-                //inventory nonzero
+                //receiver startup penalty
                 row[0] = 1.;
-                col[0] = O.column("ursu", t);
+                col[0] = O.column("yrsup", t);
 
-                row[1] = -P["Er"];
+                row[1] = -1.;
                 col[1] = O.column("yrsu", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                row[2] = 1.;
+                col[2] = O.column("yrsu", t-1);
 
-                //Receiver operation allowed when:
-                row[0] = 1.;
-                col[0] = O.column("yr", t);
-                
-                row[1] = -1.0/P["Er"]; 
-                col[1] = O.column("ursu", t);
+                add_constraintex(lp, 3, row, col, GE, 0.);
 
-                if(t>0)
-                {
-                    row[2] = -1.;
-                    col[2] = O.column("yr", t-1);
+                //receiver hot startup penalty
+                /*row[0] = 1.;
+                col[0] = O.column("yrhsp", t);
 
-                    add_constraintex(lp, 3, row, col, LE, 0.); 
-                }
-                else
-                {
-                    add_constraintex(lp, 2, row, col, LE, (params.is_rec_operating0 ? 1. : 0.) );
-                }
+                row[1] = -1.;
+                col[1] = O.column("yr", t);
 
-                //Receiver startup can't be enabled after a time step where the Receiver was operating
-                if(t>0)
-                {
-                    row[0] = 1.;
-                    col[0] = O.column("yrsu", t);
+                row[2] = -1.;
+                col[2] = O.column("yrsb", t-1);
 
-                    row[1] = 1.;
-                    col[1] = O.column("yr", t-1);
+                add_constraintex(lp, 3, row, col, GE, -1);*/
 
-                    add_constraintex(lp, 2, row, col, LE, 1.);
-                }
+                //receiver shutdown energy
+                /*row[0] = 1.;
+                col[0] = O.column("yrsd", t-1);
 
-                //Receiver startup energy consumption
-                row[0] = 1.;
-                col[0] = O.column("xrsu", t);
+                row[1] = -1.;
+                col[1] = O.column("yr", t-1);
 
-                row[1] = -P["Qru"];
-                col[1] = O.column("yrsu", t);
+                row[2] = 1.;
+                col[2] = O.column("yr", t);
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+                row[3] = -1.;
+                col[3] = O.column("yrsb", t-1);
 
-                //Receiver startup only during solar positive periods
-                row[0] = 1.;
-                col[0] = O.column("yrsu", t);
+                row[4] = 1.;
+                col[4] = O.column("yrsb", t);
 
-                add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );
+                add_constraintex(lp, 5, row, col, GE, 0.);*/
 
-                //Receiver consumption limit
-                row[0] = 1.;
-                col[0] = O.column("xr", t);
+            }
+        }
+    }
 
-                row[1] = 1.;
-                col[1] = O.column("xrsu", t);
-                
-                add_constraintex(lp, 2, row, col, LE, outputs.q_sfavail_expected.at(t));
+    
+    // ******************** Power cycle constraints *******************
+    {
+        REAL row[5];
+        int col[5];
 
-                //Receiver operation mode requirement
-                row[0] = 1.;
-                col[0] = O.column("xr", t);
 
-                row[1] = -outputs.q_sfavail_expected.at(t);
-                col[1] = O.column("yr", t);
+        for(int t=0; t<nt; t++)
+        {
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+            int i=0;
+            //Startup Inventory balance
+            row[i  ] = 1.;
+            col[i++] = O.column("ucsu", t);
+            
+            row[i  ] = -P["delta"] * P["Qc"];
+            col[i++] = O.column("ycsu", t);
 
-                //Receiver minimum operation requirement
-                row[0] = 1.;
-                col[0] = O.column("xr", t);
+            if(t>0)
+            {
+                row[i  ] = -1.;
+                col[i++] = O.column("ucsu", t-1);
+            }
 
-                row[1] = -P["Qrl"];
-                col[1] = O.column("yr", t);
+            add_constraintex(lp, i, row, col, LE, 0.);
 
-                add_constraintex(lp, 2, row, col, GE, 0.);
+            //Inventory nonzero
+            row[0] = 1.;
+            col[0] = O.column("ucsu", t);
 
-                //Receiver can't continue operating when no energy is available
-                row[0] = 1.;
-                col[0] = O.column("yr", t);
+            row[1] = -P["M"];
+            col[1] = O.column("ycsu", t);
 
-                add_constraintex(lp, 1, row, col, LE, min(P["M"]*outputs.q_sfavail_expected.at(t), 1.0) );  //if any measurable energy, y^r can be 1
+            add_constraintex(lp, 2, row, col, LE, 0.);
 
-                // --- new constraints ---
+            //Cycle operation allowed when:
+            i=0;
+            row[i  ] = 1.;
+            col[i++] = O.column("y", t);
+            
+            row[i  ] = -1.0/P["Ec"]; 
+            col[i++] = O.column("ucsu", t);
 
-                //receiver startup/standby persist
-                /*row[0] = 1.;
-                col[0] = O.column("yrsu", t);
+            if(t>0)
+            {
+                row[i  ] = -1.;
+                col[i++] = O.column("y", t-1);
 
-                row[1] = 1.;
-                col[1] = O.column("yrsb", t);
+                row[i  ] = -1.;
+                col[i++] = O.column("ycsb", t-1);
+
+                add_constraintex(lp, i, row, col, LE, 0.); 
+            }
+            else
+            {
+                add_constraintex(lp, i, row, col, LE, (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.) );
+                m_lp_model.row_pb_op0 = get_Nrows(lp);
+            }
 
-                add_constraintex(lp, 2, row, col, LE, 1.);*/
+            //Cycle consumption limit
+            i=0;
+            row[i  ] = 1.;
+            col[i++] = O.column("x", t);
 
-                //recever standby partition
-                /*row[0] = 1.;
-                col[0] = O.column("yr", t);
+            //mjw 2016.12.2 --> This constraint seems to be problematic in identifying feasible solutions for subhourly runs. Needs attention.
+            row[i  ] = P["Qc"];
+            col[i++] = O.column("ycsu", t);
+            
+            row[i  ] = -P["Qu"];
+            col[i++] = O.column("y", t);
+
+            add_constraintex(lp, i, row, col, LE, 0.);
+
+            //cycle operation mode requirement
+            row[0] = 1.;
+            col[0] = O.column("x", t);
+
+            row[1] = -P["Qu"];
+            col[1] = O.column("y", t);
+
+            add_constraintex(lp, 2, row, col, LE, 0.);
+
+            //Minimum cycle energy contribution
+            i=0;
+            row[i  ] = 1.;
+            col[i++] = O.column("x", t);
+
+            row[i  ] = -P["Ql"];
+            col[i++] = O.column("y", t);
+
+            add_constraintex(lp, i, row, col, GE, 0);
+
+            //cycle startup can't be enabled after a time step where the cycle was operating
+            if(t>0)
+            {
+                row[0] = 1.;
+                col[0] = O.column("ycsu", t);
 
                 row[1] = 1.;
-                col[1] = O.column("yrsb", t);
+                col[1] = O.column("y", t-1);
 
-                add_constraintex(lp, 2, row, col, LE, 1.);*/
+                add_constraintex(lp, 2, row, col, LE, 1.);
+            }
 
-                if( t > 0 )
-                {
-                    //rsb_persist
-                    /*row[0] = 1.;
-                    col[0] = O.column("yrsb", t);
 
-                    row[1] = -1.;
-                    col[1] = O.column("yr", t-1);
+            //Standby mode entry
+            i=0;
+            row[i  ] = 1.;
+            col[i++] = O.column("ycsb", t);
+
+            if(t>0)
+            {
+                row[i  ] = -1.;
+                col[i++] = O.column("y", t-1);
+
+                row[i  ] = -1.;
+                col[i++] = O.column("ycsb", t-1);
 
-                    row[2] = -1.;
-                    col[2] = O.column("yrsb", t-1);
+                add_constraintex(lp, i, row, col, LE, 0);
+            }
+            else
+            {
+                add_constraintex(lp, i, row, col, LE, (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0));
+                m_lp_model.row_pb_sb0 = get_Nrows(lp);
+            }
 
-                    add_constraintex(lp, 3, row, col, LE, 0.);*/
+            //some modes can't coincide
+            row[0] = 1.;
+            col[0] = O.column("ycsu", t);
+            row[1] = 1.;
+            col[1] = O.column("ycsb", t);    
 
-                    //receiver startup penalty
-                    row[0] = 1.;
-                    col[0] = O.column("yrsup", t);
+            add_constraintex(lp, 2, row, col, LE, 1);   
 
-                    row[1] = -1.;
-                    col[1] = O.column("yrsu", t);
+            row[0] = 1.;
+            col[0] = O.column("y", t);
+            row[1] = 1.;
+            col[1] = O.column("ycsb", t);    
 
-                    row[2] = 1.;
-                    col[2] = O.column("yrsu", t-1);
+            add_constraintex(lp, 2, row, col, LE, 1);   
 
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+            if( t > 0 )
+            {
+                //cycle start penalty
+                row[0] = 1.;
+                col[0] = O.column("ycsup", t);
 
-                    //receiver hot startup penalty
-                    /*row[0] = 1.;
-                    col[0] = O.column("yrhsp", t);
+                row[1] = -1.;
+                col[1] = O.column("ycsu", t);
 
-                    row[1] = -1.;
-                    col[1] = O.column("yr", t);
+                row[2] = 1.;
+                col[2] = O.column("ycsu", t-1);
 
-                    row[2] = -1.;
-                    col[2] = O.column("yrsb", t-1);
+                add_constraintex(lp, 3, row, col, GE, 0.);
 
-                    add_constraintex(lp, 3, row, col, GE, -1);*/
+                //cycle standby start penalty
+                row[0] = 1.;
+                col[0] = O.column("ychsp", t);
 
-                    //receiver shutdown energy
-                    /*row[0] = 1.;
-                    col[0] = O.column("yrsd", t-1);
+                row[1] = -1.;
+                col[1] = O.column("y", t);
 
-                    row[1] = -1.;
-                    col[1] = O.column("yr", t-1);
+                row[2] = -1.;
+                col[2] = O.column("ycsb", t-1);
 
-                    row[2] = 1.;
-                    col[2] = O.column("yr", t);
+                add_constraintex(lp, 3, row, col, GE, -1.);
 
-                    row[3] = -1.;
-                    col[3] = O.column("yrsb", t-1);
+#ifdef MOD_CYCLE_SHUTDOWN
+                //cycle shutdown energy penalty
+                row[0] = 1.;
+                col[0] = O.column("ycsd", t-1);
 
-                    row[4] = 1.;
-                    col[4] = O.column("yrsb", t);
+                row[1] = -1.;
+                col[1] = O.column("y", t-1);
+                
+                row[2] = 1.;
+                col[2] = O.column("y", t);
+                
+                row[3] = -1.;
+                col[3] = O.column("ycsb", t-1);
+                
+                row[4] = 1.;
+                col[4] = O.column("ycsb", t);
 
-                    add_constraintex(lp, 5, row, col, GE, 0.);*/
+                add_constraintex(lp, 5, row, col, GE, 0.);
+#endif
 
-                }
             }
         }
+    }
+
 
-        
-        // ******************** Power cycle constraints *******************
-        {
-            REAL row[5];
-            int col[5];
+    // ******************** Balance constraints *******************
+    //Energy in, out, and stored in the TES system must balance.
+    {
+        REAL row[7];
+        int col[7];
 
+        for(int t=0; t<nt; t++)
+        {
+            int i=0;
 
-            for(int t=0; t<nt; t++)
+            row[i  ] = P["delta"];
+            col[i++] = O.column("xr", t);
+            
+            row[i  ] = -P["delta"]*P["Qc"];
+            col[i++] = O.column("ycsu", t);
+            
+            row[i  ] = -P["delta"]*P["Qb"]; 
+            col[i++] = O.column("ycsb", t);
+            
+            row[i  ] = -P["delta"];
+            col[i++] = O.column("x", t);
+#ifdef MOD_REC_STANDBY                
+            row[i  ] = -delta*Qrsb;
+            col[i++] = O.column("yrsb", t);
+#endif
+            
+            row[i  ] = -1.;
+            col[i++] = O.column("s", t);
+            
+            if(t>0)
             {
-
-                int i=0;
-                //Startup Inventory balance
                 row[i  ] = 1.;
-                col[i++] = O.column("ucsu", t);
-                
-                row[i  ] = -P["delta"] * P["Qc"];
-                col[i++] = O.column("ycsu", t);
+                col[i++] = O.column("s", t-1);
 
-                if(t>0)
-                {
-                    row[i  ] = -1.;
-                    col[i++] = O.column("ucsu", t-1);
-                }
+                add_constraintex(lp, i, row, col, EQ, 0.);
+            }
+            else
+            {
+                add_constraintex(lp, i, row, col, EQ, -P["s0"]);  //initial storage state (kWh)
+                m_lp_model.row_tes0 = get_Nrows(lp);
+            }
+        }
+    }
+    
+    //Energy in storage must be within limits
+    {
+        REAL row[8];
+        int col[8];
 
-                add_constraintex(lp, i, row, col, LE, 0.);
+        for(int t=0; t<nt; t++)
+        {
+            
+            row[0] = 1.;
+            col[0] = O.column("s", t);
 
-                //Inventory nonzero
-                row[0] = 1.;
-                col[0] = O.column("ucsu", t);
+            add_constraintex(lp, 1, row, col, LE, P["Eu"]);
 
-                row[1] = -P["M"];
-                col[1] = O.column("ycsu", t);
+			//max cycle thermal input in time periods where cycle operates and receiver is starting up
+            //outputs.delta_rs.resize(nt);
+			if (t < nt - 1)
+			{
+				/*double delta_rec_startup = min(1., max(params.e_rec_startup / max(outputs.q_sfavail_expected.at(t + 1)*P["delta"], 1.), params.dt_rec_startup / P["delta"]));
+                outputs.delta_rs.at(t) = delta_rec_startup;*/
+				double t_rec_startup = outputs.delta_rs.at(t) * P["delta"];
+				double large = 5.0*params.q_pb_max;
+				int i = 0;
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+				row[i] = 1.;
+				col[i++] = O.column("x", t + 1);
 
-                //Cycle operation allowed when:
-                i=0;
-                row[i  ] = 1.;
-                col[i++] = O.column("y", t);
-                
-                row[i  ] = -1.0/P["Ec"]; 
-                col[i++] = O.column("ucsu", t);
+				row[i] = params.q_pb_standby + large;
+				col[i++] = O.column("ycsb", t + 1);
 
-                if(t>0)
-                {
-                    row[i  ] = -1.;
-                    col[i++] = O.column("y", t-1);
+				row[i] = -1. / t_rec_startup;
+				col[i++] = O.column("s", t);
 
-                    row[i  ] = -1.;
-                    col[i++] = O.column("ycsb", t-1);
+				row[i] = large;
+				col[i++] = O.column("yrsu", t + 1);
 
-                    add_constraintex(lp, i, row, col, LE, 0.); 
-                }
-                else
-                {
-                    add_constraintex(lp, i, row, col, LE, (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.) );
-                }
+				row[i] = large;
+				col[i++] = O.column("y", t + 1);
 
-                //Cycle consumption limit
-                i=0;
-                row[i  ] = 1.;
-                col[i++] = O.column("x", t);
+				row[i] = large;
+				col[i++] = O.column("y", t);
 
-                //mjw 2016.12.2 --> This constraint seems to be problematic in identifying feasible solutions for subhourly runs. Needs attention.
-                row[i  ] = P["Qc"];
-                col[i++] = O.column("ycsu", t);
-                
-                row[i  ] = -P["Qu"];
-                col[i++] = O.column("y", t);
+				row[i] = large;
+				col[i++] = O.column("ycsb", t);
 
-                add_constraintex(lp, i, row, col, LE, 0.);
+				add_constraintex(lp, i, row, col, LE, 3.0*large);
+				m_lp_model.row_tes_su.at(t) = get_Nrows(lp);
+			}
 
-                //cycle operation mode requirement
-                row[0] = 1.;
-                col[0] = O.column("x", t);
+        }
+    }
 
-                row[1] = -P["Qu"];
-                col[1] = O.column("y", t);
+    // Maximum gross electricity production constraint
+    {
+        REAL row[1];
+        int col[1];
 
-                add_constraintex(lp, 2, row, col, LE, 0.);
+        for( int t = 0; t<nt; t++ )
+        {
+            row[0] = 1.;
+            col[0] = O.column("wdot", t);
 
-                //Minimum cycle energy contribution
-                i=0;
-                row[i  ] = 1.;
-                col[i++] = O.column("x", t);
+			add_constraintex(lp, 1, row, col, LE, outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"]);
+			m_lp_model.row_wdot_max.at(t) = get_Nrows(lp);
+        }
+    }
 
-                row[i  ] = -P["Ql"];
-                col[i++] = O.column("y", t);
+	// Maximum net electricity production constraint
+	{
+		REAL row[9];
+		int col[9];
 
-                add_constraintex(lp, i, row, col, GE, 0);
+		//Where cycle operation is impossible (w_lim = 0), optimize() holds wdot at zero through its upper bound, 
+		//so the row keeps the same form in every window.
+		for (int t = 0; t<nt; t++)
+		{
+			int i = 0;
 
-                //cycle startup can't be enabled after a time step where the cycle was operating
-                if(t>0)
-                {
-                    row[0] = 1.;
-                    col[0] = O.column("ycsu", t);
+			row[i] = 1.0-outputs.w_condf_expected.at(t);
+			col[i++] = O.column("wdot", t);
 
-                    row[1] = 1.;
-                    col[1] = O.column("y", t-1);
+			row[i] = -params.w_rec_pump;
+			col[i++] = O.column("xr", t);
 
-                    add_constraintex(lp, 2, row, col, LE, 1.);
-                }
+			row[i] = -params.w_rec_pump;
+			col[i++] = O.column("xrsu", t);
 
+			row[i] = -(params.w_rec_ht / params.dt) - (params.w_stow / params.dt);	//kWe
+			col[i++] = O.column("yrsu", t);
 
-                //Standby mode entry
-                i=0;
-                row[i  ] = 1.;
-                col[i++] = O.column("ycsb", t);
+			row[i] = -params.w_track;
+			col[i++] = O.column("yr", t);
 
-                if(t>0)
-                {
-                    row[i  ] = -1.;
-                    col[i++] = O.column("y", t-1);
+			row[i] = -params.w_cycle_standby;
+			col[i++] = O.column("ycsb", t);
 
-                    row[i  ] = -1.;
-                    col[i++] = O.column("ycsb", t-1);
+			row[i] = -params.w_cycle_pump;
+			col[i++] = O.column("x", t);
 
-                    add_constraintex(lp, i, row, col, LE, 0);
-                }
-                else
-                {
-                    add_constraintex(lp, i, row, col, LE, (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0));
-                }
+			//row[i] = -(params.w_rec_pump*params.q_rec_min) - (params.w_stow / params.dt); //kWe
+			//col[i++] = O.column("yrsb", t);
+			//row[i] - params.w_stow / params.dt;	//kWe
+			//col[i++] = O.column("yrsd", t);
 
-                //some modes can't coincide
-                row[0] = 1.;
-                col[0] = O.column("ycsu", t);
-                row[1] = 1.;
-                col[1] = O.column("ycsb", t);    
+			add_constraintex(lp, 7, row, col, LE, w_lim.at(t));
+			m_lp_model.row_wnet_max.at(t) = get_Nrows(lp);
+		}
+	}
 
-                add_constraintex(lp, 2, row, col, LE, 1);   
+    
+    //Set problem to maximize
+    set_maxim(lp);
 
-                row[0] = 1.;
-                col[0] = O.column("y", t);
-                row[1] = 1.;
-                col[1] = O.column("ycsb", t);    
+    //reset the row mode
+    set_add_rowmode(lp, FALSE);
 
-                add_constraintex(lp, 2, row, col, LE, 1);   
+    //keep the right-hand side so later windows can replace it in one call
+    int nrows = get_Nrows(lp);
+    m_lp_model.rhs.resize(nrows + 1, 0.);
+    for(int r=1; r<=nrows; r++)
+        m_lp_model.rhs.at(r) = get_rh(lp, r);
 
-                if( t > 0 )
-                {
-                    //cycle start penalty
-                    row[0] = 1.;
-                    col[0] = O.column("ycsup", t);
+    m_lp_model.nt = nt;
+}
 
-                    row[1] = -1.;
-                    col[1] = O.column("ycsu", t);
+bool csp_dispatch_opt::optimize()
+{
 
-                    row[2] = 1.;
-                    col[2] = O.column("ycsu", t-1);
+    //First check to see whether we should call the AMPL engine instead. 
+    if( solver_params.is_ampl_engine )
+    {
+        return optimize_ampl();
+    }
 
-                    add_constraintex(lp, 3, row, col, GE, 0.);
+    /* 
+    Formulate the optimization problem for dispatch generation. We are trying to maximize revenue subject to inventory
+    constraints.
+    
+    
+    Variables
+    -------------------------------------------------------------
+    Continuous
+    -------------------------------------------------------------
+    xr          kWt     Power delivered by the receiver at time t
+    xrsu        kWt     Power used by the reciever for start up
+    ursu        kWt     Receiver accumulated start-up thermal power at time t
+    x           kWt	    Cycle thermal power consumption at time t 
+    ucsu        kWt     Cycle accumulated start-up thermal power at time t
+    s           kWht    TES reserve quantity at time t (auxiliary variable) 
+    wdot        kWe     Electrical power production at time t
+    delta_w     kWe     Positive change in power production at time t w/r/t t-1
+    -------------------------------------------------------------
+    Binary
+    -------------------------------------------------------------
+    yr              1 if receiver is generating ``usable'' thermal power at time t; 0 otherwise 
+    yrsu            1 if receiver is starting up at time t; 0 otherwise 
+    yrsb            1 if receiver is in standby at time t; 0 otherwise
+    yrsup           1 if reciever startup penalty is enforced at time t; 0 otherwise
+    yrhsp           1 if receiver hot startup penalty is enforced at time t; 0 otherwise
+    y               1 if cycle is generating electric power at time t; 0 otherwise
+    ycsu            1 if cycle is starting up at time t; 0 otherwise
+    ycsb            1 if cycle is in standby mode at time t; 0 otherwise
+    ycsup           1 if cycle startup penalty is enforced at time t; 0 otherwise
+    ychsp           1 if cycle hot startup penalty is enforced at time t; 0 otherwise
+    -------------------------------------------------------------
+    */
+    lprec *lp;
+    int ret = 0;
 
-                    //cycle standby start penalty
-                    row[0] = 1.;
-                    col[0] = O.column("ychsp", t);
 
-                    row[1] = -1.;
-                    col[1] = O.column("y", t);
+    try{
 
-                    row[2] = -1.;
-                    col[2] = O.column("ycsb", t-1);
+        //Calculate the number of variables
+        int nt = (int)m_nstep_opt;
 
-                    add_constraintex(lp, 3, row, col, GE, -1.);
+        //set up the variable structure
+        optimization_vars O;
+        O.add_var("xr", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+        O.add_var("xrsu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+        O.add_var("ursu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+        O.add_var("yr", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        O.add_var("yrsu", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        //O.add_var("yrsb", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        //O.add_var("yrsd", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        O.add_var("yrsup", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        //O.add_var("yrhsp", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
 
+        O.add_var("x", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0.);
+        O.add_var("y", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        O.add_var("s", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+        O.add_var("ucsu", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. );
+        O.add_var("ycsu", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        O.add_var("ycsb", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
 #ifdef MOD_CYCLE_SHUTDOWN
-                    //cycle shutdown energy penalty
-                    row[0] = 1.;
-                    col[0] = O.column("ycsd", t-1);
-
-                    row[1] = -1.;
-                    col[1] = O.column("y", t-1);
-                    
-                    row[2] = 1.;
-                    col[2] = O.column("y", t);
-                    
-                    row[3] = -1.;
-                    col[3] = O.column("ycsb", t-1);
-                    
-                    row[4] = 1.;
-                    col[4] = O.column("ycsb", t);
-
-                    add_constraintex(lp, 5, row, col, GE, 0.);
+        O.add_var("ycsd", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
 #endif
+        O.add_var("ycsup", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        O.add_var("ychsp", optimization_vars::VAR_TYPE::BINARY_T, optimization_vars::VAR_DIM::DIM_T, nt);
+        O.add_var("wdot", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. ); //0 lower bound?
+        O.add_var("delta_w", optimization_vars::VAR_TYPE::REAL_T, optimization_vars::VAR_DIM::DIM_T, nt, 0. ); 
+        
+        unordered_map<std::string, double> P;
+        calculate_parameters(this, P, nt);
 
-                }
-            }
-        }
+        O.construct();  //allocates memory for data array
 
+        int nvar = O.get_total_var_count(); //total number of variables in the problem
 
-        // ******************** Balance constraints *******************
-        //Energy in, out, and stored in the TES system must balance.
+        //check if cycle should be able to operate
+        for(int t=0; t<nt; t++)
         {
-            REAL row[7];
-            int col[7];
-
-            for(int t=0; t<nt; t++)
+            if( outputs.wnet_lim_min.at(t) > w_lim.at(t) )      // power cycle operation is impossible at t
             {
-                int i=0;
-
-                row[i  ] = P["delta"];
-                col[i++] = O.column("xr", t);
-                
-                row[i  ] = -P["delta"]*P["Qc"];
-                col[i++] = O.column("ycsu", t);
-                
-                row[i  ] = -P["delta"]*P["Qb"]; 
-                col[i++] = O.column("ycsb", t);
-                
-                row[i  ] = -P["delta"];
-                col[i++] = O.column("x", t);
-#ifdef MOD_REC_STANDBY                
-                row[i  ] = -delta*Qrsb;
-                col[i++] = O.column("yrsb", t);
-#endif
+                if(w_lim.at(t) > 0)
+                    params.messages->add_message(C_csp_messages::NOTICE, "Power cycle operation not possible at time "+ util::to_string(t+1) + ": power limit below minimum operation");                    
+                w_lim.at(t) = 0.;
                 
-                row[i  ] = -1.;
-                col[i++] = O.column("s", t);
-                
-                if(t>0)
-                {
-                    row[i  ] = 1.;
-                    col[i++] = O.column("s", t-1);
-
-                    add_constraintex(lp, i, row, col, EQ, 0.);
-                }
-                else
-                {
-                    add_constraintex(lp, i, row, col, EQ, -P["s0"]);  //initial storage state (kWh)
-                }
             }
         }
-        
-        //Energy in storage must be within limits
-        {
-            REAL row[8];
-            int col[8];
-
-            for(int t=0; t<nt; t++)
-            {
-                
-                row[0] = 1.;
-                col[0] = O.column("s", t);
 
-                add_constraintex(lp, 1, row, col, LE, P["Eu"]);
+        //plant parameters that appear as fixed coefficients or right-hand sides in the model
+        double key_vals[] = { P["delta"], P["Eu"], P["Er"], P["Ec"], P["Qu"], P["Ql"], P["Qru"], P["Qrl"], P["Qc"], P["Qb"], P["M"], 
+            params.q_pb_standby, params.q_pb_max, params.w_rec_pump, params.w_rec_ht, params.w_stow, params.w_track, 
+            params.w_cycle_standby, params.w_cycle_pump };
+        vector<double> key(key_vals, key_vals + sizeof(key_vals)/sizeof(double));
 
-				//max cycle thermal input in time periods where cycle operates and receiver is starting up
-                //outputs.delta_rs.resize(nt);
-				if (t < nt - 1)
-				{
-					/*double delta_rec_startup = min(1., max(params.e_rec_startup / max(outputs.q_sfavail_expected.at(t + 1)*P["delta"], 1.), params.dt_rec_startup / P["delta"]));
-                    outputs.delta_rs.at(t) = delta_rec_startup;*/
-					double t_rec_startup = outputs.delta_rs.at(t) * P["delta"];
-					double large = 5.0*params.q_pb_max;
-					int i = 0;
-
-					row[i] = 1.;
-					col[i++] = O.column("x", t + 1);
+        //the problem is only built from scratch when the horizon or the plant changes
+        if( m_lp_model.lp == NULL || m_lp_model.nt != nt || m_lp_model.key != key )
+        {
+            build_lp_model(O, P, nt);
+            m_lp_model.key = key;
+        }
+        lp = m_lp_model.lp;
 
-					row[i] = params.q_pb_standby + large;
-					col[i++] = O.column("ycsb", t + 1);
+        /* 
+        --------------------------------------------------------------------------------
+        set up the objective function. It follows the price signal, so it is rewritten for every window.
+        --------------------------------------------------------------------------------
+        */
+		{
+            int *col = new int[12 * nt];
+            REAL *row = new REAL[12 * nt];
+            double tadj = P["disp_time_weighting"];
+            int i = 0;
 
-					row[i] = -1. / t_rec_startup;
-					col[i++] = O.column("s", t);
+            //calculate the mean price to appropriately weight the receiver production timing derate
+            double pmean =0;
+            for(int t=0; t<(int)price_signal.size(); t++)
+                pmean += price_signal.at(t);
+            pmean /= (double)price_signal.size();
+            //--
+            
+            for(int t=0; t<nt; t++)
+            {
+                i = 0;
+                col[ t + nt*(i  ) ] = O.column("wdot", t);
+                row[ t + nt*(i++) ] = P["delta"] * price_signal.at(t)*tadj*(1.-outputs.w_condf_expected.at(t));
 
-					row[i] = large;
-					col[i++] = O.column("yrsu", t + 1);
+                col[ t + nt*(i  ) ] = O.column("xr", t);
+                row[ t + nt*(i++) ] = -(P["delta"] * price_signal.at(t) * P["Lr"])+tadj*pmean;  // tadj added to prefer receiver production sooner (i.e. delay dumping)
 
-					row[i] = large;
-					col[i++] = O.column("y", t + 1);
+                col[ t + nt*(i  ) ] = O.column("xrsu", t);
+                row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * P["Lr"];
 
-					row[i] = large;
-					col[i++] = O.column("y", t);
+                col[ t + nt*(i  ) ] = O.column("yrsu", t);
+                row[ t + nt*(i++) ] = -price_signal.at(t) * (params.w_rec_ht + params.w_stow);
 
-					row[i] = large;
-					col[i++] = O.column("ycsb", t);
+                col[ t + nt*(i  ) ] = O.column("yr", t);
+                row[ t + nt*(i++) ] = -(P["delta"] * price_signal.at(t) * params.w_track) + tadj;	// tadj added to prefer receiver operation in nearer term to longer term
 
-					add_constraintex(lp, i, row, col, LE, 3.0*large);
-				}
+                col[ t + nt*(i  ) ] = O.column("x", t);
+                row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * params.w_cycle_pump;
 
-            }
-        }
+                col[ t + nt*(i  ) ] = O.column("ycsb", t);
+                row[ t + nt*(i++) ] = -P["delta"] * price_signal.at(t) * params.w_cycle_standby;
 
-        // Maximum gross electricity production constraint
-        {
-            REAL row[1];
-            int col[1];
+                //xxcol[ t + nt*(i   ] = O.column("yrsb", t);
+                //xxrow[ t + nt*(i++) ] = -delta * price_signal.at(t) * (Lr * Qrl + (params.w_stow / delta));
 
-            for( int t = 0; t<nt; t++ )
-            {
-                row[0] = 1.;
-                col[0] = O.column("wdot", t);
+                //xxcol[ t + nt*(i   ] = O.column("yrsd", t);
+                //xxrow[ t + nt*(i++) ] = -0.5 - (params.w_stow);
 
-				add_constraintex(lp, 1, row, col, LE, outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"]);
-            }
-        }
+                //xxcol[ t + nt*(i   ] = O.column("ycsd", t);
+                //xxrow[ t + nt*(i++) ] = -0.5;
 
-		// Maximum net electricity production constraint
-		{
-			REAL row[9];
-			int col[9];
+                col[ t + nt*(i  ) ] = O.column("yrsup", t);
+                row[ t + nt*(i++) ] = -P["rsu_cost"]*tadj;
 
-			for (int t = 0; t<nt; t++)
-			{
-                
-                //check if cycle should be able to operate
-                if( outputs.wnet_lim_min.at(t) > w_lim.at(t) )      // power cycle operation is impossible at t
-                {
-                    if(w_lim.at(t) > 0)
-                        params.messages->add_message(C_csp_messages::NOTICE, "Power cycle operation not possible at time "+ util::to_string(t+1) + ": power limit below minimum operation");                    
-                    w_lim.at(t) = 0.;
-                    
-                }
+                //xxcol[ t + nt*(i   ] = O.column("yrhsp", t);
+                //xxrow[ t + nt*(i++) ] = -tadj;
 
-				if (w_lim.at(t) > 0.)	// Power cycle operation is possible
-				{
-					int i = 0;
+                col[ t + nt*(i  ) ] = O.column("ycsup", t);
+                row[ t + nt*(i++) ] = -P["csu_cost"]*tadj;
 
-					row[i] = 1.0-outputs.w_condf_expected.at(t);
-					col[i++] = O.column("wdot", t);
+                col[ t + nt*(i  ) ] = O.column("ychsp", t);
+                row[ t + nt*(i++) ] = -P["csu_cost"]*tadj * 0.1;
 
-					row[i] = -params.w_rec_pump;
-					col[i++] = O.column("xr", t);
+                col[ t + nt*(i  ) ] = O.column("delta_w", t);
+                row[ t + nt*(i++) ] = -P["pen_delta_w"]*tadj;
 
-					row[i] = -params.w_rec_pump;
-					col[i++] = O.column("xrsu", t);
+                tadj *= P["disp_time_weighting"];
+            }
 
-					row[i] = -(params.w_rec_ht / params.dt) - (params.w_stow / params.dt);	//kWe
-					col[i++] = O.column("yrsu", t);
+            set_obj_fnex(lp, i*nt, row, col);
 
-					row[i] = -params.w_track;
-					col[i++] = O.column("yr", t);
+            delete[] col;
+            delete[] row;
+        }
 
-					row[i] = -params.w_cycle_standby;
-					col[i++] = O.column("ycsb", t);
+        /* 
+        --------------------------------------------------------------------------------
+        update the coefficients, right-hand sides, and bounds that follow the forecast and 
+        the initial plant state
+        --------------------------------------------------------------------------------
+        */
+        unscale(lp);    //scale factors are recomputed from this window's data at solve time
+        {
+            vector<REAL> &rhs = m_lp_model.rhs;
 
-					row[i] = -params.w_cycle_pump;
-					col[i++] = O.column("x", t);
+            rhs.at(m_lp_model.row_wdot0) = -P["Wdot0"];
+            rhs.at(m_lp_model.row_rec_op0) = (params.is_rec_operating0 ? 1. : 0.);
+            rhs.at(m_lp_model.row_pb_op0) = (params.is_pb_operating0 ? 1. : 0.) + (params.is_pb_standby0 ? 1. : 0.);
+            rhs.at(m_lp_model.row_pb_sb0) = (params.is_pb_standby0 ? 1 : 0) + (params.is_pb_operating0 ? 1 : 0);
+            rhs.at(m_lp_model.row_tes0) = -P["s0"];
 
-					//row[i] = -(params.w_rec_pump*params.q_rec_min) - (params.w_stow / params.dt); //kWe
-					//col[i++] = O.column("yrsb", t);
-					//row[i] - params.w_stow / params.dt;	//kWe
-					//col[i++] = O.column("yrsd", t);
+            for(int t=0; t<nt; t++)
+            {
+                double q_sfavail = outputs.q_sfavail_expected.at(t);
 
-					add_constraintex(lp, 7, row, col, LE, w_lim.at(t));
-				}
-				else // Power cycle operation is impossible at current constrained wlim
-				{
-					row[0] = 1.0;
-					col[0] = O.column("wdot", t);
-					add_constraintex(lp, 1, row, col, EQ, 0.);
-				}
-			}
-		}
+                //power production curve
+                set_mat(lp, m_lp_model.row_pwr.at(t), O.column("x", t), -P["etap"]*outputs.eta_pb_expected.at(t)/params.eta_cycle_ref);
+                set_mat(lp, m_lp_model.row_pwr.at(t), O.column("y", t), -(P["Wdotu"] - P["etap"]*P["Qu"])*outputs.eta_pb_expected.at(t)/params.eta_cycle_ref);
+
+                //receiver availability
+                rhs.at(m_lp_model.row_rec_su.at(t)) = min(P["M"]*q_sfavail, 1.0);
+                rhs.at(m_lp_model.row_rec_lim.at(t)) = q_sfavail;
+                set_mat(lp, m_lp_model.row_rec_mode.at(t), O.column("yr", t), -q_sfavail);
+                rhs.at(m_lp_model.row_rec_avail.at(t)) = min(P["M"]*q_sfavail, 1.0);
+
+                //max cycle thermal input while the receiver starts up
+                if(t < nt - 1)
+                    set_mat(lp, m_lp_model.row_tes_su.at(t), O.column("s", t), -1. / (outputs.delta_rs.at(t) * P["delta"]));
+
+                //gross and net electricity production limits
+                rhs.at(m_lp_model.row_wdot_max.at(t)) = outputs.f_pb_op_limit.at(t) * P["W_dot_cycle"];
+                set_mat(lp, m_lp_model.row_wnet_max.at(t), O.column("wdot", t), 1.0-outputs.w_condf_expected.at(t));
+                rhs.at(m_lp_model.row_wnet_max.at(t)) = w_lim.at(t);
+                set_upbo(lp, O.column("wdot", t), w_lim.at(t) > 0. ? get_infinite(lp) : 0.);
+            }
 
-        
-        //Set problem to maximize
-        set_maxim(lp);
+            set_rh_vec(lp, &rhs.front());
+        }
 
-        //reset the row mode
-        set_add_rowmode(lp, FALSE);
+        //start from the previous window's basis
+        if( !m_lp_model.basis.empty() )
+        {
+            if( !set_basis(lp, &m_lp_model.basis.front(), TRUE) )
+                default_basis(lp);
+        }
 
         //set the log function
         solver_params.reset();
@@ -1342,9 +1475,13 @@ bool csp_dispatch_opt::optimize()
             NODE_PSEUDOCOSTSELECT + NODE_RANDOMIZEMODE :: optimal from independent optimization, THIS VERSION CURRENT AS OF 12/5/2016
         */
 
-        //presolve
+        //presolve. Presolve removes rows and columns from the model, so the problem is only kept for the next 
+        //window when presolve is turned off.
+        bool is_presolve_off = solver_params.presolve_type == s_solver_params::PRESOLVE_TYPE_OFF;
         if(solver_params.presolve_type > 0)
             set_presolve(lp, solver_params.presolve_type, get_presolveloops(lp));
+        else if(is_presolve_off)
+            set_presolve(lp, PRESOLVE_NONE, get_presolveloops(lp));
         else
             set_presolve(lp, PRESOLVE_ROWS + PRESOLVE_COLS + PRESOLVE_ELIMEQ2 + PRESOLVE_PROBEFIX, get_presolveloops(lp) );   //independent optimization
 
@@ -1577,9 +1714,16 @@ bool csp_dispatch_opt::optimize()
         //get number of iterations
         outputs.solve_iter = (int)get_total_iter(lp);
 
-
-        delete_lp(lp);
-        lp = NULL;
+        //Keep the model and its basis for the next window. Presolve removes rows and columns, and a failed 
+        //solve can leave the model partly processed, so both cases start the next window from a new model.
+        if( !return_ok || !is_presolve_off || get_Nrows(lp) != (int)m_lp_model.rhs.size() - 1 || get_Ncolumns(lp) != nvar )
+            m_lp_model.clear();
+        else
+        {
+            m_lp_model.basis.resize(1 + get_Nrows(lp) + get_Ncolumns(lp));
+            if( !get_basis(lp, &m_lp_model.basis.front(), TRUE) )
+                m_lp_model.basis.clear();
+        }
 
         stringstream s;
         int time_start = (int)(params.info_time / 3600.);
@@ -1654,8 +1798,7 @@ bool csp_dispatch_opt::optimize()
     catch(exception &e)
     {
         //clean up memory and pass on the exception
-        if( lp != NULL )
-            delete_lp(lp);
+        m_lp_model.clear();
         
         throw e;
 
@@ -1663,8 +1806,7 @@ bool csp_dispatch_opt::optimize()
     catch(...)
     {
         //clean up memory and pass on the exception
-        if( lp != NULL )
-            delete_lp(lp);
+        m_lp_model.clear();
 
         return false;
     }
@@ -64,6 +64,8 @@ using namespace std;
 #ifndef _CSP_DISPATCH
 #define _CSP_DISPATCH
 
+class optimization_vars;
+
 class csp_dispatch_opt
 {
     int  m_nstep_opt;              //number of time steps in the optimized array
@@ -71,6 +73,49 @@ class csp_dispatch_opt
     
     void clear_output_arrays();
 
+    /* 
+    Dispatch problem kept between rolling-horizon windows. The model is built once for a horizon length 
+    and set of plant parameters. Each later window rewrites the objective, the coefficients that follow 
+    the forecast, the right-hand side vector, and the variable bounds, and the solve starts from the 
+    previous window's basis. Presolve reduces the model in place, so the model is only kept when presolve 
+    is turned off (solver_params.presolve_type == PRESOLVE_TYPE_OFF). With presolve on, the default, the 
+    model is rebuilt for every window.
+    */
+    struct s_lp_model
+    {
+        lprec *lp;
+        int nt;                     //horizon length the model was built for
+        vector<double> key;         //plant parameters the fixed coefficients were built from
+        vector<REAL> rhs;           //right-hand side of each row (1-based)
+        vector<int> basis;          //basis from the last successful solve (lp_solve get_basis layout)
+        
+        //rows whose coefficients or right-hand side change between windows
+        int row_wdot0;              //cycle production change, first period
+        int row_rec_op0;            //receiver operation allowed, first period
+        int row_pb_op0;             //cycle operation allowed, first period
+        int row_pb_sb0;             //standby mode entry, first period
+        int row_tes0;               //storage balance, first period
+        vector<int> row_pwr;        //power production curve
+        vector<int> row_rec_su;     //receiver startup only during solar positive periods
+        vector<int> row_rec_lim;    //receiver consumption limit
+        vector<int> row_rec_mode;   //receiver operation mode requirement
+        vector<int> row_rec_avail;  //receiver can't operate when no energy is available
+        vector<int> row_tes_su;     //max cycle input while the receiver starts up
+        vector<int> row_wdot_max;   //maximum gross electricity production
+        vector<int> row_wnet_max;   //maximum net electricity production
+
+        s_lp_model();
+        ~s_lp_model();
+
+        void clear();
+
+    private:
+        s_lp_model(const s_lp_model &);
+        s_lp_model &operator=(const s_lp_model &);
+    } m_lp_model;
+
+    void build_lp_model(optimization_vars &O, unordered_map<std::string, double> &P, int nt);
+
 public:
     bool m_last_opt_successful;   //last optimization run was successful?
     int m_current_read_step;        //current step to read from optimization results
@@ -89,7 +134,7 @@ public:
         int max_bb_iter;            //Maximum allowable iterations for B&B algorithm
         double mip_gap;             //convergence tolerance - gap between relaxed MIP solution and current best solution
         double solution_timeout;    //[s] Max solve time for each solution
-        int presolve_type;
+        int presolve_type;          //lp_solve presolve flags. <=0 uses the default set, PRESOLVE_TYPE_OFF turns presolve off.
         int bb_type;  
         int disp_reporting;
         int scaling_type;
@@ -99,6 +144,8 @@ public:
         std::string ampl_data_dir;  //directory to write ampl data files
         std::string ampl_exec_call; //system call for running ampl
 
+        static const int PRESOLVE_TYPE_OFF = -2;    //presolve_type that turns presolve off and keeps the model between windows
+
         s_solver_params()
         {
             bb_type = -1;
@@ -308,6 +355,9 @@ public:
     //Predict performance out nstep values. 
     bool predict_performance(int step_start, int ntimeints, int divs_per_int);    
 
+    //Set the horizon for expected performance arrays that are filled in directly rather than by predict_performance
+    void set_horizon(int nstep) { m_nstep_opt = nstep; }
+
     //declare dispatch function in csp_dispatch.cpp
     bool optimize();
 
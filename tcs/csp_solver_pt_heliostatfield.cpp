@@ -689,12 +689,27 @@ void C_pt_heliostatfield::init()
 		Powvargram vgram(sunpos, effs, interp_beta, interp_nug);
 		field_efficiency_table = new GaussMarkov(sunpos, effs, vgram);
 
+		//precompute the fit on a regular grid so each timestep is a table lookup instead of a pass over all points
+		if( ms_params.m_is_eta_map_grid )
+		{
+			std::vector<int> n_grid(2);
+			n_grid.at(0) = 181;		//~2 deg in azimuth
+			n_grid.at(1) = 91;		//~1 deg in zenith
+			if( sunpos.front().size() > 2 )
+			{
+				n_grid.at(0) = 91;
+				n_grid.at(1) = 46;
+				n_grid.push_back(11);
+			}
+			field_efficiency_table->precompute_grid(n_grid);
+		}
+
 		//test how well the fit matches the data
 		double err_fit = 0.;
 		int npoints = (int)sunpos.size();
 		for( int i = 0; i<npoints; i++ ){
 			double zref = effs.at(i);
-			double zfit = field_efficiency_table->interp(sunpos.at(i));
+			double zfit = field_efficiency_table->interp_kriged(sunpos.at(i));
 			double dz = zref - zfit;
 			err_fit += dz * dz;
 		}
@@ -704,6 +719,13 @@ void C_pt_heliostatfield::init()
 			error_msg = util::format("The heliostat field interpolation function fit is poor! (err_fit=%f RMS)", err_fit);
 			mc_csp_messages.add_message(C_csp_messages::WARNING, error_msg);
 		}
+
+		double err_grid = field_efficiency_table->grid_max_error() * eff_scale;
+		if( err_grid > 0.001 )
+		{
+			error_msg = util::format("The heliostat field efficiency grid differs from the interpolation function by up to %f", err_grid);
+			mc_csp_messages.add_message(C_csp_messages::WARNING, error_msg);
+		}
 		
 		// Calculate the total solar field reflective area
 		ms_params.m_A_sf = ms_params.m_helio_height*ms_params.m_helio_width*ms_params.m_dens_mirror*m_N_hel;		//[m^2]
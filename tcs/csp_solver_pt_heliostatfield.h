@@ -139,6 +139,7 @@ public:
 		double m_v_wind_max;		//[m/s] max wind speed
 		double m_interp_nug;
 		double m_interp_beta;
+		bool m_is_eta_map_grid;		//[-] Precompute the field efficiency interpolation on a grid, otherwise krige every call
 
 		int m_n_flux_x;
 		int m_n_flux_y;
@@ -204,6 +205,9 @@ public:
 
 			// strings
 			m_weather_file = "";
+
+			// Booleans
+			m_is_eta_map_grid = true;
 		}		
 	};
 
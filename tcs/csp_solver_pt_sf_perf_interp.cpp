@@ -197,12 +197,27 @@ void C_pt_sf_perf_interp::init()
 	Powvargram vgram(sunpos, effs, interp_beta, interp_nug);
 	field_efficiency_table = new GaussMarkov(sunpos, effs, vgram);
 
+	//precompute the fit on a regular grid so each timestep is a table lookup instead of a pass over all points
+	if( ms_params.m_is_eta_map_grid )
+	{
+		std::vector<int> n_grid(2);
+		n_grid.at(0) = 181;		//~2 deg in azimuth
+		n_grid.at(1) = 91;		//~1 deg in zenith
+		if( ms_params.m_eta_map_aod_format )
+		{
+			n_grid.at(0) = 91;
+			n_grid.at(1) = 46;
+			n_grid.push_back(11);
+		}
+		field_efficiency_table->precompute_grid(n_grid);
+	}
+
 	//test how well the fit matches the data
 	double err_fit = 0.;
 	int npoints = (int)sunpos.size();
 	for( int i = 0; i<npoints; i++ ){
 		double zref = effs.at(i);
-		double zfit = field_efficiency_table->interp(sunpos.at(i));
+		double zfit = field_efficiency_table->interp_kriged(sunpos.at(i));
 		double dz = zref - zfit;
 		err_fit += dz * dz;
 	}
@@ -213,6 +228,18 @@ void C_pt_sf_perf_interp::init()
 		mc_csp_messages.add_message(C_csp_messages::WARNING, error_msg);
 	}
 
+	double err_grid = field_efficiency_table->grid_max_error() * eff_scale;
+	if( err_grid > 0.001 )
+	{
+		error_msg = util::format("The heliostat field efficiency grid differs from the interpolation function by up to %f", err_grid);
+		mc_csp_messages.add_message(C_csp_messages::WARNING, error_msg);
+	}
+
+	//size the per-timestep buffers
+	m_sunpos_now.reserve(3);
+	m_map_distances.resize(m_map_sol_pos.size());
+	m_map_indices.resize(m_map_sol_pos.size());
+
 	// Initialize stored variables
 	m_eta_prev = 0.0;
 	m_v_wind_prev = 0.0;
@@ -278,7 +305,8 @@ void C_pt_sf_perf_interp::call(const C_csp_weatherreader::S_outputs &weather, do
 	else
 	{
 		// Use current solar position to interpolate field efficiency table and find solar field efficiency
-		vector<double> sunpos;
+		vector<double> &sunpos = m_sunpos_now;
+		sunpos.clear();
 		sunpos.push_back(solaz / az_scale);
 		sunpos.push_back(solzen / zen_scale);
         if( ms_params.m_eta_map_aod_format )
@@ -293,14 +321,14 @@ void C_pt_sf_perf_interp::call(const C_csp_weatherreader::S_outputs &weather, do
 		eta_field = fmin(fmax(eta_field, 0.0), 1.0) * field_control * sf_adjust;		// Ensure physical behavior 
 
 		//Set the active flux map
-		VectDoub pos_now(sunpos);
+		VectDoub &pos_now = sunpos;
 		
         //find the nearest neighbors to the current point
-		vector<double> distances;
-		vector<int> indices;
+		vector<double> &distances = m_map_distances;
+		vector<int> &indices = m_map_indices;
 		for (int i = 0; i<(int)m_map_sol_pos.size(); i++){
-			distances.push_back(rdist(&pos_now, &m_map_sol_pos.at(i)));
-			indices.push_back(i);
+			distances.at(i) = rdist(&pos_now, &m_map_sol_pos.at(i));
+			indices.at(i) = i;
 		}
 		quicksort<double, int>(distances, indices);
 		//calculate weights for the nearest 6 points
@@ -309,15 +337,15 @@ void C_pt_sf_perf_interp::call(const C_csp_weatherreader::S_outputs &weather, do
 		for( int i = 0; i<npt; i++ )
 			avepoints += distances.at(i);
 		avepoints *= 1. / (double)npt;
-		VectDoub weights(npt);
+		double weights[npt];
 		double normalizer = 0.;
 		for( int i = 0; i<npt; i++ ){
 			double w = exp(-pow(distances.at(i) / avepoints, 2));
-			weights.at(i) = w;
+			weights[i] = w;
 			normalizer += w;
 		}
 		for( int i = 0; i<npt; i++ )
-			weights.at(i) *= 1. / normalizer;
+			weights[i] *= 1. / normalizer;
 
 		//set the values
 		for( int k = 0; k<npt; k++ )
@@ -327,7 +355,7 @@ void C_pt_sf_perf_interp::call(const C_csp_weatherreader::S_outputs &weather, do
 			{
 				for( int i = 0; i<m_n_flux_x; i++ )
 				{
-					ms_outputs.m_flux_map_out(j, i) += ms_params.m_flux_maps(imap*m_n_flux_y + j, i)*weights.at(k);
+					ms_outputs.m_flux_map_out(j, i) += ms_params.m_flux_maps(imap*m_n_flux_y + j, i)*weights[k];
 				}
 			}
 		}
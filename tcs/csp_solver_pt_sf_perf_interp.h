@@ -65,6 +65,11 @@ private:
 	// Class Instances
 	GaussMarkov *field_efficiency_table;
 	MatDoub m_map_sol_pos;
+
+	// Per-timestep buffers, sized in init() so call() doesn't allocate
+	VectDoub m_sunpos_now;
+	std::vector<double> m_map_distances;
+	std::vector<int> m_map_indices;
 	
 	double m_p_start;				//[kWe-hr] Heliostat startup energy
 	double m_p_track;				//[kWe] Heliostat tracking power
@@ -104,6 +109,7 @@ public:
 	struct S_params
 	{
         bool m_eta_map_aod_format;			//[-]
+		bool m_is_eta_map_grid;				//[-] Precompute the field efficiency interpolation on a grid, otherwise krige every call
 
 		double m_p_start;			//[kWe-hr] Heliostat startup energy
 		double m_p_track;			//[kWe] Heliostat tracking power
@@ -134,6 +140,8 @@ public:
 			m_p_start = m_p_track = m_hel_stow_deploy = m_v_wind_max = 
 				m_land_area = m_A_sf = std::numeric_limits<double>::quiet_NaN();
 
+			// Booleans
+			m_is_eta_map_grid = true;
 		}		
 	};
 
@@ -403,6 +403,65 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 	double h_c_in /*kJ/kg*/, double h_h_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/,
 	double & h_h_out /*kJ/kg*/, double & T_h_out /*K*/, double & h_c_out /*kJ/kg*/, double & T_c_out /*K*/,
 	double & UA /*kW/K*/, double & min_DT /*C*/, double & eff /*-*/, double & NTU /*-*/, double & q_dot_calc /*kWt*/)
+{
+	NS_HX_counterflow_eqs::S_node_buffers node_buffers;
+
+	NS_HX_counterflow_eqs::calc_req_UA_enth(hot_fl_code, hot_htf_class,
+		cold_fl_code, cold_htf_class,
+		N_sub_hx,
+		q_dot, m_dot_c, m_dot_h,
+		h_c_in, h_h_in, P_c_in, P_c_out, P_h_in, P_h_out,
+		h_h_out, T_h_out, h_c_out, T_c_out,
+		UA, min_DT, eff, NTU, q_dot_calc,
+		node_buffers);
+}
+
+// Calculates the temperatures at all nodes of one side of the heat exchanger
+static void calc_node_temps(int fl_code /*-*/, HTFProperties & htf_class, int N_nodes /*-*/,
+	const double *P /*kPa*/, const double *h /*kJ/kg*/, double *T /*K*/,
+	std::vector<CO2_state> & co2_states, const char *error_msg, int error_code)
+{
+	if (fl_code == NS_HX_counterflow_eqs::CO2)
+	{
+		co2_states.resize(N_nodes);
+		if (CO2_PH_array(N_nodes, P, h, co2_states.data()) != 0)
+		{
+			throw(C_csp_exception("C_HX_counterflow::calc_req_UA_enth", error_msg, error_code));
+		}
+		for (int i = 0; i < N_nodes; i++)
+		{
+			T[i] = co2_states[i].temp;		//[K]
+		}
+	}
+	else if (fl_code == NS_HX_counterflow_eqs::WATER)
+	{
+		water_state ms_water_props;
+		for (int i = 0; i < N_nodes; i++)
+		{
+			if (water_PH(P[i], h[i], &ms_water_props) != 0)
+			{
+				throw(C_csp_exception("C_HX_counterflow::calc_req_UA_enth", error_msg, error_code));
+			}
+			T[i] = ms_water_props.temp;		//[K]
+		}
+	}
+	else
+	{
+		for (int i = 0; i < N_nodes; i++)
+		{
+			T[i] = htf_class.temp_lookup(h[i]);	//[K]
+		}
+	}
+}
+
+void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFProperties & hot_htf_class,
+	int cold_fl_code /*-*/, HTFProperties & cold_htf_class,
+	int N_sub_hx /*-*/,
+	double q_dot /*kWt*/, double m_dot_c /*kg/s*/, double m_dot_h /*kg/s*/,
+	double h_c_in /*kJ/kg*/, double h_h_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/,
+	double & h_h_out /*kJ/kg*/, double & T_h_out /*K*/, double & h_c_out /*kJ/kg*/, double & T_c_out /*K*/,
+	double & UA /*kW/K*/, double & min_DT /*C*/, double & eff /*-*/, double & NTU /*-*/, double & q_dot_calc /*kWt*/,
+	S_node_buffers & node_buffers)
 {
 	// Check inputs
 	if (q_dot < 0.0)
@@ -431,124 +490,70 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 			"Cold side outlet pressure is greater than cold side inlet pressure", 7));
 	}
 
-	// Calculate outlet stream states
-	CO2_state ms_co2_props;
-	water_state ms_water_props;
-	int prop_error_code = 0;
-
 	h_h_out = h_h_in - q_dot / m_dot_h;		//[kJ/kg]
 	h_c_out = h_c_in + q_dot / m_dot_c;		//[kJ/kg]	
 
 	int N_nodes = N_sub_hx + 1;
-	double h_h_prev = 0.0;
-	double T_h_prev = 0.0;
-	double h_c_prev = 0.0;
-	double T_c_prev = 0.0;
-	double T_c_in = std::numeric_limits<double>::quiet_NaN();	//[K]
-	double T_h_in = std::numeric_limits<double>::quiet_NaN();	//[K]
+	std::vector<double> & P_h = node_buffers.mv_P_h;
+	std::vector<double> & h_h = node_buffers.mv_h_h;
+	std::vector<double> & T_h = node_buffers.mv_T_h;
+	std::vector<double> & P_c = node_buffers.mv_P_c;
+	std::vector<double> & h_c = node_buffers.mv_h_c;
+	std::vector<double> & T_c = node_buffers.mv_T_c;
+	P_h.resize(N_nodes);
+	h_h.resize(N_nodes);
+	T_h.resize(N_nodes);
+	P_c.resize(N_nodes);
+	h_c.resize(N_nodes);
+	T_c.resize(N_nodes);
 
-	// Loop through the sub-heat exchangers
-	UA = 0.0;
-	min_DT = T_h_in;
 	for (int i = 0; i < N_nodes; i++)
 	{
 		// Assume pressure varies linearly through heat exchanger
-		double P_c = P_c_out + i*(P_c_in - P_c_out) / (double)(N_nodes - 1);
-		double P_h = P_h_in - i*(P_h_in - P_h_out) / (double)(N_nodes - 1);
+		P_c[i] = P_c_out + i*(P_c_in - P_c_out) / (double)(N_nodes - 1);
+		P_h[i] = P_h_in - i*(P_h_in - P_h_out) / (double)(N_nodes - 1);
 
 		// Calculate the entahlpy at the node
-		double h_c = h_c_out + i*(h_c_in - h_c_out) / (double)(N_nodes - 1);
-		double h_h = h_h_in - i*(h_h_in - h_h_out) / (double)(N_nodes - 1);
-
-		// ****************************************************
-		// Calculate the hot and cold temperatures at the node
-		double T_h = std::numeric_limits<double>::quiet_NaN();
-		if (hot_fl_code == NS_HX_counterflow_eqs::CO2)
-		{
-			prop_error_code = CO2_PH(P_h, h_h, &ms_co2_props);
-			if (prop_error_code != 0)
-			{
-				throw(C_csp_exception("C_HX_counterflow::design",
-					"Cold side inlet enthalpy calculations failed", 12));
-			}
-			T_h = ms_co2_props.temp;		//[K]
-		}
-		else if (hot_fl_code == NS_HX_counterflow_eqs::WATER)
-		{
-			prop_error_code = water_PH(P_h, h_h, &ms_water_props);
-			if (prop_error_code != 0)
-			{
-				throw(C_csp_exception("C_HX_counterflow::calc_req_UA_enth",
-					"Cold side inlet enthalpy calculations failed", 12));
-			}
-			T_h = ms_water_props.temp;		//[K]
-		}
-		else
-		{
-			T_h = hot_htf_class.temp_lookup(h_h);	//[K]
-		}
-
-		double T_c = std::numeric_limits<double>::quiet_NaN();
-		if (cold_fl_code == NS_HX_counterflow_eqs::CO2)
-		{
-			prop_error_code = CO2_PH(P_c, h_c, &ms_co2_props);
-			if (prop_error_code != 0)
-			{
-				throw(C_csp_exception("C_HX_counterflow::design",
-					"Cold side inlet enthalpy calculations failed", 13));
-			}
-			T_c = ms_co2_props.temp;		//[K]
-		}
-		else if (cold_fl_code == NS_HX_counterflow_eqs::WATER)
-		{
-			prop_error_code = water_PH(P_c, h_c, &ms_water_props);
-			if (prop_error_code != 0)
-			{
-				throw(C_csp_exception("C_HX_counterflow::calc_req_UA_enth",
-					"Cold side water/steam inlet enthalpy calculations failed", 13));
-			}
-			T_c = ms_water_props.temp;		//[K]
-		}
-		else
-		{
-			T_c = cold_htf_class.temp_lookup(h_c);	//[K]
-		}
+		h_c[i] = h_c_out + i*(h_c_in - h_c_out) / (double)(N_nodes - 1);
+		h_h[i] = h_h_in - i*(h_h_in - h_h_out) / (double)(N_nodes - 1);
+	}
 
-		if (i == 0)
-		{
-			T_h_in = T_h;
-			T_c_out = T_c;
-		}
-		if (i == N_nodes - 1)
-		{
-			T_h_out = T_h;
-			T_c_in = T_c;
-		}
+	// Calculate the hot and cold temperatures at all nodes
+	calc_node_temps(hot_fl_code, hot_htf_class, N_nodes, P_h.data(), h_h.data(), T_h.data(),
+		node_buffers.mv_co2_states, "Hot side node enthalpy calculations failed", 12);
+	calc_node_temps(cold_fl_code, cold_htf_class, N_nodes, P_c.data(), h_c.data(), T_c.data(),
+		node_buffers.mv_co2_states, "Cold side node enthalpy calculations failed", 13);
 
-		// ****************************************************
-		// ****************************************************
-		// ****************************************************
+	double T_h_in = T_h[0];				//[K]
+	T_c_out = T_c[0];					//[K]
+	T_h_out = T_h[N_nodes - 1];			//[K]
+	double T_c_in = T_c[N_nodes - 1];	//[K]
 
+	// Loop through the sub-heat exchangers
+	UA = 0.0;
+	min_DT = std::numeric_limits<double>::quiet_NaN();
+	for (int i = 0; i < N_nodes; i++)
+	{
 		// Check that 2nd law is not violated
-		if (T_c >= T_h)
+		if (T_c[i] >= T_h[i])
 		{
 			throw(C_csp_exception("C_HX_counterflow::design",
 				"Cold temperature is hotter than hot temperature.", 11));
 		}
 
 		// Track the minimum temperature difference in the heat exchanger
-		min_DT = fmin(min_DT, T_h - T_c);
+		min_DT = fmin(min_DT, T_h[i] - T_c[i]);
 
 		// Perform effectiveness-NTU and UA calculations 
 		if (i > 0)
 		{
 			bool is_h_2phase = false;
-			if (fabs(T_h_prev - T_h) < 0.001)
+			if (fabs(T_h[i-1] - T_h[i]) < 0.001)
 			{
 				is_h_2phase = true;
 			}
 			bool is_c_2phase = false;
-			if (fabs(T_c_prev - T_c) < 0.001)
+			if (fabs(T_c[i-1] - T_c[i]) < 0.001)
 			{
 				is_c_2phase = true;
 			}
@@ -558,29 +563,29 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 
 			if (is_h_2phase && !is_c_2phase)
 			{
-				C_dot_min = m_dot_c*(h_c_prev - h_c) / (T_c_prev - T_c);			// [kW/K] cold stream capacitance rate
+				C_dot_min = m_dot_c*(h_c[i-1] - h_c[i]) / (T_c[i-1] - T_c[i]);			// [kW/K] cold stream capacitance rate
 				C_R = 0.0;
 			}
 			else if (!is_c_2phase && is_h_2phase)
 			{
-				C_dot_min = m_dot_h*(h_h_prev - h_h) / (T_h_prev - T_h);			// [kW/K] hot stream capacitance rate
+				C_dot_min = m_dot_h*(h_h[i-1] - h_h[i]) / (T_h[i-1] - T_h[i]);			// [kW/K] hot stream capacitance rate
 				C_R = 0.0;
 			}
 			else if (is_c_2phase && is_h_2phase)
 			{
-				C_dot_min = q_dot / (double)N_sub_hx * 1.E10 * (T_h_prev - T_c);
+				C_dot_min = q_dot / (double)N_sub_hx * 1.E10 * (T_h[i-1] - T_c[i]);
 				C_R = 1.0;
 			}
 			else
 			{
-				double C_dot_h = m_dot_h*(h_h_prev - h_h) / (T_h_prev - T_h);			// [kW/K] hot stream capacitance rate
-				double C_dot_c = m_dot_c*(h_c_prev - h_c) / (T_c_prev - T_c);			// [kW/K] cold stream capacitance rate
+				double C_dot_h = m_dot_h*(h_h[i-1] - h_h[i]) / (T_h[i-1] - T_h[i]);			// [kW/K] hot stream capacitance rate
+				double C_dot_c = m_dot_c*(h_c[i-1] - h_c[i]) / (T_c[i-1] - T_c[i]);			// [kW/K] cold stream capacitance rate
 				C_dot_min = fmin(C_dot_h, C_dot_c);						// [kW/K] Minimum capacitance stream
 				double C_dot_max = fmax(C_dot_h, C_dot_c);				// [kW/K] Maximum capacitance stream
 				C_R = C_dot_min / C_dot_max;						// [-] Capacitance ratio of sub-heat exchanger
 			}
 
-			double eff = min(0.99999, (q_dot / (double)N_sub_hx) / (C_dot_min*(T_h_prev - T_c)));	// [-] Effectiveness of each sub-heat exchanger
+			double eff = min(0.99999, (q_dot / (double)N_sub_hx) / (C_dot_min*(T_h[i-1] - T_c[i])));	// [-] Effectiveness of each sub-heat exchanger
 			double NTU = 0.0;
 			if (C_R != 1.0)
 				NTU = log((1.0 - eff*C_R) / (1.0 - eff)) / (1.0 - C_R);		// [-] NTU if C_R does not equal 1
@@ -588,10 +593,6 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 				NTU = eff / (1.0 - eff);
 			UA += NTU*C_dot_min;								//[kW/K] Sum UAs for each hx section
 		}
-		h_h_prev = h_h;
-		T_h_prev = T_h;
-		h_c_prev = h_c;
-		T_c_prev = T_c;
 	}
 
 	// Check for NaNs in UA
@@ -606,10 +607,22 @@ void NS_HX_counterflow_eqs::calc_req_UA_enth(int hot_fl_code /*-*/, HTFPropertie
 	// **************************************************************
 	// Calculate the HX effectiveness
 
-	double q_dot_max = NS_HX_counterflow_eqs::calc_max_q_dot_enth(hot_fl_code, hot_htf_class,
-		cold_fl_code, cold_htf_class,
-		h_h_in, P_h_in, P_h_out, m_dot_h,
-		h_c_in, P_c_in, P_c_out, m_dot_c);
+	// The maximum heat transfer only depends on the inlet states and outlet pressures,
+	// so it is reused while those don't change between calls
+	double q_dot_max_inputs[10] = {(double)hot_fl_code, (double)cold_fl_code,
+		h_h_in, P_h_in, P_h_out, m_dot_h, h_c_in, P_c_in, P_c_out, m_dot_c};
+	if (!node_buffers.m_is_q_dot_max_set ||
+		!std::equal(q_dot_max_inputs, q_dot_max_inputs + 10, node_buffers.ma_q_dot_max_inputs))
+	{
+		node_buffers.m_is_q_dot_max_set = false;
+		node_buffers.m_q_dot_max = NS_HX_counterflow_eqs::calc_max_q_dot_enth(hot_fl_code, hot_htf_class,
+			cold_fl_code, cold_htf_class,
+			h_h_in, P_h_in, P_h_out, m_dot_h,
+			h_c_in, P_c_in, P_c_out, m_dot_c);
+		std::copy(q_dot_max_inputs, q_dot_max_inputs + 10, node_buffers.ma_q_dot_max_inputs);
+		node_buffers.m_is_q_dot_max_set = true;
+	}
+	double q_dot_max = node_buffers.m_q_dot_max;
 
 	eff = q_dot / q_dot_max;
 
@@ -671,7 +684,8 @@ int NS_HX_counterflow_eqs::C_mono_eq_UA_v_q_enth::operator()(double q_dot /*kWt*
 			q_dot, m_m_dot_c, m_m_dot_h, 
 			m_h_c_in, m_h_h_in, m_P_c_in, m_P_c_out, m_P_h_in, m_P_h_out, 
 			m_h_h_out, m_T_h_out, m_h_c_out, m_T_c_out,
-			m_UA_calc, m_min_DT, m_eff, m_NTU, q_dot_calc);
+			m_UA_calc, m_min_DT, m_eff, m_NTU, q_dot_calc,
+			ms_node_buffers);
 	}
 	catch (C_csp_exception &csp_except)
 	{
@@ -50,6 +50,9 @@
 #ifndef __HEAT_EXCHANGERS_
 #define __HEAT_EXCHANGERS_
 
+#include <vector>
+#include <limits>
+
 #include "CO2_properties.h"
 #include "water_properties.h"
 #include "htf_props.h"
@@ -66,6 +69,31 @@ namespace NS_HX_counterflow_eqs
 		WATER = 201
 	};
 
+	// Sub-heat exchanger node states used by calc_req_UA_enth. Keeping an instance across calls
+	// (e.g. the iterations of C_mono_eq_UA_v_q_enth) avoids reallocating the node arrays and
+	// recalculating the maximum heat transfer when the inlet states don't change.
+	// An instance should only be reused for one hot/cold fluid pair.
+	struct S_node_buffers
+	{
+		std::vector<double> mv_P_h;		//[kPa] Hot side node pressures
+		std::vector<double> mv_h_h;		//[kJ/kg] Hot side node enthalpies
+		std::vector<double> mv_T_h;		//[K] Hot side node temperatures
+		std::vector<double> mv_P_c;		//[kPa] Cold side node pressures
+		std::vector<double> mv_h_c;		//[kJ/kg] Cold side node enthalpies
+		std::vector<double> mv_T_c;		//[K] Cold side node temperatures
+		std::vector<CO2_state> mv_co2_states;
+
+		bool m_is_q_dot_max_set;		//[-] True if m_q_dot_max was calculated for ma_q_dot_max_inputs
+		double ma_q_dot_max_inputs[10];	//[-] Fluid codes and inlet/outlet states of m_q_dot_max
+		double m_q_dot_max;				//[kWt]
+
+		S_node_buffers()
+		{
+			m_is_q_dot_max_set = false;
+			m_q_dot_max = std::numeric_limits<double>::quiet_NaN();
+		}
+	};
+
 	double calc_max_q_dot_enth(int hot_fl_code /*-*/, HTFProperties & hot_htf_class,
 		int cold_fl_code /*-*/, HTFProperties & cold_htf_class,
 		double h_h_in /*kJ/kg*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/, double m_dot_h /*kg/s*/,
@@ -90,6 +118,15 @@ namespace NS_HX_counterflow_eqs
 		double h_c_in /*kJ/kg*/, double h_h_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/,
 		double & h_h_out /*kJ/kg*/, double & T_h_out /*K*/, double & h_c_out /*kJ/kg*/, double & T_c_out /*K*/,
 		double & UA /*kW/K*/, double & min_DT /*C*/, double & eff /*-*/, double & NTU /*-*/, double & q_dot_calc /*kWt*/);
+
+	void calc_req_UA_enth(int hot_fl_code /*-*/, HTFProperties & hot_htf_class,
+		int cold_fl_code /*-*/, HTFProperties & cold_htf_class,
+		int N_sub_hx /*-*/,
+		double q_dot /*kWt*/, double m_dot_c /*kg/s*/, double m_dot_h /*kg/s*/,
+		double h_c_in /*kJ/kg*/, double h_h_in /*kJ/kg*/, double P_c_in /*kPa*/, double P_c_out /*kPa*/, double P_h_in /*kPa*/, double P_h_out /*kPa*/,
+		double & h_h_out /*kJ/kg*/, double & T_h_out /*K*/, double & h_c_out /*kJ/kg*/, double & T_c_out /*K*/,
+		double & UA /*kW/K*/, double & min_DT /*C*/, double & eff /*-*/, double & NTU /*-*/, double & q_dot_calc /*kWt*/,
+		S_node_buffers & node_buffers);
 	
 	void solve_q_dot_for_fixed_UA(int hot_fl_code /*-*/, HTFProperties & hot_htf_class,
 		int cold_fl_code /*-*/, HTFProperties & cold_htf_class,
@@ -132,6 +169,8 @@ namespace NS_HX_counterflow_eqs
 		double m_P_h_in;		//[kPa]
 		double m_m_dot_h;		//[kg/s]
 
+		S_node_buffers ms_node_buffers;
+
 	public:
 		C_mono_eq_UA_v_q_enth(int hot_fl_code /*-*/, HTFProperties hot_htf_class,
 			int cold_fl_code /*-*/, HTFProperties cold_htf_class,
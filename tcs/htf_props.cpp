@@ -57,6 +57,11 @@ HTFProperties::HTFProperties()
 	uf_err_msg = "The user-defined htf property table is invalid (rows=%d cols=%d)";
 
 	m_is_temp_enth_avail = false;
+
+	m_is_lookup_req = false;
+	m_is_lookup_avail = false;
+	m_lk_T_min = m_lk_T_max = m_lk_tol = m_lk_inv_dT = std::numeric_limits<double>::quiet_NaN();
+	m_lk_n = 0;
 }
 
 bool HTFProperties::SetUserDefinedFluid(const util::matrix_t<double> &table, bool calc_temp_enth_table)
@@ -97,6 +102,11 @@ bool HTFProperties::SetUserDefinedFluid( const util::matrix_t<double> &table )
 		set_temp_enth_lookup();
 	}
 
+	if( m_is_lookup_req )
+	{
+		build_lookup_tables();
+	}
+
 	return true;
 }
 
@@ -198,9 +208,200 @@ bool HTFProperties::SetFluid( int fluid )
 		set_temp_enth_lookup();
 	}
 
+	if( m_is_lookup_req )
+	{
+		build_lookup_tables();
+	}
+
 	return true;
 }
 
+bool HTFProperties::set_lookup_tables(double T_min_K, double T_max_K, double tol)
+{
+	m_is_lookup_req = true;
+	m_lk_T_min = T_min_K;
+	m_lk_T_max = T_max_K;
+	m_lk_tol = tol;
+
+	return build_lookup_tables();
+}
+
+void HTFProperties::clear_lookup_tables()
+{
+	m_is_lookup_req = false;
+	m_is_lookup_avail = false;
+	m_lk_n = 0;
+	m_lk_cp.clear();
+	m_lk_dens.clear();
+	m_lk_visc.clear();
+	m_lk_cond.clear();
+	m_lk_enth.clear();
+}
+
+static double htf_lookup_source(HTFProperties &htf, int prop, double T_K)
+{
+	switch( prop )
+	{
+	case 0: return htf.Cp(T_K);
+	case 1: return htf.dens(T_K, 0.0);
+	case 2: return htf.visc(T_K);
+	case 3: return htf.cond(T_K);
+	default: return htf.enth(T_K);
+	}
+}
+
+bool HTFProperties::build_lookup_tables()
+{
+	// Tables are filled from the correlations, so lookups must be off while building them
+	m_is_lookup_avail = false;
+
+	std::vector<double> *tables[5] = {&m_lk_cp, &m_lk_dens, &m_lk_visc, &m_lk_cond, &m_lk_enth};
+	for( int k = 0; k < 5; k++ )
+		tables[k]->clear();
+	m_lk_n = 0;
+
+	if( !(m_lk_T_min > 0.0) || !(m_lk_T_max > m_lk_T_min) || !(m_lk_tol > 0.0) )
+		return false;
+
+	// Gas densities depend on pressure and always use the correlations
+	bool is_tab[5] = {true, !(m_fluid == Air || m_fluid == Argon_ideal || m_fluid == Hydrogen_ideal), true, true, true};
+
+	// Start with a coarse grid and double the resolution until linear interpolation between grid points
+	// reproduces the correlations at every interval midpoint
+	std::vector<double> v, v_mid;
+	for( int n_int = 64; n_int <= 65536; n_int *= 2 )
+	{
+		double dT = (m_lk_T_max - m_lk_T_min) / double(n_int);
+		bool is_converged = true;
+
+		for( int k = 0; k < 5 && is_converged; k++ )
+		{
+			if( !is_tab[k] )
+				continue;
+
+			v.resize(n_int + 2);
+			v_mid.resize(n_int);
+			double scale = 0.0;
+			bool is_finite = true;
+			for( int i = 0; i <= n_int && is_finite; i++ )
+			{
+				v[i] = htf_lookup_source(*this, k, m_lk_T_min + dT*i);
+				is_finite = std::isfinite(v[i]);
+				scale = fmax(scale, fabs(v[i]));
+			}
+			v[n_int + 1] = v[n_int];	// pad so the top of the range can be interpolated without a bounds check
+
+			if( !is_finite )
+			{
+				// Property isn't available for this fluid (or range): leave it to the correlations
+				is_tab[k] = false;
+				continue;
+			}
+			if( scale == 0.0 )
+				scale = 1.0;
+
+			double err_max = 0.0;
+			for( int i = 0; i < n_int; i++ )
+			{
+				double v_exact = htf_lookup_source(*this, k, m_lk_T_min + dT*(i + 0.5));
+				err_max = fmax(err_max, fabs(0.5*(v[i] + v[i + 1]) - v_exact));
+			}
+
+			if( err_max / scale > m_lk_tol )
+				is_converged = false;
+			else
+				tables[k]->swap(v);
+		}
+
+		if( !is_converged )
+		{
+			for( int k = 0; k < 5; k++ )
+				tables[k]->clear();
+			continue;
+		}
+
+		m_lk_n = n_int + 1;
+		m_lk_inv_dT = 1.0 / dT;
+		m_is_lookup_avail = true;
+		return true;
+	}
+
+	return false;
+}
+
+double HTFProperties::lookup(const std::vector<double> &table, double T_K)
+{
+	double x = fmin((T_K - m_lk_T_min)*m_lk_inv_dT, double(m_lk_n - 1));
+	int i = (int)x;
+	return table[i] + (x - i)*(table[i + 1] - table[i]);
+}
+
+bool HTFProperties::lookup(const std::vector<double> &table, const double *T_K, double *vals, int n)
+{
+	// Clamp every temperature to the table so the loop has no branches; report whether any fell outside
+	const double *tab = &table[0];
+	double x_max = double(m_lk_n - 1);
+	int n_out = 0;
+	for( int j = 0; j < n; j++ )
+	{
+		double x = fmin(fmax((T_K[j] - m_lk_T_min)*m_lk_inv_dT, 0.0), x_max);
+		int i = (int)x;
+		vals[j] = tab[i] + (x - i)*(tab[i + 1] - tab[i]);
+		n_out += (T_K[j] < m_lk_T_min) | (T_K[j] > m_lk_T_max);
+	}
+	return n_out == 0;
+}
+
+void HTFProperties::Cp(const double *T_K, double *cp, int n)
+{
+	if( !m_is_lookup_avail || m_lk_cp.empty() || !lookup(m_lk_cp, T_K, cp, n) )
+	{
+		for( int j = 0; j < n; j++ )
+			if( !m_is_lookup_avail || m_lk_cp.empty() || !is_in_lookup(T_K[j]) )
+				cp[j] = Cp(T_K[j]);
+	}
+}
+
+void HTFProperties::dens(const double *T_K, double P, double *rho, int n)
+{
+	if( !m_is_lookup_avail || m_lk_dens.empty() || !lookup(m_lk_dens, T_K, rho, n) )
+	{
+		for( int j = 0; j < n; j++ )
+			if( !m_is_lookup_avail || m_lk_dens.empty() || !is_in_lookup(T_K[j]) )
+				rho[j] = dens(T_K[j], P);
+	}
+}
+
+void HTFProperties::visc(const double *T_K, double *mu, int n)
+{
+	if( !m_is_lookup_avail || m_lk_visc.empty() || !lookup(m_lk_visc, T_K, mu, n) )
+	{
+		for( int j = 0; j < n; j++ )
+			if( !m_is_lookup_avail || m_lk_visc.empty() || !is_in_lookup(T_K[j]) )
+				mu[j] = visc(T_K[j]);
+	}
+}
+
+void HTFProperties::cond(const double *T_K, double *k, int n)
+{
+	if( !m_is_lookup_avail || m_lk_cond.empty() || !lookup(m_lk_cond, T_K, k, n) )
+	{
+		for( int j = 0; j < n; j++ )
+			if( !m_is_lookup_avail || m_lk_cond.empty() || !is_in_lookup(T_K[j]) )
+				k[j] = cond(T_K[j]);
+	}
+}
+
+void HTFProperties::enth(const double *T_K, double *h, int n)
+{
+	if( !m_is_lookup_avail || m_lk_enth.empty() || !lookup(m_lk_enth, T_K, h, n) )
+	{
+		for( int j = 0; j < n; j++ )
+			if( !m_is_lookup_avail || m_lk_enth.empty() || !is_in_lookup(T_K[j]) )
+				h[j] = enth(T_K[j]);
+	}
+}
+
 const util::matrix_t<double> *HTFProperties::get_prop_table()
 {
 	return &m_userTable;
@@ -253,6 +454,9 @@ double HTFProperties::Cp( double T_K )
 
 	double T_C = T_K - 273.15;		// Also provide temperature in C
 
+	if( is_in_lookup(T_K) && !m_lk_cp.empty() )
+		return lookup(m_lk_cp, T_K);
+
 	switch(m_fluid)
 	{
 	case Air: 
@@ -332,6 +536,9 @@ double HTFProperties::dens(double T_K, double P)
 
 	double T_C = T_K - 273.15;		// This function accepts as inputs temperature[K]. Convert to [C] for correlations
 
+	if( is_in_lookup(T_K) && !m_lk_dens.empty() )
+		return lookup(m_lk_dens, T_K);
+
 	switch(m_fluid)
 	{
 		case Air:
@@ -410,6 +617,9 @@ double HTFProperties::visc(double T_K)
 
 	double T_C = T_K - 273.15;		// This function accepts as inputs temperature[K]. Convert to [C] for correlations
 
+	if( is_in_lookup(T_K) && !m_lk_visc.empty() )
+		return lookup(m_lk_visc, T_K);
+
 	switch(m_fluid)
 	{
 	case Air:
@@ -497,6 +707,9 @@ double HTFProperties::cond(double T_K)
 
 	double T_C = T_K - 273.15;
 
+	if( is_in_lookup(T_K) && !m_lk_cond.empty() )
+		return lookup(m_lk_cond, T_K);
+
 	switch(m_fluid)
 	{
 	case Air:
@@ -615,6 +828,9 @@ double HTFProperties::enth(double T_K)
 
 	double T_C = T_K - 273.15;
 
+	if( is_in_lookup(T_K) && !m_lk_enth.empty() )
+		return lookup(m_lk_enth, T_K);
+
 	switch(m_fluid)
 	{
 	case Nitrate_Salt:
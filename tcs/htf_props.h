@@ -53,6 +53,7 @@
 
 #include "interpolation_routines.h"
 #include <limits>
+#include <vector>
 
 class HTFProperties
 {
@@ -131,6 +132,21 @@ public:
 	//               rather than at the range's midpoint
 	double Cp_ave(double T_cold_K, double T_hot_K, int n_points);
 
+	// Optional property tables on a uniform temperature grid. Once set, Cp, dens, visc, cond, and enth are
+	// interpolated from the tables within [T_min_K, T_max_K] and evaluated from the correlations outside of it.
+	// The grid is refined until the interpolation error is below 'tol' relative to each property's magnitude.
+	// Tables are rebuilt whenever the fluid is changed
+	bool set_lookup_tables( double T_min_K, double T_max_K, double tol = 1.E-5 );
+	void clear_lookup_tables();
+	bool is_lookup_tables_avail() { return m_is_lookup_avail; }
+
+	// Evaluate properties for 'n' temperatures [K] at once
+	void Cp( const double *T_K, double *cp, int n );
+	void dens( const double *T_K, double P, double *rho, int n );
+	void visc( const double *T_K, double *mu, int n );
+	void cond( const double *T_K, double *k, int n );
+	void enth( const double *T_K, double *h, int n );
+
 	const util::matrix_t<double> *get_prop_table();
 	//bool equals(const util::matrix_t<double> *comp_table);
 	bool equals(HTFProperties *comp_class);
@@ -144,6 +160,20 @@ private:
 	void set_temp_enth_lookup();
 	bool m_is_temp_enth_avail;
 
+	bool m_is_lookup_req;		// Lookup tables were requested by the caller
+	bool m_is_lookup_avail;		// Lookup tables are built for the current fluid
+	double m_lk_T_min;			//[K] Lowest temperature in the lookup tables
+	double m_lk_T_max;			//[K] Highest temperature in the lookup tables
+	double m_lk_tol;			//[-] Requested interpolation tolerance
+	double m_lk_inv_dT;			//[1/K] Inverse of the lookup table temperature spacing
+	int m_lk_n;					// Number of temperatures in the lookup tables
+	// Property values at each table temperature, padded with one repeated value at the end. Empty if the property isn't tabulated
+	std::vector<double> m_lk_cp, m_lk_dens, m_lk_visc, m_lk_cond, m_lk_enth;
+	bool build_lookup_tables();
+	bool is_in_lookup( double T_K ) { return m_is_lookup_avail && T_K >= m_lk_T_min && T_K <= m_lk_T_max; }
+	double lookup( const std::vector<double> &table, double T_K );
+	bool lookup( const std::vector<double> &table, const double *T_K, double *vals, int n );
+
 	int m_fluid;	// Store fluid number as member integer
 	util::matrix_t<double> m_userTable;	// User table of properties
 
@@ -684,7 +684,91 @@ GaussMarkov::~GaussMarkov() {
         delete vi; 
 }
 
+void GaussMarkov::precompute_grid(const std::vector<int> &n_per_dim) {
+    int i,j;
+    if (n_per_dim.size() != static_cast<size_t>(ndim))
+        throw("GaussMarkov::precompute_grid bad sizes");
+
+    grid_n = n_per_dim;
+    grid_stride.resize(ndim);
+    grid_lo.resize(ndim);
+    grid_hi.resize(ndim);
+    grid_inv_step.resize(ndim);
+
+    int ngrid = 1;
+    for (j=ndim-1;j>=0;j--) {
+        if (grid_n[j] < 1)
+            throw("GaussMarkov::precompute_grid needs at least one point per dimension");
+        grid_lo[j] = grid_hi[j] = x.front().at(j);
+        for (i=1;i<npt;i++) {
+            grid_lo[j] = fmin(grid_lo[j], x.at(i).at(j));
+            grid_hi[j] = fmax(grid_hi[j], x.at(i).at(j));
+        }
+        // A dimension without spread only needs one grid point
+        if (grid_hi[j] <= grid_lo[j]) grid_n[j] = 1;
+        grid_inv_step[j] = grid_n[j] > 1 ? (grid_n[j]-1)/(grid_hi[j]-grid_lo[j]) : 0.;
+        grid_stride[j] = ngrid;
+        ngrid *= grid_n[j];
+    }
+
+    grid_vals.resize(ngrid);
+    VectDoub xgrid(ndim);
+    for (i=0;i<ngrid;i++) {
+        for (j=0;j<ndim;j++) {
+            int k = (i/grid_stride[j]) % grid_n[j];
+            xgrid[j] = grid_n[j] > 1 ? grid_lo[j] + k/grid_inv_step[j] : grid_lo[j];
+        }
+        grid_vals[i] = interp_kriged(xgrid);
+    }
+}
+
 double GaussMarkov::interp(VectDoub &xstar) {
+    if (grid_vals.empty())
+        return interp_kriged(xstar);
+
+    const int maxdim = 8;
+    if (ndim > maxdim)
+        return interp_kriged(xstar);
+
+    // Find the grid cell and fractional position in each dimension, and leave points outside the grid to kriging
+    int icell[maxdim];
+    double frac[maxdim];
+    for (int j=0;j<ndim;j++) {
+        if (!(xstar[j] >= grid_lo[j] && xstar[j] <= grid_hi[j]))
+            return interp_kriged(xstar);
+        if (grid_n[j] > 1) {
+            double u = (xstar[j]-grid_lo[j])*grid_inv_step[j];
+            icell[j] = std::min((int)u, grid_n[j]-2);
+            frac[j] = u - icell[j];
+        }
+        else {
+            icell[j] = 0;
+            frac[j] = 0.;
+        }
+    }
+
+    // Multilinear interpolation over the corners of the cell
+    lastval = 0.;
+    for (int c=0;c<(1<<ndim);c++) {
+        double w = 1.;
+        int idx = 0;
+        for (int j=0;j<ndim;j++) {
+            if (c & (1<<j)) {
+                if (grid_n[j] == 1) { w = 0.; break; }
+                w *= frac[j];
+                idx += (icell[j]+1)*grid_stride[j];
+            }
+            else {
+                w *= 1.-frac[j];
+                idx += icell[j]*grid_stride[j];
+            }
+        }
+        if (w != 0.) lastval += w*grid_vals[idx];
+    }
+    return lastval;
+}
+
+double GaussMarkov::interp_kriged(VectDoub &xstar) {
     int i;
     for (i=0;i<npt;i++) vstar[i] = vgram(rdist(&xstar,&x.at(i)));
     vstar[npt] = 1.;
@@ -693,8 +777,17 @@ double GaussMarkov::interp(VectDoub &xstar) {
     return lastval;
 }
 
+double GaussMarkov::grid_max_error() {
+    double errmax = 0.;
+    for (int i=0;i<npt;i++) {
+        double zgrid = interp(x.at(i));
+        errmax = fmax(errmax, fabs(zgrid - interp_kriged(x.at(i))));
+    }
+    return errmax;
+}
+
 double GaussMarkov::interp(VectDoub &xstar, double &esterr) {
-    lastval = interp(xstar);
+    lastval = interp_kriged(xstar);
     vi->solve(vstar,dstar);
     lasterr = 0;
     for (int i=0;i<=npt;i++) lasterr += dstar[i]*vstar[i];
@@ -192,6 +192,10 @@ struct GaussMarkov {
     VectDoub y,dstar,vstar,yvi;
     MatDoub v;
     LUdcmp *vi;
+
+    // Kriged values on a regular grid spanning the bounds of 'x', filled by precompute_grid()
+    std::vector<int> grid_n, grid_stride;
+    VectDoub grid_lo, grid_hi, grid_inv_step, grid_vals;
     
 	double SQR( const double a );
 
@@ -200,10 +204,21 @@ struct GaussMarkov {
 
     ~GaussMarkov();
 
+    // Evaluates the kriged surface at 'n_per_dim' evenly spaced points per dimension over the bounds of 'x'.
+    // After this call, interp(xstar) interpolates the grid linearly in O(1) for points inside the bounds
+    void precompute_grid(const std::vector<int> &n_per_dim);
+
+    // Uses the precomputed grid when available and 'xstar' is inside it, otherwise interp_kriged()
     double interp(VectDoub &xstar);
 
+    // Full O(npt) kriging estimate. Reference for the precomputed grid
+    double interp_kriged(VectDoub &xstar);
+
     double interp(VectDoub &xstar, double &esterr);
 
+    // Maximum absolute difference between the precomputed grid and the kriged surface at the data points
+    double grid_max_error();
+
     double rdist(VectDoub *x1, VectDoub *x2);
 };
 
@@ -194,6 +194,7 @@ enum{	//Parameters
 		P_v_wind_max, 
 		P_interp_nug, 
 		P_interp_beta, 
+		P_is_eta_map_grid,
 		P_n_flux_x, 
 		P_n_flux_y, 
 		P_helio_positions, 
@@ -255,6 +256,7 @@ tcsvarinfo sam_mw_pt_heliostatfield_variables[] = {
     { TCS_PARAM,    TCS_NUMBER,   P_v_wind_max,              "v_wind_max",            "Max. wind velocity",                                   "m/s",    "",                              "", ""          },
     { TCS_PARAM,    TCS_NUMBER,   P_interp_nug,              "interp_nug",            "Interpolation nugget",                                 "-",      "",                              "", "0.0"       },
     { TCS_PARAM,    TCS_NUMBER,   P_interp_beta,             "interp_beta",           "Interpolation beta coef.",                             "-",      "",                              "", "1.99"      },
+    { TCS_PARAM,    TCS_NUMBER,   P_is_eta_map_grid,         "is_eta_map_grid",       "Precompute the efficiency interpolation on a grid",    "-",      "",                              "", "1"         },
     { TCS_PARAM,    TCS_NUMBER,   P_n_flux_x,                "n_flux_x",              "Flux map X resolution",                                "-",      "",                              "", ""          },
     { TCS_PARAM,    TCS_NUMBER,   P_n_flux_y,                "n_flux_y",              "Flux map Y resolution",                                "-",      "",                              "", ""          },
     { TCS_PARAM,    TCS_MATRIX,   P_helio_positions,         "helio_positions",       "Heliostat position table",                             "m",      "",                              "", ""          },
@@ -875,12 +877,21 @@ public:
 		Powvargram vgram(sunpos, effs, interp_beta, interp_nug);
 		field_efficiency_table = new GaussMarkov(sunpos, effs, vgram);
 
+		//precompute the fit on a ~2 deg azimuth by ~1 deg zenith grid so each call is a table lookup
+		if( value(P_is_eta_map_grid) != 0 )
+		{
+			std::vector<int> n_grid(2);
+			n_grid.at(0) = 181;
+			n_grid.at(1) = 91;
+			field_efficiency_table->precompute_grid(n_grid);
+		}
+
 		//test how well the fit matches the data
 		double err_fit = 0.;
 		int npoints = (int)sunpos.size();
 		for(int i=0; i<npoints; i++){
 			double zref = effs.at(i);
-			double zfit = field_efficiency_table->interp( sunpos.at(i) );
+			double zfit = field_efficiency_table->interp_kriged( sunpos.at(i) );
 			double dz = zref - zfit;
 			err_fit += dz * dz;
 		}
@@ -888,6 +899,10 @@ public:
 		if( err_fit > 0.01 )
 			message(TCS_WARNING, "The heliostat field interpolation function fit is poor! (err_fit=%f RMS)", err_fit);
 
+		double err_grid = field_efficiency_table->grid_max_error() * eff_scale;
+		if( err_grid > 0.001 )
+			message(TCS_WARNING, "The heliostat field efficiency grid differs from the interpolation function by up to %f", err_grid);
+
 		// Initialize stored variables
 		eta_prev = 0.0;
 		v_wind_prev = 0.0;
@@ -244,6 +244,7 @@ enum{	//Parameters
 		P_v_wind_max, 
 		P_interp_nug, 
 		P_interp_beta, 
+		P_is_eta_map_grid,
 		P_n_flux_x, 
 		P_n_flux_y, 
 		P_helio_positions, 
@@ -307,6 +308,7 @@ tcsvarinfo sam_mw_pt_heliostatfield_variables[] = {
     { TCS_PARAM,    TCS_NUMBER,   P_v_wind_max,              "v_wind_max",            "Max. wind velocity",                                   "m/s",    "",                              "", ""          },
     { TCS_PARAM,    TCS_NUMBER,   P_interp_nug,              "interp_nug",            "Interpolation nugget",                                 "-",      "",                              "", "0.0"       },
     { TCS_PARAM,    TCS_NUMBER,   P_interp_beta,             "interp_beta",           "Interpolation beta coef.",                             "-",      "",                              "", "1.99"      },
+    { TCS_PARAM,    TCS_NUMBER,   P_is_eta_map_grid,         "is_eta_map_grid",       "Precompute the efficiency interpolation on a grid",    "-",      "",                              "", "1"         },
     { TCS_PARAM,    TCS_NUMBER,   P_n_flux_x,                "n_flux_x",              "Flux map X resolution",                                "-",      "",                              "", ""          },
     { TCS_PARAM,    TCS_NUMBER,   P_n_flux_y,                "n_flux_y",              "Flux map Y resolution",                                "-",      "",                              "", ""          },
     { TCS_PARAM,    TCS_MATRIX,   P_helio_positions,         "helio_positions",       "Heliostat position table",                             "m",      "",                              "", ""          },
@@ -421,6 +423,7 @@ public:
 		mc_heliostatfield.ms_params.m_v_wind_max = value(P_v_wind_max);
 		mc_heliostatfield.ms_params.m_interp_nug = value(P_interp_nug);
 		mc_heliostatfield.ms_params.m_interp_beta = value(P_interp_beta);
+		mc_heliostatfield.ms_params.m_is_eta_map_grid = value(P_is_eta_map_grid) != 0;
 		mc_heliostatfield.ms_params.m_n_flux_x = (int)value(P_n_flux_x);
 		mc_heliostatfield.ms_params.m_n_flux_y = (int)value(P_n_flux_y);
 
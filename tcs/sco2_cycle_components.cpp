@@ -2,6 +2,11 @@
 #include "CO2_properties.h"
 #include <limits>
 #include <algorithm>
+#include <random>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
 
 #include "numeric_solvers.h"
 #include "csp_solver_core.h"
@@ -775,6 +780,77 @@ int Ph_dome(double P_low /*MPa*/, std::vector<double> & P_data /*MPa*/, std::vec
 	return Ts_full_dome(T_P_target_solved - 273.15, T_data, s_data, P_data, h_data);
 }
 
+std::vector<std::vector<double>> latin_hypercube_samples(const std::vector<double> & lb, const std::vector<double> & ub,
+	int n_samples, unsigned int seed)
+{
+	std::vector<std::vector<double>> samples(std::max(0, n_samples), std::vector<double>(lb.size()));
+	if (n_samples < 1)
+		return samples;
+
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<double> dist(0.0, 1.0);
+	std::vector<int> strata(n_samples);
+
+	// Each dimension places one sample in each of 'n_samples' equal intervals, in random order
+	for (size_t d = 0; d < lb.size(); d++)
+	{
+		for (int i = 0; i < n_samples; i++)
+			strata[i] = i;
+		std::shuffle(strata.begin(), strata.end(), rng);
+
+		for (int i = 0; i < n_samples; i++)
+		{
+			samples[i][d] = lb[d] + (ub[d] - lb[d]) * (strata[i] + dist(rng)) / (double)n_samples;
+		}
+	}
+
+	return samples;
+}
+
+void run_parallel_tasks(int n_tasks, int n_threads, const std::function<void(int)> & task)
+{
+	int n_workers = (n_threads > 0) ? n_threads : (int)std::thread::hardware_concurrency();
+	n_workers = std::max(1, std::min(n_workers, n_tasks));
+
+	std::mutex mtx_exception;
+	std::exception_ptr p_task_exception;
+	std::atomic<int> next_task(0);
+
+	auto worker = [&]()
+	{
+		for (int i = next_task++; i < n_tasks; i = next_task++)
+		{
+			try
+			{
+				task(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(mtx_exception);
+				if (!p_task_exception)
+					p_task_exception = std::current_exception();
+				next_task = n_tasks;
+			}
+		}
+	};
+
+	if (n_workers == 1)
+	{
+		worker();
+	}
+	else
+	{
+		std::vector<std::thread> threads;
+		for (int w = 0; w < n_workers; w++)
+			threads.push_back(std::thread(worker));
+		for (size_t w = 0; w < threads.size(); w++)
+			threads[w].join();
+	}
+
+	if (p_task_exception)
+		std::rethrow_exception(p_task_exception);
+}
+
 int C_MEQ_CO2_props_at_2phase_P::operator()(double T_co2 /*K*/, double *P_calc /*kPa*/)
 {
 	int prop_err_code = CO2_TQ(T_co2, 0.0, &mc_co2_props);
@@ -2,6 +2,7 @@
 #define __SCO2_CYCLE_COMPONENTS_
 
 #include <vector>
+#include <functional>
 
 #include "numeric_solvers.h"
 #include "CO2_properties.h"
@@ -69,6 +70,14 @@ int Ts_full_dome(double T_cold /*C*/, std::vector<double> & T_data /*C*/, std::v
 
 int Ph_dome(double P_low /*MPa*/, std::vector<double> & P_data /*MPa*/, std::vector<double> & h_data);
 
+// Latin hypercube sample of 'n_samples' points between 'lb' and 'ub'. The same seed always returns the same points
+std::vector<std::vector<double>> latin_hypercube_samples(const std::vector<double> & lb, const std::vector<double> & ub,
+	int n_samples, unsigned int seed = 0);
+
+// Calls 'task' for each index in [0, n_tasks) on up to 'n_threads' threads (<= 0 uses all hardware threads)
+// Rethrows the first exception thrown by a task after all threads finish
+void run_parallel_tasks(int n_tasks, int n_threads, const std::function<void(int)> & task);
+
 class C_MEQ_CO2_props_at_2phase_P : public C_monotonic_equation
 {
 private:
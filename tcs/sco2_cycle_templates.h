@@ -124,6 +124,9 @@ public:
 		double m_PR_mc_guess;				//[-] Initial guess for ratio of P_mc_out to P_mc_in
 		bool m_fixed_PR_mc;					//[-] if true, ratio of P_mc_out to P_mc_in is fixed at PR_mc_guess
 
+		int m_n_multi_start;				//[-] Number of optimization starting points. > 1 runs independent optimizations from Latin hypercube starting points
+		int m_n_threads;					//[-] Number of threads for multi-start optimization. <= 0 uses all hardware threads
+
 		// Callback function only log
 		bool(*mf_callback_log)(std::string &log_msg, std::string &progress_msg, void *data, double progress, int out_type);
 		void *mp_mf_active;
@@ -147,6 +150,9 @@ public:
 			m_fixed_PR_mc = false;		//[-] If false, then should default to optimizing this parameter
 			m_fixed_P_mc_out = false;	//[-] If fasle, then should default to optimizing this parameter
 
+			m_n_multi_start = 1;		//[-] Default to single optimization from the built-in starting point
+			m_n_threads = 0;			//[-]
+
 			mf_callback_log = 0;
 			mp_mf_active = 0;
 
@@ -199,6 +205,9 @@ public:
 
 		double m_PR_mc_guess;				//[-] Initial guess for ratio of P_mc_out to P_mc_in
 		bool m_fixed_PR_mc;					//[-] if true, ratio of P_mc_out to P_mc_in is fixed at PR_mc_guess
+
+		int m_n_multi_start;				//[-] Number of optimization starting points. > 1 runs independent optimizations from Latin hypercube starting points
+		int m_n_threads;					//[-] Number of threads for multi-start optimization. <= 0 uses all hardware threads
 		
 		int m_des_objective_type;		//[2] = min phx deltat then max eta, [else] max eta
 		double m_min_phx_deltaT;		//[C]
@@ -222,6 +231,9 @@ public:
 			m_fixed_PR_mc = false;		//[-] If false, then should default to optimizing this parameter
 			m_fixed_P_mc_out = false;	//[-] If fasle, then should default to optimizing this parameter
 
+			m_n_multi_start = 1;		//[-] Default to single optimization from the built-in starting point
+			m_n_threads = 0;			//[-]
+
 			// Default to standard optimization to maximize cycle efficiency
 			m_des_objective_type = 1;
 			m_min_phx_deltaT = 0.0;		//[C]
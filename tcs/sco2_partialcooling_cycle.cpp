@@ -653,6 +653,11 @@ int C_PartialCooling_Cycle::finalize_design()
 
 double C_PartialCooling_Cycle::design_cycle_return_objective_metric(const std::vector<double> &x)
 {
+	// Skip designs that this optimization already evaluated
+	std::map<std::vector<double>, double>::const_iterator it_cached = m_objective_metric_cache.find(x);
+	if (it_cached != m_objective_metric_cache.end())
+		return it_cached->second;
+
 	int index = 0;
 
 	// Main compressor outlet pressure
@@ -749,6 +754,8 @@ double C_PartialCooling_Cycle::design_cycle_return_objective_metric(const std::v
 		}
 	}
 
+	m_objective_metric_cache[x] = objective_metric;
+
 	return objective_metric;
 }
 
@@ -840,6 +847,9 @@ int C_PartialCooling_Cycle::opt_design_core()
 		index++;
 	}
 
+	// Designs evaluated by a previous optimization used different fixed parameters
+	m_objective_metric_cache.clear();
+
 	int no_opt_err_code = 0;
 	if (index > 0)
 	{
@@ -938,6 +948,9 @@ int C_PartialCooling_Cycle::auto_opt_design_core()
 	// Outer optimization loop
 	m_objective_metric_auto_opt = 0.0;
 
+	// Starting point for the multi-start optimizations, before the single-start search below changes 'ms_opt_des_par'
+	S_opt_des_params opt_des_par_base = ms_opt_des_par;
+
 	double best_P_high = ms_auto_opt_des_par.m_P_high_limit;
 	if (!ms_opt_des_par.m_fixed_P_mc_out)
 	{
@@ -980,6 +993,12 @@ int C_PartialCooling_Cycle::auto_opt_design_core()
 		m_objective_metric_auto_opt = m_objective_metric_opt;
 	}
 
+	// Other starting points can only replace the single-start design with a better one
+	if (ms_auto_opt_des_par.m_n_multi_start > 1)
+	{
+		multi_start_auto_opt_design(opt_des_par_base);
+	}
+
 	ms_des_par = ms_des_par_auto_opt;
 
 	int pc_opt_des_error_code = design_core();
@@ -994,6 +1013,89 @@ int C_PartialCooling_Cycle::auto_opt_design_core()
 	return pc_opt_des_error_code;
 }
 
+void C_PartialCooling_Cycle::multi_start_auto_opt_design(const S_opt_des_params & opt_des_par_base)
+{
+	// Optimizes the cycle from a Latin hypercube sample of 'm_n_multi_start' - 1 starting points, in addition to the
+	// single-start search in auto_opt_design_core. Each optimization runs on its own copy of this cycle, and a design
+	// replaces the current optimum only if it is better:
+		// ms_des_par_auto_opt
+		// m_objective_metric_auto_opt
+	double P_low_limit = std::min(ms_auto_opt_des_par.m_P_high_limit, std::max(10.E3, ms_auto_opt_des_par.m_P_high_limit*0.2));		//[kPa]
+
+	S_opt_des_params opt_des_par_start = opt_des_par_base;
+	opt_des_par_start.m_P_mc_out_guess = ms_auto_opt_des_par.m_P_high_limit;	//[kPa]
+	if (opt_des_par_start.m_fixed_PR_total)
+	{
+		opt_des_par_start.m_PR_total_guess = ms_auto_opt_des_par.m_PR_mc_guess;	//[-]
+	}
+	else
+	{
+		opt_des_par_start.m_PR_total_guess = 25. / 6.5;	//[-]
+	}
+
+	opt_des_par_start.m_fixed_f_PR_mc = false;
+	opt_des_par_start.m_f_PR_mc_guess = (25. - 8.5) / (25. - 6.5);		//[-]
+
+	opt_des_par_start.m_recomp_frac_guess = 0.25;	//[-]
+	opt_des_par_start.m_fixed_recomp_frac = false;
+
+	opt_des_par_start.m_LTR_frac_guess = 0.5;		//[-]
+	opt_des_par_start.m_fixed_LTR_frac = false;
+
+	// Sample: main compressor outlet pressure [kPa], total pressure ratio relative to the default guess [-],
+	//    fraction of pressure rise in the main compressor [-], recompression fraction [-], and fraction of recuperator UA in the LTR [-]
+	std::vector<double> lb(5);
+	std::vector<double> ub(5);
+	lb[0] = P_low_limit;	ub[0] = ms_auto_opt_des_par.m_P_high_limit;
+	lb[1] = 0.7;			ub[1] = 1.3;
+	lb[2] = 0.1;			ub[2] = 0.9;
+	lb[3] = 0.0;			ub[3] = 0.6;
+	lb[4] = 0.1;			ub[4] = 0.9;
+
+	std::vector<std::vector<double>> starts = latin_hypercube_samples(lb, ub, ms_auto_opt_des_par.m_n_multi_start - 1);
+
+	std::vector<S_opt_des_params> v_opt_des_par;
+	for (size_t i = 0; i < starts.size(); i++)
+	{
+		S_opt_des_params opt_des_par_i = opt_des_par_start;
+		if (!opt_des_par_i.m_fixed_P_mc_out)
+			opt_des_par_i.m_P_mc_out_guess = starts[i][0];		//[kPa]
+		if (!opt_des_par_i.m_fixed_PR_total)
+			opt_des_par_i.m_PR_total_guess = starts[i][1] * opt_des_par_start.m_PR_total_guess;	//[-]
+		opt_des_par_i.m_f_PR_mc_guess = starts[i][2];		//[-]
+		opt_des_par_i.m_recomp_frac_guess = starts[i][3];	//[-]
+		opt_des_par_i.m_LTR_frac_guess = starts[i][4];		//[-]
+
+		v_opt_des_par.push_back(opt_des_par_i);
+	}
+
+	int n_opt = (int)v_opt_des_par.size();
+	std::vector<int> v_error_code(n_opt, -1);
+	std::vector<double> v_objective_metric(n_opt, 0.0);
+	std::vector<S_des_params> v_des_par_optimal(n_opt);
+
+	run_parallel_tasks(n_opt, ms_auto_opt_des_par.m_n_threads, [&](int i)
+	{
+		C_PartialCooling_Cycle c_cycle(*this);
+		c_cycle.ms_opt_des_par = v_opt_des_par[i];
+
+		v_error_code[i] = c_cycle.opt_design_core();
+
+		v_objective_metric[i] = c_cycle.m_objective_metric_opt;
+		v_des_par_optimal[i] = c_cycle.ms_des_par_optimal;
+	});
+
+	// Ties go to the single-start design and then to the earlier starting point, so the result doesn't depend on the number of threads
+	for (int i = 0; i < n_opt; i++)
+	{
+		if (v_error_code[i] == 0 && v_objective_metric[i] > m_objective_metric_auto_opt)
+		{
+			ms_des_par_auto_opt = v_des_par_optimal[i];
+			m_objective_metric_auto_opt = v_objective_metric[i];
+		}
+	}
+}
+
 int C_PartialCooling_Cycle::auto_opt_design_hit_eta(S_auto_opt_design_hit_eta_parameters & auto_opt_des_hit_eta_in, std::string & error_msg)
 {
 	ms_auto_opt_des_par.m_W_dot_net = auto_opt_des_hit_eta_in.m_W_dot_net;	//[kWe]
@@ -1035,6 +1137,9 @@ int C_PartialCooling_Cycle::auto_opt_design_hit_eta(S_auto_opt_design_hit_eta_pa
 	ms_auto_opt_des_par.m_fixed_PR_mc = auto_opt_des_hit_eta_in.m_fixed_PR_mc;			//[-]
 	ms_auto_opt_des_par.m_PR_mc_guess = auto_opt_des_hit_eta_in.m_fixed_PR_mc;		//[-]
 
+	ms_auto_opt_des_par.m_n_multi_start = auto_opt_des_hit_eta_in.m_n_multi_start;	//[-]
+	ms_auto_opt_des_par.m_n_threads = auto_opt_des_hit_eta_in.m_n_threads;			//[-]
+
 	// At this point, 'auto_opt_des_hit_eta_in' should only be used to access the targer thermal efficiency: 'm_eta_thermal'
 
 	double Q_dot_rec_des = ms_auto_opt_des_par.m_W_dot_net / auto_opt_des_hit_eta_in.m_eta_thermal;		//[kWt] Receiver thermal input at design
@@ -58,6 +58,7 @@
 
 #include <string>
 #include <vector>
+#include <map>
 #include <math.h>
 #include <limits>
 
@@ -243,6 +244,7 @@ private:
 	// Structures and data for optimization
 	S_des_params ms_des_par_optimal;
 	double m_objective_metric_opt;
+	std::map<std::vector<double>, double> m_objective_metric_cache;	// Objective metric of each design evaluated by the current optimization
 
 		// Structures and data for auto-optimization
 	double m_objective_metric_auto_opt;
@@ -258,6 +260,8 @@ private:
 
 	int auto_opt_design_core();
 
+	void multi_start_auto_opt_design(const S_opt_des_params & opt_des_par_base);
+
 	int finalize_design();
 
 	int opt_design_core();
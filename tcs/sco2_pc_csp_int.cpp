@@ -158,6 +158,9 @@ void C_sco2_recomp_csp::design_core()
 		ms_cycle_des_par.m_PR_mc_guess = ms_des_par.m_PR_mc_guess;		//[-]
 		ms_cycle_des_par.m_fixed_PR_mc = ms_des_par.m_fixed_PR_mc;		//[-]
 
+		ms_cycle_des_par.m_n_multi_start = ms_des_par.m_n_multi_start;	//[-]
+		ms_cycle_des_par.m_n_threads = ms_des_par.m_n_threads;			//[-]
+
 		ms_cycle_des_par.mf_callback_log = mf_callback_update;
 		ms_cycle_des_par.mp_mf_active = mp_mf_update;
 
@@ -214,6 +217,9 @@ void C_sco2_recomp_csp::design_core()
 		des_params.m_PR_mc_guess = ms_des_par.m_PR_mc_guess;		//[-]
 		des_params.m_fixed_PR_mc = ms_des_par.m_fixed_PR_mc;		//[-]
 
+		des_params.m_n_multi_start = ms_des_par.m_n_multi_start;	//[-]
+		des_params.m_n_threads = ms_des_par.m_n_threads;			//[-]
+
 		des_params.m_is_recomp_ok = ms_des_par.m_is_recomp_ok;
 
 		auto_err_code = mpc_sco2_cycle->auto_opt_design(des_params);
@@ -481,13 +487,8 @@ int C_sco2_recomp_csp::optimize_off_design(C_sco2_recomp_csp::S_od_par od_par, i
 	return 0;
 }
 
-int C_sco2_recomp_csp::opt_P_LP_comp_in__fixed_N_turbo()
+double C_sco2_recomp_csp::get_P_LP_in_at_des_dens()
 {
-	// Prior to calling, need to set :
-	//	*ms_od_par, ms_rc_cycle_od_phi_par, ms_phx_od_par, ms_od_op_inputs(will set P_mc_in here and f_recomp downstream)
-	
-	double W_dot_target = (ms_od_par.m_m_dot_htf / ms_phx_des_par.m_m_dot_hot_des) * ms_des_par.m_W_dot_net;	//[kWe]
-
 	// Get density at design point
 	double mc_dens_in_des = std::numeric_limits<double>::quiet_NaN();
 	
@@ -499,7 +500,22 @@ int C_sco2_recomp_csp::opt_P_LP_comp_in__fixed_N_turbo()
 	CO2_state co2_props;
 	// Then calculate the compressor inlet pressure that achieves this density at the off-design ambient temperature
 	CO2_TD(ms_cycle_od_par.m_T_mc_in, mc_dens_in_des, &co2_props);
-	double mc_pres_dens_des_od = co2_props.pres;	//[kPa]
+	
+	return co2_props.pres;	//[kPa]
+}
+
+int C_sco2_recomp_csp::opt_P_LP_comp_in__fixed_N_turbo()
+{
+	// Prior to calling, need to set :
+	//	*ms_od_par, ms_rc_cycle_od_phi_par, ms_phx_od_par, ms_od_op_inputs(will set P_mc_in here and f_recomp downstream)
+	
+	double W_dot_target = (ms_od_par.m_m_dot_htf / ms_phx_des_par.m_m_dot_hot_des) * ms_des_par.m_W_dot_net;	//[kWe]
+
+	// Start at the compressor inlet pressure that achieves the design density at the off-design inlet temperature
+	// ... scaled by the warm start from a neighbouring solution, if available
+	double mc_pres_dens_des_od = get_P_LP_in_at_des_dens();	//[kPa]
+	if (std::isfinite(ms_od_par.m_f_P_LP_in_guess))
+		mc_pres_dens_des_od *= ms_od_par.m_f_P_LP_in_guess;	//[kPa]
 	ms_cycle_od_par.m_P_LP_comp_in = mc_pres_dens_des_od;	//[kPa]
 
 	bool is_find_P_LP_in_range = true;
@@ -1183,6 +1199,8 @@ int C_sco2_recomp_csp::C_sco2_csp_od::operator()(S_f_inputs inputs, S_f_outputs
 	sco2_od_par.m_T_htf_hot = inputs.m_T_htf_hot + 273.15;	//[K] convert from C
 	sco2_od_par.m_m_dot_htf = mpc_sco2_rc->get_phx_des_par()->m_m_dot_hot_des*inputs.m_m_dot_htf_ND;	//[kg/s] scale from [-]
 	sco2_od_par.m_T_amb = inputs.m_T_amb + 273.15;			//[K] convert from C
+	if (inputs.m_x_warm_start.size() == 1)
+		sco2_od_par.m_f_P_LP_in_guess = inputs.m_x_warm_start[0];	//[-]
 
 	int od_strategy = C_sco2_recomp_csp::E_TARGET_POWER_ETA_MAX;
 
@@ -1215,13 +1233,36 @@ int C_sco2_recomp_csp::C_sco2_csp_od::operator()(S_f_inputs inputs, S_f_outputs
 
 	outputs.m_m_dot_water_ND = 1.0;	
 
+	// Solved compressor inlet pressure relative to the design density pressure is a good start for nearby points
+	outputs.m_x_solved.assign(1, mpc_sco2_rc->ms_cycle_od_par.m_P_LP_comp_in / mpc_sco2_rc->get_P_LP_in_at_des_dens());	//[-]
+
 	return off_design_code;
 }
 
+C_od_pc_function * C_sco2_recomp_csp::C_sco2_csp_od::clone()
+{
+	// Redesign from the same parameters so the copy doesn't share any solver state with this cycle
+	C_sco2_csp_od *p_copy = new C_sco2_csp_od(0);
+	p_copy->mpc_sco2_rc_copy.reset(new C_sco2_recomp_csp());
+	p_copy->mpc_sco2_rc = p_copy->mpc_sco2_rc_copy.get();
+	try
+	{
+		p_copy->mpc_sco2_rc->design(*mpc_sco2_rc->get_design_par());
+	}
+	catch (...)
+	{
+		delete p_copy;
+		throw;
+	}
+
+	return p_copy;
+}
+
 int C_sco2_recomp_csp::generate_ud_pc_tables(double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 	double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 	double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
-	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind)
+	util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind,
+	int n_threads, bool is_warm_start, std::string checkpoint_file)
 {
 	C_sco2_csp_od c_sco2_csp(this);
 	C_ud_pc_table_generator c_sco2_ud_pc(c_sco2_csp);
@@ -1229,6 +1270,10 @@ int C_sco2_recomp_csp::generate_ud_pc_tables(double T_htf_low /*C*/, double T_ht
 	c_sco2_ud_pc.mf_callback = mf_callback_update;
 	c_sco2_ud_pc.mp_mf_active = mp_mf_update;
 
+	c_sco2_ud_pc.m_n_threads = n_threads;
+	c_sco2_ud_pc.m_is_warm_start = is_warm_start;
+	c_sco2_ud_pc.m_checkpoint_file = checkpoint_file;
+
 	double T_htf_ref = ms_des_par.m_T_htf_hot_in - 273.15;	//[C] convert from K
 	double T_amb_ref = ms_des_par.m_T_amb_des - 273.15;		//[C] convert from K
 	double m_dot_htf_ND_ref = 1.0;							//[-]
@@ -1238,6 +1283,8 @@ int C_sco2_recomp_csp::generate_ud_pc_tables(double T_htf_low /*C*/, double T_ht
 								m_dot_htf_ND_ref, m_dot_htf_ND_low, m_dot_htf_ND_high, n_m_dot_htf_ND,
 								T_htf_ind, T_amb_ind, m_dot_htf_ND_ind);
 
+	mc_messages.transfer_messages(c_sco2_ud_pc.mc_messages);
+
 	return ud_pc_error_code;
 }
 
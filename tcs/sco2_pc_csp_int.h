@@ -64,6 +64,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 class C_sco2_recomp_csp
 {
@@ -110,6 +111,9 @@ public:
 		
 		double m_PR_mc_guess;				//[-] Initial guess for ratio of P_mc_out to P_mc_in
 		bool m_fixed_PR_mc;					//[-] if true, ratio of P_mc_out to P_mc_in is fixed at PR_mc_guess
+
+		int m_n_multi_start;				//[-] Number of design optimization starting points. > 1 runs independent optimizations in parallel
+		int m_n_threads;					//[-] Number of threads for multi-start design optimization. <= 0 uses all hardware threads
 	
 		// PHX design parameters
 		// This is a PHX rather than system parameter because we don't know T_CO2_in until cycle model is solved
@@ -145,6 +149,9 @@ public:
 	
 			m_fixed_PR_mc = false;		//[-] If false, then should default to optimizing this parameter
 			m_fixed_P_mc_out = false;	//[-] If fasle, then should default to optimizing this parameter
+
+			m_n_multi_start = 1;		//[-] Single optimization from the built-in starting point
+			m_n_threads = 0;			//[-]
 		}
 	};
 
@@ -162,10 +169,13 @@ public:
 	
 		// Ambient Conditions
 		double m_T_amb;			//[K] Ambient temperature
+
+		// Optional warm start, e.g. from a neighbouring solution
+		double m_f_P_LP_in_guess;	//[-] Starting compressor inlet pressure / pressure at design inlet density. NaN = 1
 	
 		S_od_par()
 		{
-			m_T_htf_hot = m_m_dot_htf = m_T_amb = std::numeric_limits<double>::quiet_NaN();
+			m_T_htf_hot = m_m_dot_htf = m_T_amb = m_f_P_LP_in_guess = std::numeric_limits<double>::quiet_NaN();
 		}
 	};
 
@@ -263,6 +273,8 @@ private:
 
 	void setup_off_design_info(C_sco2_recomp_csp::S_od_par od_par, int off_design_strategy, double od_opt_tol);
 
+	double get_P_LP_in_at_des_dens();
+
 public:	
 
 	C_sco2_recomp_csp();
@@ -287,6 +299,7 @@ public:
 	{
 	private:
 		C_sco2_recomp_csp *mpc_sco2_rc;
+		std::unique_ptr<C_sco2_recomp_csp> mpc_sco2_rc_copy;	// Owned cycle when this function is a clone
 
 	public:
 		C_sco2_csp_od(C_sco2_recomp_csp *pc_sco2_rc)
@@ -295,12 +308,15 @@ public:
 		}
 	
 		virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs);
+
+		virtual C_od_pc_function * clone();
 	};
 
 	int generate_ud_pc_tables(double T_htf_low /*C*/, double T_htf_high /*C*/, int n_T_htf /*-*/,
 		double T_amb_low /*C*/, double T_amb_high /*C*/, int n_T_amb /*-*/,
 		double m_dot_htf_ND_low /*-*/, double m_dot_htf_ND_high /*-*/, int n_m_dot_htf_ND,
-		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind);
+		util::matrix_t<double> & T_htf_ind, util::matrix_t<double> & T_amb_ind, util::matrix_t<double> & m_dot_htf_ND_ind,
+		int n_threads = 1, bool is_warm_start = false, std::string checkpoint_file = "");
 
 	void design(S_des_par des_par);
 
@@ -2454,6 +2454,9 @@ void C_RecompCycle::opt_design_core(int & error_code)
 		index++;
 	}
 
+	// Designs evaluated by a previous optimization used different fixed parameters
+	m_objective_metric_cache.clear();
+
 	int no_opt_error_code = 0;
 	if( index > 0 )
 	{
@@ -2506,6 +2509,11 @@ void C_RecompCycle::opt_design_core(int & error_code)
 
 double C_RecompCycle::design_cycle_return_objective_metric(const std::vector<double> &x)
 {
+	// Skip designs that this optimization already evaluated
+	std::map<std::vector<double>, double>::const_iterator it_cached = m_objective_metric_cache.find(x);
+	if( it_cached != m_objective_metric_cache.end() )
+		return it_cached->second;
+
 	// 'x' is array of inputs either being adjusted by optimizer or set constant
 	// Finish defining ms_des_par based on current 'x' values
 
@@ -2595,6 +2603,8 @@ double C_RecompCycle::design_cycle_return_objective_metric(const std::vector<dou
 		}
 	}
 
+	m_objective_metric_cache[x] = objective_metric;
+
 	return objective_metric;
 }
 
@@ -2654,6 +2664,9 @@ void C_RecompCycle::auto_opt_design_core(int & error_code)
 	// Outer optimization loop
 	m_objective_metric_auto_opt = 0.0;
 
+	// Starting point for the multi-start optimizations, before the single-start search below changes 'ms_opt_des_par'
+	S_opt_design_parameters opt_des_par_base = ms_opt_des_par;
+
 	double best_P_high = ms_auto_opt_des_par.m_P_high_limit;		//[kPa]
 	double PR_mc_guess = 2.5;				//[-]
 	if (!ms_opt_des_par.m_fixed_P_mc_out)
@@ -2728,6 +2741,12 @@ void C_RecompCycle::auto_opt_design_core(int & error_code)
 		m_objective_metric_auto_opt = m_objective_metric_opt;
 	}
 
+	// Other starting points can only replace the single-start design with a better one
+	if (ms_auto_opt_des_par.m_n_multi_start > 1)
+	{
+		multi_start_auto_opt_design(opt_des_par_base);
+	}
+
 	ms_des_par = ms_des_par_auto_opt;
 
 	int optimal_design_error_code = 0;
@@ -2744,6 +2763,89 @@ void C_RecompCycle::auto_opt_design_core(int & error_code)
 	error_code = optimal_design_error_code;
 }
 
+void C_RecompCycle::multi_start_auto_opt_design(const S_opt_design_parameters & opt_des_par_base)
+{
+	// Optimizes the cycle from a Latin hypercube sample of 'm_n_multi_start' - 1 starting points, in addition to the
+	// single-start search in auto_opt_design_core. Each optimization runs on its own copy of this cycle, and a design
+	// replaces the current optimum only if it is better:
+		// ms_des_par_auto_opt
+		// m_objective_metric_auto_opt
+	double P_low_limit = std::min(ms_auto_opt_des_par.m_P_high_limit, std::max(10.E3, ms_auto_opt_des_par.m_P_high_limit*0.2));		//[kPa]
+	double P_pseudocritical = P_pseudocritical_1(opt_des_par_base.m_T_mc_in);	//[kPa]
+
+	S_opt_design_parameters opt_des_par_start = opt_des_par_base;
+	opt_des_par_start.m_P_mc_out_guess = ms_auto_opt_des_par.m_P_high_limit;	//[kPa]
+	opt_des_par_start.m_fixed_P_mc_out = ms_auto_opt_des_par.m_fixed_P_mc_out;	//[-]
+	opt_des_par_start.m_fixed_PR_mc = ms_auto_opt_des_par.m_fixed_PR_mc;		//[-]
+	opt_des_par_start.m_PR_mc_guess = ms_auto_opt_des_par.m_PR_mc_guess;		//[-]
+	if (ms_auto_opt_des_par.m_is_recomp_ok)
+	{
+		opt_des_par_start.m_fixed_recomp_frac = false;
+		opt_des_par_start.m_fixed_LT_frac = false;
+	}
+	else
+	{
+		opt_des_par_start.m_recomp_frac_guess = 0.0;
+		opt_des_par_start.m_fixed_recomp_frac = true;
+		opt_des_par_start.m_LT_frac_guess = 1.0;
+		opt_des_par_start.m_fixed_LT_frac = true;
+	}
+
+	// Sample: main compressor outlet pressure [kPa], main compressor inlet pressure relative to the pseudocritical pressure [-],
+	//    recompression fraction [-], and fraction of recuperator UA in the LTR [-]
+	std::vector<double> lb(4);
+	std::vector<double> ub(4);
+	lb[0] = P_low_limit;	ub[0] = ms_auto_opt_des_par.m_P_high_limit;
+	lb[1] = 0.7;			ub[1] = 1.3;
+	lb[2] = 0.0;			ub[2] = 0.6;
+	lb[3] = 0.1;			ub[3] = 0.9;
+
+	std::vector<std::vector<double>> starts = latin_hypercube_samples(lb, ub, ms_auto_opt_des_par.m_n_multi_start - 1);
+
+	std::vector<S_opt_design_parameters> v_opt_des_par;
+	for (size_t i = 0; i < starts.size(); i++)
+	{
+		S_opt_design_parameters opt_des_par_i = opt_des_par_start;
+		if (!opt_des_par_i.m_fixed_P_mc_out)
+			opt_des_par_i.m_P_mc_out_guess = starts[i][0];		//[kPa]
+		if (!opt_des_par_i.m_fixed_PR_mc)
+			opt_des_par_i.m_PR_mc_guess = std::max(1.1, opt_des_par_i.m_P_mc_out_guess / (starts[i][1] * P_pseudocritical));	//[-]
+		if (ms_auto_opt_des_par.m_is_recomp_ok)
+		{
+			opt_des_par_i.m_recomp_frac_guess = starts[i][2];		//[-]
+			opt_des_par_i.m_LT_frac_guess = starts[i][3];			//[-]
+		}
+
+		v_opt_des_par.push_back(opt_des_par_i);
+	}
+
+	int n_opt = (int)v_opt_des_par.size();
+	std::vector<int> v_error_code(n_opt, -1);
+	std::vector<double> v_objective_metric(n_opt, 0.0);
+	std::vector<S_design_parameters> v_des_par_optimal(n_opt);
+
+	run_parallel_tasks(n_opt, ms_auto_opt_des_par.m_n_threads, [&](int i)
+	{
+		C_RecompCycle c_cycle(*this);
+		c_cycle.ms_opt_des_par = v_opt_des_par[i];
+
+		c_cycle.opt_design_core(v_error_code[i]);
+
+		v_objective_metric[i] = c_cycle.m_objective_metric_opt;
+		v_des_par_optimal[i] = c_cycle.ms_des_par_optimal;
+	});
+
+	// Ties go to the single-start design and then to the earlier starting point, so the result doesn't depend on the number of threads
+	for (int i = 0; i < n_opt; i++)
+	{
+		if (v_error_code[i] == 0 && v_objective_metric[i] > m_objective_metric_auto_opt)
+		{
+			ms_des_par_auto_opt = v_des_par_optimal[i];
+			m_objective_metric_auto_opt = v_objective_metric[i];
+		}
+	}
+}
+
 int C_RecompCycle::auto_opt_design_hit_eta(S_auto_opt_design_hit_eta_parameters & auto_opt_des_hit_eta_in, string & error_msg)
 {
 	ms_auto_opt_des_par.m_W_dot_net = auto_opt_des_hit_eta_in.m_W_dot_net;				//[kW] Target net cycle power
@@ -2781,6 +2883,8 @@ int C_RecompCycle::auto_opt_design_hit_eta(S_auto_opt_design_hit_eta_parameters
 
 	ms_auto_opt_des_par.m_PR_mc_guess = auto_opt_des_hit_eta_in.m_PR_mc_guess;			//[-] Initial guess for ratio of P_mc_out to P_mc_in
 	ms_auto_opt_des_par.m_fixed_PR_mc = auto_opt_des_hit_eta_in.m_fixed_PR_mc;			//[-] if true, ratio of P_mc_out to P_mc_in is fixed at PR_mc_guess		
+	ms_auto_opt_des_par.m_n_multi_start = auto_opt_des_hit_eta_in.m_n_multi_start;	//[-]
+	ms_auto_opt_des_par.m_n_threads = auto_opt_des_hit_eta_in.m_n_threads;			//[-]
 
 	// At this point, 'auto_opt_des_hit_eta_in' should only be used to access the targer thermal efficiency: 'm_eta_thermal'
 
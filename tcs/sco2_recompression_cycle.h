@@ -57,6 +57,7 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <map>
 #include <math.h>
 #include "CO2_properties.h"
 
@@ -437,6 +438,7 @@ private:
 		// Structures and data for optimization
 	S_design_parameters ms_des_par_optimal;
 	double m_objective_metric_opt;
+	std::map<std::vector<double>, double> m_objective_metric_cache;	// Objective metric of each design evaluated by the current optimization
 
 		// Structures and data for auto-optimization
 	double m_objective_metric_auto_opt;	
@@ -477,6 +479,8 @@ private:
 
 	void auto_opt_design_core(int & error_code);
 
+	void multi_start_auto_opt_design(const S_opt_design_parameters & opt_des_par_base);
+
 	void finalize_design(int & error_code);	
 
 	//void off_design_core(int & error_code);
@@ -50,6 +50,19 @@
 #include "ud_power_cycle.h"
 #include "csp_solver_util.h"
 
+#include <cstdio>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+
 void C_ud_power_cycle::init(const util::matrix_t<double> & T_htf_ind, double T_htf_ref /*C*/, double T_htf_low /*C*/, double T_htf_high /*C*/,
 	const util::matrix_t<double> & T_amb_ind, double T_amb_ref /*C*/, double T_amb_low /*C*/, double T_amb_high /*C*/,
 	const util::matrix_t<double> & m_dot_htf_ind, double m_dot_htf_ref /*-*/, double m_dot_htf_low /*-*/, double m_dot_htf_high /*-*/)
@@ -378,6 +391,9 @@ C_ud_pc_table_generator::C_ud_pc_table_generator(C_od_pc_function & f_pc_eq) : m
 {
 	mf_callback = 0;		// = NULL
 	mp_mf_active = 0;			// = NULL
+	m_n_threads = 1;
+	m_is_warm_start = false;
+	m_checkpoint_file = "";
 	m_progress_msg = "Power cycle preprocessing...";
 	m_log_msg = "Log message";
 
@@ -460,11 +476,8 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 		throw(C_csp_exception(msg, "User defined power cycle, generate tables"));
 	}
 
-	C_od_pc_function::S_f_inputs pc_inputs;
-	C_od_pc_function::S_f_outputs pc_outputs;
-
 	// ******************************************
-	// Setup T_HTF parameteric runs
+	// Check number of levels in each parametric
 	if(n_T_htf < 3)
 	{
 		std::string msg = util::format("The input argument for number of indepedent HTF temperatures is %d."
@@ -472,201 +485,354 @@ int C_ud_pc_table_generator::generate_tables(double T_htf_ref /*C*/, double T_ht
 		mc_messages.add_notice(msg);
 		n_T_htf = 3;
 	}
+	if(n_T_amb < 3)
+	{
+		std::string msg = util::format("The input argument for number of independent ambient temperatures"
+						" is %d. It was reset to the minimum value of 3.", n_T_amb);
+		mc_messages.add_notice(msg);
+		n_T_amb = 3;
+	}
+	if(n_m_dot_htf_ND < 3)
+	{
+		std::string msg = util::format("The input argument for number of independent normalized HTF mass flow rates"
+						" is %d. It was reset to the minimum value of 3.", n_m_dot_htf_ND);
+		mc_messages.add_notice(msg);
+		n_m_dot_htf_ND = 3;
+	}
 
 	T_htf_ind.clear();
 	T_htf_ind.resize(n_T_htf, 13);		// Set matrix size
 	double delta_T_htf = (T_htf_high - T_htf_low)/double(n_T_htf-1);
 
-	double n_runs_total = 3.0*(n_T_htf + n_T_amb + n_m_dot_htf_ND);
+	T_amb_ind.clear();
+	T_amb_ind.resize(n_T_amb, 13);		// Set matrix size
+	double delta_T_amb = (T_amb_high - T_amb_low)/double(n_T_amb-1);
+
+	m_dot_htf_ind.clear();
+	m_dot_htf_ind.resize(n_m_dot_htf_ND,13);		// Set matrix size
+	double delta_m_dot = (m_dot_htf_ND_high-m_dot_htf_ND_low)/double(n_m_dot_htf_ND-1);
+
+	// Low, ref, and high levels of the interaction variable in each table
+	double m_dot_htf_ND_levels[3] = {m_dot_htf_ND_low, m_dot_htf_ND_ref, m_dot_htf_ND_high};
+	double T_htf_levels[3] = {T_htf_low, T_htf_ref, T_htf_high};	//[C]
+	double T_amb_levels[3] = {T_amb_low, T_amb_ref, T_amb_high};	//[C]
 
-	// Set ambient temperature because it is constant for the HTF temperature parametrics
-	pc_inputs.m_T_amb = T_amb_ref;	//[C]
+	// ******************************************
+	// Set up off-design points
+	// Each table row is run at the 3 levels of its interaction variable
+	// Points are numbered by table, then row, then level
+	int n_rows = n_T_htf + n_T_amb + n_m_dot_htf_ND;
+	int n_runs_total = 3*n_rows;
+	std::vector<S_od_point> v_points(n_runs_total);
+
+	// HTF temperature parametrics at design ambient temperature
 	for(int i = 0; i < n_T_htf; i++)
 	{
 		T_htf_ind(i,0) = T_htf_low + delta_T_htf*i;	//[C]
-		pc_inputs.m_T_htf_hot = T_htf_ind(i,0);
+		for(int j = 0; j < 3; j++)
+		{
+			C_od_pc_function::S_f_inputs & pc_inputs = v_points[3*i + j].ms_inputs;
+			pc_inputs.m_T_htf_hot = T_htf_ind(i,0);				//[C]
+			pc_inputs.m_T_amb = T_amb_ref;						//[C]
+			pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_levels[j];	//[-]
+		}
+	}
 
-		// Call at low, ref, and high ND mass flow rate levels
-		std::vector<double> m_dot_htf_ND_levels(3);
-		m_dot_htf_ND_levels[0] = m_dot_htf_ND_low;
-		m_dot_htf_ND_levels[1] = m_dot_htf_ND_ref;
-		m_dot_htf_ND_levels[2] = m_dot_htf_ND_high;
+	// Ambient temperature parametrics at design ND HTF mass flow rate
+	for(int i = 0; i < n_T_amb; i++)
+	{
+		T_amb_ind(i,0) = T_amb_low + delta_T_amb*i;		//[C]
 		for(int j = 0; j < 3; j++)
 		{
-			bool is_od_model_error = false;
+			C_od_pc_function::S_f_inputs & pc_inputs = v_points[3*(n_T_htf + i) + j].ms_inputs;
+			pc_inputs.m_T_htf_hot = T_htf_levels[j];			//[C]
+			pc_inputs.m_T_amb = T_amb_ind(i,0);					//[C]
+			pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_ref;		//[-]
+		}
+	}
 
-			pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs,pc_outputs);
+	// ND HTF mass flow rate parametrics at design HTF temperature
+	for(int i = 0; i < n_m_dot_htf_ND; i++)
+	{
+		m_dot_htf_ind(i,0) = m_dot_htf_ND_low + delta_m_dot*i;		//[-]
+		for(int j = 0; j < 3; j++)
+		{
+			C_od_pc_function::S_f_inputs & pc_inputs = v_points[3*(n_T_htf + n_T_amb + i) + j].ms_inputs;
+			pc_inputs.m_T_htf_hot = T_htf_ref;					//[C]
+			pc_inputs.m_T_amb = T_amb_levels[j];				//[C]
+			pc_inputs.m_m_dot_htf_ND = m_dot_htf_ind(i,0);		//[-]
+		}
+	}
 
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				T_htf_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				T_htf_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				T_htf_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				T_htf_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else if (off_design_code == -1)
-			{
-				// Save 'generic' off design model response
-				T_htf_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_htf_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
+	// Copy a solved point into its table, or throw if the off-design model failed outright
+	auto save_point = [&](int k) -> bool
+	{
+		const S_od_point & point = v_points[k];
+		int i_row = k / 3;
+		int j = k % 3;
 
-				is_od_model_error = true;
-			}
-			else
-			{
-				std::string err_msg = util::format("The 1st UDPC table (primary: T_htf, interaction: m_dot_htf_ND) generation failed at T_htf = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND);
-				throw(C_csp_exception(err_msg, "UDPC"));
-			}
+		util::matrix_t<double> *p_table = &T_htf_ind;
+		int i_table = 0;
+		if (i_row >= n_T_htf + n_T_amb)
+		{
+			p_table = &m_dot_htf_ind;
+			i_table = 2;
+			i_row -= n_T_htf + n_T_amb;
+		}
+		else if (i_row >= n_T_htf)
+		{
+			p_table = &T_amb_ind;
+			i_table = 1;
+			i_row -= n_T_htf;
+		}
 
-			double run_number = i*3 + j;
+		if( point.m_od_code == 0 )
+		{
+			// Save outputs
+			(*p_table)(i_row,1+j) = point.ms_outputs.m_W_dot_gross_ND;		//[-]
+			(*p_table)(i_row,4+j) = point.ms_outputs.m_Q_dot_in_ND;			//[-]
+			(*p_table)(i_row,7+j) = point.ms_outputs.m_W_dot_cooling_ND;	//[-]
+			(*p_table)(i_row,10+j) = point.ms_outputs.m_m_dot_water_ND;		//[-]
 
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				T_htf_ind(i, 1 + j), T_htf_ind(i, 4 + j),
-				T_htf_ind(i, 7 + j), T_htf_ind(i, 10 + j));
+			return false;
+		}
+		else if (point.m_od_code == -1)
+		{
+			// Save 'generic' off design model response
+			(*p_table)(i_row, 1 + j) = point.ms_inputs.m_m_dot_htf_ND;		//[-]
+			(*p_table)(i_row, 4 + j) = point.ms_inputs.m_m_dot_htf_ND;		//[-]
+			(*p_table)(i_row, 7 + j) = point.ms_inputs.m_m_dot_htf_ND;		//[-]
+			(*p_table)(i_row, 10 + j) = point.ms_inputs.m_m_dot_htf_ND;		//[-]
 
+			return true;
 		}
 
-	}
-	// ******************************************
+		std::string err_msg;
+		if (i_table == 0)
+			err_msg = util::format("The 1st UDPC table (primary: T_htf, interaction: m_dot_htf_ND) generation failed at T_htf = %lg [C] and m_dot_htf = %lg [-]", point.ms_inputs.m_T_htf_hot, point.ms_inputs.m_m_dot_htf_ND);
+		else if (i_table == 1)
+			err_msg = util::format("The 2nd UDPC table (primary: T_amb, interaction: T_htf) generation failed at T_amb = %lg [C] and T_htf = %lg [C]", point.ms_inputs.m_T_amb, point.ms_inputs.m_T_htf_hot);
+		else
+			err_msg = util::format("The 3rd UDPC table (primary: m_dot_htf_ND, interaction: T_amb) generation failed at T_amb = %lg [C] and m_dot_htf = %lg [-]", point.ms_inputs.m_T_amb, point.ms_inputs.m_m_dot_htf_ND);
+		throw(C_csp_exception(err_msg, "UDPC"));
+	};
 
 	// ******************************************
-	// Setup T_amb parametric runs
-	if(n_T_amb < 3)
-	{
-		std::string msg = util::format("The input argument for number of independent ambient temperatures"
-						" is %d. It was reset to the minimum value of 3.", n_T_amb);
-		mc_messages.add_notice(msg);
-		n_T_amb = 3;
+	// Restore points from a previous, interrupted run with the same levels
+	// The file is then rewritten with the restored points, dropping anything that couldn't be read
+	int n_runs_complete = 0;
+	FILE *fp_checkpoint = 0;
+	if (m_checkpoint_file.size() > 0)
+	{
+		char header[512];
+		sprintf(header, "udpc_checkpoint %d %.17g %.17g %.17g %d %.17g %.17g %.17g %d %.17g %.17g %.17g",
+			n_T_htf, T_htf_ref, T_htf_low, T_htf_high,
+			n_T_amb, T_amb_ref, T_amb_low, T_amb_high,
+			n_m_dot_htf_ND, m_dot_htf_ND_ref, m_dot_htf_ND_low, m_dot_htf_ND_high);
+
+		read_checkpoint(header, v_points);
+
+		fp_checkpoint = fopen(m_checkpoint_file.c_str(), "w");
+		if (fp_checkpoint)
+			fprintf(fp_checkpoint, "%s\n", header);
+		else
+			mc_messages.add_notice(util::format("Could not open the UDPC checkpoint file %s. Points will not be saved.", m_checkpoint_file.c_str()));
 	}
 
-	T_amb_ind.clear();
-	T_amb_ind.resize(n_T_amb, 13);		// Set matrix size
-	double delta_T_amb = (T_amb_high - T_amb_low)/double(n_T_amb-1);
-
-	// Set ND htf mass flow rate because it is constant for the ambient temperature parametrics
-	pc_inputs.m_m_dot_htf_ND = m_dot_htf_ND_ref;
-	for(int i = 0; i < n_T_amb; i++)
+	auto write_checkpoint = [&](int k)
 	{
-		T_amb_ind(i,0) = T_amb_low + delta_T_amb*i;		//[C]
-		pc_inputs.m_T_amb = T_amb_ind(i,0);				//[C]
+		if (!fp_checkpoint)
+			return;
 
-		// Call at low, ref, and high HTF temperature levels
-		std::vector<double> T_htf_levels(3);
-		T_htf_levels[0] = T_htf_low;   //[C]
-		T_htf_levels[1] = T_htf_ref;   //[C]
-		T_htf_levels[2] = T_htf_high;  //[C]
-		for(int j = 0; j < 3; j++)
-		{
-			bool is_od_model_error = false;
+		const S_od_point & point = v_points[k];
+		fprintf(fp_checkpoint, "%d %d %.17g %.17g %.17g %.17g %d", k, point.m_od_code,
+			point.ms_outputs.m_W_dot_gross_ND, point.ms_outputs.m_Q_dot_in_ND,
+			point.ms_outputs.m_W_dot_cooling_ND, point.ms_outputs.m_m_dot_water_ND,
+			(int)point.ms_outputs.m_x_solved.size());
+		for (size_t i = 0; i < point.ms_outputs.m_x_solved.size(); i++)
+			fprintf(fp_checkpoint, " %.17g", point.ms_outputs.m_x_solved[i]);
+		fprintf(fp_checkpoint, "\n");
+		fflush(fp_checkpoint);
+	};
 
-			pc_inputs.m_T_htf_hot = T_htf_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs,pc_outputs);
+	for (int k = 0; k < n_runs_total; k++)
+	{
+		if (v_points[k].m_is_solved)
+		{
+			save_point(k);
+			write_checkpoint(k);
+			n_runs_complete++;
+		}
+	}
+	if (n_runs_complete > 0)
+	{
+		mc_messages.add_notice(util::format("Restored %d of %d off-design points from the UDPC checkpoint file %s",
+			n_runs_complete, n_runs_total, m_checkpoint_file.c_str()));
+	}
 
-			if( off_design_code == 0 )
+	// ******************************************
+	// Solve the remaining points
+	// Workers take whole table rows and solve the reference level first, so it can warm-start the low and high levels
+	// The first worker uses 'mf_pc_eq' and the others each use a copy of it. Results are passed back to this thread,
+	// which saves them and sends all callbacks
+	int n_workers = (m_n_threads > 0) ? m_n_threads : (int)std::thread::hardware_concurrency();
+	n_workers = std::max(1, std::min(n_workers, n_rows));
+
+	std::mutex mtx_solved;
+	std::condition_variable cv_solved;
+	std::deque<int> q_solved;
+	int n_workers_running = n_workers;
+	std::exception_ptr p_worker_exception;
+	std::atomic<int> next_row(0);
+	std::atomic<bool> is_stop(false);
+
+	auto worker = [&](int w)
+	{
+		try
+		{
+			std::unique_ptr<C_od_pc_function> p_pc_eq_copy;
+			C_od_pc_function *p_pc_eq = &mf_pc_eq;
+			if (w > 0)
 			{
-				// Save outputs
-				T_amb_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				T_amb_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				T_amb_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				T_amb_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
+				p_pc_eq_copy.reset(mf_pc_eq.clone());
+				p_pc_eq = p_pc_eq_copy.get();
 			}
-			else if (off_design_code == -1)
-			{
-				// Save 'generic' off design model response
-				T_amb_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				T_amb_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
 
-				is_od_model_error = true;
-			}
-			else
+			const int level_order[3] = {1, 0, 2};
+			for (int i_row = next_row++; p_pc_eq && i_row < n_rows && !is_stop; i_row = next_row++)
 			{
-				std::string err_msg = util::format("The 2nd UDPC table (primary: T_amb, interaction: T_htf) generation failed at T_amb = %lg [C] and T_htf = %lg [C]", pc_inputs.m_T_amb, pc_inputs.m_T_htf_hot);
-				throw(C_csp_exception(err_msg, "UDPC"));
+				for (int l = 0; l < 3 && !is_stop; l++)
+				{
+					int k = 3*i_row + level_order[l];
+					S_od_point & point = v_points[k];
+					if (point.m_is_solved)
+						continue;
+
+					const S_od_point & ref_point = v_points[3*i_row + 1];
+					if (m_is_warm_start && k != 3*i_row + 1 && ref_point.m_is_solved && ref_point.m_od_code == 0)
+						point.ms_inputs.m_x_warm_start = ref_point.ms_outputs.m_x_solved;
+
+					point.m_od_code = (*p_pc_eq)(point.ms_inputs, point.ms_outputs);
+
+					std::lock_guard<std::mutex> guard(mtx_solved);
+					point.m_is_solved = true;
+					q_solved.push_back(k);
+					cv_solved.notify_one();
+				}
 			}
-
-			double run_number = 3.0*n_T_htf + i*3 + j;
-
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				T_amb_ind(i, 1 + j), T_amb_ind(i, 4 + j),
-				T_amb_ind(i, 7 + j), T_amb_ind(i, 10 + j));
 		}
-	}
-	// ******************************************
+		catch (...)
+		{
+			std::lock_guard<std::mutex> guard(mtx_solved);
+			if (!p_worker_exception)
+				p_worker_exception = std::current_exception();
+			is_stop = true;
+		}
 
-	// ******************************************
-	// Setup ND m_dot parametric runs
-	if(n_m_dot_htf_ND < 3)
-	{
-		std::string msg = util::format("The input argument for number of independent normalized HTF mass flow rates"
-						" is %d. It was reset to the minimum value of 3.", n_m_dot_htf_ND);
-		mc_messages.add_notice(msg);
-		n_m_dot_htf_ND = 3;
-	}
+		std::lock_guard<std::mutex> guard(mtx_solved);
+		n_workers_running--;
+		cv_solved.notify_one();
+	};
 
-	m_dot_htf_ind.clear();
-	m_dot_htf_ind.resize(n_m_dot_htf_ND,13);		// Set matrix size
-	double delta_m_dot = (m_dot_htf_ND_high-m_dot_htf_ND_low)/double(n_m_dot_htf_ND-1);
+	std::vector<std::thread> threads;
+	for (int w = 0; w < n_workers; w++)
+		threads.push_back(std::thread(worker, w));
 
-	// Set HTF temperature because it is constant for the ambient temperature parametrics
-	pc_inputs.m_T_htf_hot = T_htf_ref;
-	for(int i = 0; i < n_m_dot_htf_ND; i++)
+	try
 	{
-		m_dot_htf_ind(i,0) = m_dot_htf_ND_low + delta_m_dot*i;		//[-]
-		pc_inputs.m_m_dot_htf_ND = m_dot_htf_ind(i,0);				//[-]
-
-		// Call at low, ref, and high ambient temperatures
-		std::vector<double> T_amb_levels(3);
-		T_amb_levels[0] = T_amb_low;    //[C]
-		T_amb_levels[1] = T_amb_ref;	//[C]
-		T_amb_levels[2] = T_amb_high;	//[C]
-		for(int j = 0; j < 3; j++)
+		while (true)
 		{
-			bool is_od_model_error = false;
-
-			pc_inputs.m_T_amb = T_amb_levels[j];
-			int off_design_code = mf_pc_eq(pc_inputs, pc_outputs);
-		
-			if( off_design_code == 0 )
-			{
-				// Save outputs
-				m_dot_htf_ind(i,1+j) = pc_outputs.m_W_dot_gross_ND;		//[-]
-				m_dot_htf_ind(i,4+j) = pc_outputs.m_Q_dot_in_ND;		//[-]
-				m_dot_htf_ind(i,7+j) = pc_outputs.m_W_dot_cooling_ND;	//[-]
-				m_dot_htf_ind(i,10+j) = pc_outputs.m_m_dot_water_ND;	//[-]
-			}
-			else if (off_design_code == -1)
-			{
-				// Save 'generic' off design model response
-				m_dot_htf_ind(i, 1 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 4 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 7 + j) = pc_inputs.m_m_dot_htf_ND;		//[-]
-				m_dot_htf_ind(i, 10 + j) = pc_inputs.m_m_dot_htf_ND;	//[-]
-
-				is_od_model_error = true;
-			}
-			else
+			int k = -1;
 			{
-				std::string err_msg = util::format("The 3rd UDPC table (primary: m_dot_htf_ND, interaction: T_amb) generation failed at T_amb = %lg [C] and m_dot_htf = %lg [-]", pc_inputs.m_T_amb, pc_inputs.m_m_dot_htf_ND);
-				throw(C_csp_exception(err_msg, "UDPC"));
+				std::unique_lock<std::mutex> guard(mtx_solved);
+				cv_solved.wait(guard, [&]{ return q_solved.size() > 0 || n_workers_running == 0; });
+				if (q_solved.size() == 0)
+					break;
+				k = q_solved.front();
+				q_solved.pop_front();
 			}
 
-			double run_number = 3.0*n_T_htf + 3.0*n_T_amb  + i*3 + j;
-
-			send_callback(is_od_model_error, (int)run_number + 1, (int)n_runs_total,
-				pc_inputs.m_T_htf_hot, pc_inputs.m_m_dot_htf_ND, pc_inputs.m_T_amb,
-				m_dot_htf_ind(i, 1 + j), m_dot_htf_ind(i, 4 + j),
-				m_dot_htf_ind(i, 7 + j), m_dot_htf_ind(i, 10 + j));
+			bool is_od_model_error = save_point(k);
+			write_checkpoint(k);
+			n_runs_complete++;
+
+			const S_od_point & point = v_points[k];
+			int i_table_row = k / 3;
+			int j = k % 3;
+			const util::matrix_t<double> & table = i_table_row < n_T_htf ? T_htf_ind
+				: (i_table_row < n_T_htf + n_T_amb ? T_amb_ind : m_dot_htf_ind);
+			if (i_table_row >= n_T_htf + n_T_amb)
+				i_table_row -= n_T_htf + n_T_amb;
+			else if (i_table_row >= n_T_htf)
+				i_table_row -= n_T_htf;
+
+			send_callback(is_od_model_error, n_runs_complete, n_runs_total,
+				point.ms_inputs.m_T_htf_hot, point.ms_inputs.m_m_dot_htf_ND, point.ms_inputs.m_T_amb,
+				table(i_table_row, 1 + j), table(i_table_row, 4 + j),
+				table(i_table_row, 7 + j), table(i_table_row, 10 + j));
 		}
 	}
+	catch (...)
+	{
+		// Failed point or user cancelled: let the workers finish their current point before leaving
+		is_stop = true;
+		for (size_t w = 0; w < threads.size(); w++)
+			threads[w].join();
+		if (fp_checkpoint)
+			fclose(fp_checkpoint);
+		throw;
+	}
+
+	for (size_t w = 0; w < threads.size(); w++)
+		threads[w].join();
+	if (fp_checkpoint)
+		fclose(fp_checkpoint);
+
+	if (p_worker_exception)
+		std::rethrow_exception(p_worker_exception);
 	// ******************************************
-	
+
 	return 0;
+}
+
+void C_ud_pc_table_generator::read_checkpoint(const std::string & header, std::vector<S_od_point> & v_points)
+{
+	std::ifstream infile(m_checkpoint_file.c_str());
+	std::string line;
+	if (!infile.is_open() || !std::getline(infile, line) || line != header)
+		return;		// No checkpoint, or it was written for different table levels
+
+	// Each line is: point index, off-design code, the 4 ND outputs, size of the solved state, then the solved state
+	// A line cut short by an interruption doesn't parse and is skipped
+	std::vector<double> values;
+	while (std::getline(infile, line))
+	{
+		values.clear();
+		const char *p = line.c_str();
+		char *p_end = 0;
+		for (double val = strtod(p, &p_end); p_end != p; val = strtod(p, &p_end))
+		{
+			values.push_back(val);
+			p = p_end;
+		}
+		while (isspace((unsigned char)*p))
+			p++;
+
+		if (*p != '\0' || values.size() < 7 || values[6] < 0.0 || values.size() != 7 + (size_t)values[6])
+			continue;
+
+		int k = (int)values[0];
+		int od_code = (int)values[1];
+		if (k < 0 || k >= (int)v_points.size() || (od_code != 0 && od_code != -1))
+			continue;
+
+		S_od_point & point = v_points[k];
+		point.m_od_code = od_code;
+		point.ms_outputs.m_W_dot_gross_ND = values[2];		//[-]
+		point.ms_outputs.m_Q_dot_in_ND = values[3];			//[-]
+		point.ms_outputs.m_W_dot_cooling_ND = values[4];	//[-]
+		point.ms_outputs.m_m_dot_water_ND = values[5];		//[-]
+		point.ms_outputs.m_x_solved.assign(values.begin() + 7, values.end());
+		point.m_is_solved = true;
+	}
 }
\ No newline at end of file
@@ -51,6 +51,8 @@
 #define __UD_POWER_CYCLE_
 
 #include <limits>
+#include <vector>
+#include <string>
 #include "interpolation_routines.h"
 #include "csp_solver_util.h"
 
@@ -152,6 +154,9 @@ public:
 		// Ambient Conditions
 		double m_T_amb;			//[C] Ambient temperature
 
+		// Optional model state from a converged neighbouring point. Empty = cold start
+		std::vector<double> m_x_warm_start;
+
 		S_f_inputs()
 		{
 			m_T_htf_hot = m_m_dot_htf_ND = m_T_amb = std::numeric_limits<double>::quiet_NaN();
@@ -166,6 +171,9 @@ public:
 		double m_W_dot_cooling_ND;	//[-] Off-design cooling power / Design-point cooling power
 		double m_m_dot_water_ND;	//[-] Off-design mass flow rate / Design-point mass flow rate
 
+		// Model state at the converged point, used to warm-start its neighbours
+		std::vector<double> m_x_solved;
+
 		S_f_outputs()
 		{
 			m_W_dot_gross_ND = m_Q_dot_in_ND = m_W_dot_cooling_ND = m_m_dot_water_ND = std::numeric_limits<double>::quiet_NaN();
@@ -175,11 +183,18 @@ public:
 	C_od_pc_function()
 	{
 	}
-	~C_od_pc_function()
+	virtual ~C_od_pc_function()
 	{
 	}
 
 	virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs) = 0;
+
+	// Returns a new, independent copy of the off-design model that may be called from another thread,
+	// or NULL if the model can't be copied. The caller owns the returned object
+	virtual C_od_pc_function * clone()
+	{
+		return 0;
+	}
 };
 
 class C_ud_pc_table_generator
@@ -190,6 +205,22 @@ private:
 	std::string m_log_msg;
 	std::string m_progress_msg;	
 
+	struct S_od_point
+	{
+		C_od_pc_function::S_f_inputs ms_inputs;
+		C_od_pc_function::S_f_outputs ms_outputs;
+		int m_od_code;		//[-] Return code from the off-design model
+		bool m_is_solved;	//[-] Solved in this run or restored from the checkpoint file
+
+		S_od_point()
+		{
+			m_od_code = 0;
+			m_is_solved = false;
+		}
+	};
+
+	void read_checkpoint(const std::string & header, std::vector<S_od_point> & v_points);
+
 	void send_callback(bool is_od_model_error, int run_number, int n_runs_total,
 		double T_htf_hot, double m_dot_htf_ND, double T_amb,
 		double W_dot_gross_ND, double Q_dot_in_ND,
@@ -199,6 +230,10 @@ public:
 
 	C_csp_messages mc_messages;
 
+	int m_n_threads;				//[-] Number of worker threads, each with its own copy of the off-design model. 0 = all cores
+	bool m_is_warm_start;			//[-] Start the low and high levels of each table row from the converged reference level
+	std::string m_checkpoint_file;	//[-] If not empty, completed points are saved here and restored when generation is rerun
+
 	C_ud_pc_table_generator(C_od_pc_function & f_pc_eq);
 
 	~C_ud_pc_table_generator(){}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <lib_battery_dispatch.h>
+
+/// Front of meter battery on a clipping PV plant, with an evening price peak that pays for cycling the battery daily
+class FrontOfMeterDispatch : public ::testing::Test
+{
+protected:
+	double dt_hour;
+	size_t nhours;
+	std::vector<double> ppa_factors;
+	util::matrix_t<size_t> ppa_schedule;
+	std::vector<double> pv;
+	std::vector<double> clipped;
+
+	void SetUp()
+	{
+		dt_hour = 1;
+		nhours = 60 * 24;
+
+		// night, shoulder, evening peak and midday periods
+		ppa_factors = { 1.0, 0.6, 2.5, 1.2, 1, 1, 1, 1, 1 };
+		ppa_schedule.resize_fill(12, 24, 1);
+		for (size_t m = 0; m < 12; m++)
+			for (size_t h = 0; h < 24; h++)
+				ppa_schedule(m, h) = (h < 6) ? 2 : (h >= 17 && h < 21) ? 3 : (h >= 10 && h < 15) ? 4 : 1;
+
+		// 1300 kW of PV on a 1000 kW inverter
+		for (size_t i = 0; i < 8760; i++)
+		{
+			double hour = (double)(i % 24);
+			double power = (hour > 6 && hour < 18) ? 1300 * sin(M_PI * (hour - 6) / 12) : 0;
+			pv.push_back(power);
+			clipped.push_back(std::fmax(0, power - 1000));
+		}
+	}
+
+	/// 1000 kWh lithium ion bank without calendar fade or losses
+	battery_t * create_battery()
+	{
+		capacity_t * capacity_model = new capacity_lithium_ion_t(2000, 50, 95, 15);
+		double volts[] = { 0, 4.1, 50, 3.6, 100, 3.0 };
+		util::matrix_t<double> voltage_table(3, 2);
+		voltage_table.assign(volts, 3, 2);
+		voltage_t * voltage_model = new voltage_table_t(139, 1, 3.6, voltage_table, 0.0001);
+
+		double cycles[] = { 20, 0, 100, 20, 5000, 80, 80, 0, 100, 80, 1000, 80 };
+		util::matrix_t<double> cycles_vs_DOD(4, 3);
+		cycles_vs_DOD.assign(cycles, 4, 3);
+		lifetime_t * lifetime_model = new lifetime_t(new lifetime_cycle_t(cycles_vs_DOD),
+			new lifetime_calendar_t(lifetime_calendar_t::NONE, util::matrix_t<double>(1, 2, 0.), dt_hour), 0, 50);
+
+		double temps[] = { -10, 60, 0, 80, 25, 100, 40, 100 };
+		util::matrix_t<double> cap_vs_temp(4, 2);
+		cap_vs_temp.assign(temps, 4, 2);
+		thermal_t * thermal_model = new thermal_t(50000, 10, 10, 10, 1000, 200, 298, cap_vs_temp);
+
+		double_vec no_loss(8760, 0);
+		losses_t * losses_model = new losses_t(lifetime_model, thermal_model, capacity_model, losses_t::MONTHLY, no_loss, no_loss, no_loss, no_loss);
+
+		battery_t * battery_model = new battery_t(dt_hour, battery_t::LITHIUM_ION);
+		battery_model->initialize(capacity_model, voltage_model, lifetime_model, thermal_model, losses_model);
+		return battery_model;
+	}
+
+	/// runs the automated dispatch and returns the revenue from the power delivered to the grid
+	double revenue(bool optimal, size_t & steps_off_target, bool can_pv_charge = true)
+	{
+		size_t steps_charged_from_pv;
+		return revenue(optimal, steps_off_target, steps_charged_from_pv, can_pv_charge);
+	}
+
+	/// also counts the steps that charge more than the clipped PV
+	double revenue(bool optimal, size_t & steps_off_target, size_t & steps_charged_from_pv, bool can_pv_charge)
+	{
+		battery_t * battery_model = create_battery();
+		dispatch_automatic_front_of_meter_t dispatch(battery_model, dt_hour, 15, 95, dispatch_t::RESTRICT_POWER, 1000, 1000, 250, 250, 0,
+			dispatch_t::FOM_LOOK_AHEAD, dispatch_t::FRONT, 1, 24, 1, can_pv_charge, true, false, 1000, 100, dispatch_t::INPUT_CYCLE_COST, 0.02,
+			ppa_factors, ppa_schedule, ppa_schedule, NULL, 96, 96, 96);
+		BatteryPower * battery_power = dispatch.getBatteryPower();
+		battery_power->connectionMode = dispatch_t::AC_CONNECTED;
+		battery_power->singlePointEfficiencyACToDC = 0.96;
+		battery_power->singlePointEfficiencyDCToAC = 0.96;
+		battery_power->singlePointEfficiencyDCToDC = 0.98;
+		dispatch.update_pv_data(pv);
+		dispatch.update_cliploss_data(clipped);
+		dispatch.set_optimal_dispatch(optimal);
+
+		double revenue = 0;
+		steps_off_target = 0;
+		steps_charged_from_pv = 0;
+		for (size_t hour = 0; hour < nhours; hour++)
+		{
+			dispatch.dispatch(0, hour, 0, pv[hour], 500, 0, clipped[hour]);
+
+			// away from the SOC limits the battery meets its target
+			double power_dc = battery_model->capacity_model()->I() * battery_model->battery_voltage() * util::watt_to_kilowatt;
+			double soc = battery_model->battery_soc();
+			if (soc > 15.5 && soc < 94.5 && fabs(power_dc - battery_power->powerBatteryTarget) > 0.02 * fabs(battery_power->powerBatteryTarget) + 1)
+				steps_off_target++;
+			if (-power_dc > clipped[hour] + 1)
+				steps_charged_from_pv++;
+
+			size_t month, hour_of_day;
+			util::month_hour(hour, month, hour_of_day);
+			revenue += ppa_factors[ppa_schedule(month - 1, hour_of_day - 1) - 1] * battery_power->powerGrid * dt_hour;
+		}
+		battery_model->delete_clone();
+		delete battery_model;
+		return revenue;
+	}
+};
+
+TEST_F(FrontOfMeterDispatch, OptimalRevenueAtLeastHeuristic_lib_battery_dispatch)
+{
+	size_t heuristic_off_target, optimal_off_target;
+	double heuristic = revenue(false, heuristic_off_target);
+	double optimal = revenue(true, optimal_off_target);
+
+	EXPECT_GE(optimal, heuristic);
+	EXPECT_EQ(0, (int)optimal_off_target);
+}
+
+TEST_F(FrontOfMeterDispatch, OptimalChargesOnlyFromAllowedSources_lib_battery_dispatch)
+{
+	// without PV charging the battery may only take the clipped energy, even when its target asks for more
+	size_t optimal_off_target, steps_charged_from_pv;
+	revenue(true, optimal_off_target, steps_charged_from_pv, false);
+
+	EXPECT_EQ(0, (int)steps_charged_from_pv);
+}
@@ -165,4 +165,166 @@ TEST_F(LeadAcidBattery, LeadAcidCapacityUnitTest_lib_battery)
 	*/
 	
 
-}
\ No newline at end of file
+}
+
+/// Exposes the rainflow counter state so a restore can be checked member by member
+class lifetime_cycle_probe : public lifetime_cycle_t
+{
+public:
+	lifetime_cycle_probe(const util::matrix_t<double> &cycles_vs_DOD) : lifetime_cycle_t(cycles_vs_DOD) {}
+	int nCycles() { return _nCycles; }
+	double q() { return _q; }
+	std::vector<double> Peaks() { return _Peaks; }
+};
+
+class LifetimeCycle : public ::testing::Test
+{
+protected:
+	lifetime_cycle_probe * lifetime_model;
+
+	void SetUp()
+	{
+		double table[] = { 20, 0, 100,
+			20, 5000, 80,
+			80, 0, 100,
+			80, 1000, 80,
+			100, 0, 100,
+			100, 400, 80 };
+		util::matrix_t<double> cycles_vs_DOD(6, 3);
+		cycles_vs_DOD.assign(table, 6, 3);
+		lifetime_model = new lifetime_cycle_probe(cycles_vs_DOD);
+	}
+	void TearDown()
+	{
+		if (lifetime_model)
+			delete lifetime_model;
+	}
+
+	// depth of discharge at step i of an irregular daily profile with nested partial cycles
+	double DOD(int i)
+	{
+		double profile[] = { 10, 70, 40, 55, 20, 90, 30, 60, 5, 45, 35, 85, 15 };
+		return profile[i % 13] + (i / 13) % 3;
+	}
+};
+
+TEST_F(LifetimeCycle, StateRestoresRainflowCounter_lib_battery)
+{
+	for (int i = 0; i < 40; i++)
+		lifetime_model->runCycleLifetime(DOD(i));
+
+	lifetime_cycle_t::cycle_state state;
+	lifetime_model->get_state(state);
+	int nCycles = lifetime_model->nCycles();
+	double q = lifetime_model->q();
+	std::vector<double> Peaks = lifetime_model->Peaks();
+	ASSERT_GT(nCycles, 0);
+	ASSERT_LT(q, 100);
+	ASSERT_FALSE(Peaks.empty());
+
+	std::vector<double> q_first;
+	for (int i = 40; i < 100; i++)
+		q_first.push_back(lifetime_model->runCycleLifetime(DOD(i)));
+	EXPECT_GT(lifetime_model->nCycles(), nCycles);
+	EXPECT_LT(lifetime_model->q(), q);
+
+	lifetime_model->set_state(state);
+	EXPECT_EQ(nCycles, lifetime_model->nCycles());
+	EXPECT_EQ(q, lifetime_model->q());
+	EXPECT_EQ(Peaks, lifetime_model->Peaks());
+
+	// the restored counter continues exactly as the original did
+	for (int i = 40; i < 100; i++)
+		EXPECT_EQ(q_first[i - 40], lifetime_model->runCycleLifetime(DOD(i))) << "step " << i;
+
+	// a state saved into storage that already holds a longer peak stack is overwritten, not appended
+	lifetime_model->set_state(state);
+	lifetime_cycle_t::cycle_state reused = state;
+	reused.Peaks.resize(Peaks.size() + 10, -1);
+	lifetime_model->get_state(reused);
+	EXPECT_EQ(Peaks, reused.Peaks);
+	EXPECT_EQ(nCycles, reused.nCycles);
+	EXPECT_EQ(q, reused.q);
+}
+
+/// Lithium ion battery with all submodels, set up the way cmod_battery builds it
+class LithiumIonBatteryModel : public ::testing::Test
+{
+protected:
+	battery_t * battery_model;
+
+	void SetUp()
+	{
+		double dt_hour = 1;
+		int n_series = 139, n_strings = 10;
+		double Qfull = 2.25;
+
+		capacity_t * capacity_model = new capacity_lithium_ion_t(Qfull * n_strings, 50, 95, 15);
+		voltage_t * voltage_model = new voltage_dynamic_t(n_series, n_strings, 3.6, 4.1, 4.05, 3.4, Qfull, 0.178, 2.0, 0.2, 0.2);
+
+		double cycles[] = { 20, 0, 100, 20, 5000, 80, 80, 0, 100, 80, 1000, 80, 100, 0, 100, 100, 400, 80 };
+		util::matrix_t<double> cycles_vs_DOD(6, 3);
+		cycles_vs_DOD.assign(cycles, 6, 3);
+		lifetime_cycle_t * lifetime_cycle_model = new lifetime_cycle_t(cycles_vs_DOD);
+		lifetime_calendar_t * lifetime_calendar_model = new lifetime_calendar_t(lifetime_calendar_t::LITHIUM_ION_CALENDAR_MODEL, util::matrix_t<double>(), dt_hour);
+		lifetime_t * lifetime_model = new lifetime_t(lifetime_cycle_model, lifetime_calendar_model, 0, 50);
+
+		double temps[] = { -10, 60, 0, 80, 25, 100, 40, 100 };
+		util::matrix_t<double> cap_vs_temp(4, 2);
+		cap_vs_temp.assign(temps, 4, 2);
+		thermal_t * thermal_model = new thermal_t(507, 0.58, 0.58, 0.58, 1004, 20, 293.15, cap_vs_temp);
+
+		double_vec no_loss(8760, 0);
+		losses_t * losses_model = new losses_t(lifetime_model, thermal_model, capacity_model, losses_t::MONTHLY, no_loss, no_loss, no_loss, no_loss);
+
+		battery_model = new battery_t(dt_hour, battery_t::LITHIUM_ION);
+		battery_model->initialize(capacity_model, voltage_model, lifetime_model, thermal_model, losses_model);
+	}
+	void TearDown()
+	{
+		if (battery_model)
+		{
+			battery_model->delete_clone();
+			delete battery_model;
+		}
+	}
+
+	// charge and discharge current [A] at step i, with idle hours and currents that run into the SOC limits
+	double current(size_t i)
+	{
+		double pattern[] = { 8, 12, 0, -6, -15, -3, 0, 10, 14, 5, -9, -12, 0, 0, 7, -4 };
+		return pattern[i % 16] * (1 + 0.1 * ((i / 16) % 4));
+	}
+};
+
+TEST_F(LithiumIonBatteryModel, StateRestoresBatteryRun_lib_battery)
+{
+	size_t idx = 0;
+	for (; idx < 500; idx++)
+		battery_model->run(idx, current(idx));
+
+	battery_t::battery_state state;
+	battery_model->get_state(state);
+
+	const size_t n = 200;
+	std::vector<double> soc(n), temperature(n), capacity(n), lifetime(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		battery_model->run(idx + i, current(idx + i));
+		soc[i] = battery_model->battery_soc();
+		temperature[i] = battery_model->thermal_model()->T_battery();
+		capacity[i] = battery_model->battery_charge_maximum();
+		lifetime[i] = battery_model->lifetime_model()->capacity_percent();
+	}
+	ASSERT_LT(lifetime[n - 1], 100);
+
+	battery_model->set_state(state);
+	for (size_t i = 0; i < n; i++)
+	{
+		battery_model->run(idx + i, current(idx + i));
+		EXPECT_EQ(soc[i], battery_model->battery_soc()) << "step " << i;
+		EXPECT_EQ(temperature[i], battery_model->thermal_model()->T_battery()) << "step " << i;
+		EXPECT_EQ(capacity[i], battery_model->battery_charge_maximum()) << "step " << i;
+		EXPECT_EQ(lifetime[i], battery_model->lifetime_model()->capacity_percent()) << "step " << i;
+	}
+}
@@ -137,6 +137,51 @@ TEST_F(weatherfileTest, EPWTest) {
 	EXPECT_TRUE(wf.nrecords() == 8760 * 2);
 }
 
+/// Writing a binary cache and reading it back should reproduce every record of the text file
+TEST_F(weatherfileTest, BinaryCacheRoundTrip) {
+	char filepath[150];
+	sprintf(filepath, "%s/test/input_docs/weather_30m.epw", std::getenv("SSCDIR"));
+	file = std::string(filepath);
+	ASSERT_TRUE(wf.open(file));
+
+	std::string cache = weatherfile::binary_cache_file(file);
+	ASSERT_TRUE(wf.write_binary(cache, file));
+
+	weatherfile wfb;
+	ASSERT_TRUE(wfb.read_binary(cache, file)) << wfb.message();
+	EXPECT_EQ(wfb.type(), wf.type());
+	EXPECT_EQ(wfb.nrecords(), wf.nrecords());
+	EXPECT_EQ(wfb.step_sec(), wf.step_sec());
+	EXPECT_EQ(wfb.start_sec(), wf.start_sec());
+	EXPECT_EQ(wfb.header().city, wf.header().city);
+	EXPECT_EQ(wfb.lat(), wf.lat());
+	for (size_t k = 0; k < weather_data_provider::_MAXCOL_; k++)
+		EXPECT_EQ(wfb.has_data_column(k), wf.has_data_column(k)) << "column " << k;
+
+	weather_record r, rb;
+	wf.rewind();
+	for (size_t i = 0; i < wf.nrecords(); i++)
+	{
+		ASSERT_TRUE(wf.read(&r));
+		ASSERT_TRUE(wfb.read(&rb));
+		EXPECT_EQ(r.hour, rb.hour) << "record " << i;
+		EXPECT_EQ(r.minute, rb.minute) << "record " << i;
+		EXPECT_EQ(r.dn, rb.dn) << "record " << i;
+		EXPECT_EQ(r.tdry, rb.tdry) << "record " << i;
+		EXPECT_EQ(r.twet, rb.twet) << "record " << i;
+	}
+	EXPECT_FALSE(wfb.read(&rb));
+
+	// with the cache enabled, opening the text file picks up the sidecar
+	weatherfile::enable_binary_cache(true);
+	weatherfile wfc;
+	EXPECT_TRUE(wfc.open(file));
+	EXPECT_EQ(wfc.nrecords(), wf.nrecords());
+	weatherfile::enable_binary_cache(false);
+
+	util::remove_file(cache.c_str());
+}
+
 /**
 * \class weatherdataTest
 *
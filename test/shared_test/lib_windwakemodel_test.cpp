@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 #include <lib_physics.h>
 #include <lib_windwakemodel.h>
@@ -184,4 +186,49 @@ TEST_F(eddyViscosityWakeModelTest, wakeCalcTriangleInterference_lib_windwakemode
 		EXPECT_NEAR(turbIntensity[i], 0.1, e) << "Turb intensity at turbine " << i;
 	}
 	EXPECT_EQ(turbIntensity[1], turbIntensity[2]);
-}
\ No newline at end of file
+}
+/// A rotated 10 by 10 farm gives the same results whether its turbines are shared over one thread or several
+TEST_F(eddyViscosityWakeModelTest, wakeCalcThreadsMatchSerial_lib_windwakemodel){
+	numberTurbines = 100;
+	const double angles[] = { 0, 7, 30, 45, 71 };
+	for (size_t a = 0; a < 5; a++){
+		double angle = angles[a] * M_PI / 180;
+
+		// layout with 7 diameter spacing, sorted downwind as the wind farm does
+		std::vector<std::pair<double, double> > layout;
+		for (int i = 0; i < numberTurbines; i++){
+			double x = 7. * (i % 10), y = 7. * (i / 10);
+			layout.push_back(std::make_pair(x * cos(angle) + y * sin(angle), y * cos(angle) - x * sin(angle)));
+		}
+		std::sort(layout.begin(), layout.end());
+		distDownwind.resize(numberTurbines);
+		distCrosswind.resize(numberTurbines);
+		for (int i = 0; i < numberTurbines; i++){
+			distDownwind[i] = layout[i].first - layout[0].first;
+			distCrosswind[i] = layout[i].second;
+		}
+
+		std::vector<double> results[2][5];
+		const size_t threads[2] = { 1, 4 };
+		for (size_t t = 0; t < 2; t++){
+			eddyViscosityWakeModel model(numberTurbines, &wt, 0.1);
+			model.setThreads(threads[t]);
+			thrust.assign(numberTurbines, 0.47669);
+			power.assign(numberTurbines, 1190);
+			eff.assign(numberTurbines, 0);
+			windSpeed.assign(numberTurbines, 10.);
+			turbIntensity.assign(numberTurbines, 0.1);
+			model.wakeCalculations(seaLevelAirDensity, &distDownwind[0], &distCrosswind[0], &power[0], &eff[0], &thrust[0], &windSpeed[0], &turbIntensity[0]);
+			results[t][0] = thrust;
+			results[t][1] = power;
+			results[t][2] = eff;
+			results[t][3] = windSpeed;
+			results[t][4] = turbIntensity;
+		}
+		for (size_t k = 0; k < 5; k++){
+			for (int i = 0; i < numberTurbines; i++)
+				EXPECT_EQ(results[0][k][i], results[1][k][i]) << "Output " << k << " at turbine " << i << " for wind at " << angles[a] << " degrees";
+		}
+		EXPECT_LT(results[0][1][numberTurbines - 1], 1190) << "Wakes expected at the last turbine for wind at " << angles[a] << " degrees";
+	}
+}
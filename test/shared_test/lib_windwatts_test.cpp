@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include <lib_windwatts.h>
@@ -87,4 +89,110 @@ TEST_F(windPowerCalculatorTest, windPowerUsingWeibull_lib_windwatts){
 
 	double energyTotal = wpc.windPowerUsingWeibull(weibullK, avgSpeed, refHeight, &energy[0]); // runs method we want to test
 	EXPECT_NEAR(energyTotal, 5639180, e);
-}
\ No newline at end of file
+}
+
+/**
+ * windWakeCacheTest runs the same farm through two calculators, one with the wake cache at the default steps (1 deg, 0.5 m/s)
+ * and one running the wake model every time. The test is repeated for the simple (0), Park (1) and eddy-viscosity (2) models.
+ */
+
+class windWakeCacheTest : public ::testing::TestWithParam<int>{
+protected:
+	windTurbine wt;
+	windPowerCalculator cached, exact;
+	size_t nTurbines;
+	double pressureAtm, tempC;
+
+	// bounds at the default steps: farm power as a fraction of rated farm power, and speed at each turbine in m/s.
+	// The largest errors are near cut-in, where the thrust coefficient and so the wake deficit change fastest with speed
+	double farmPowerTol = 0.005;
+	double windSpeedTol = 0.1;
+
+	std::shared_ptr<wakeModelBase> makeWakeModel(){
+		switch (GetParam()){
+		case 0: return std::shared_ptr<wakeModelBase>(new simpleWakeModel(nTurbines, &wt));
+		case 1: return std::shared_ptr<wakeModelBase>(new parkWakeModel(nTurbines, &wt));
+		default: return std::shared_ptr<wakeModelBase>(new eddyViscosityWakeModel(nTurbines, &wt, 0.1));
+		}
+	}
+
+	void SetUp(){
+		createDefaultTurbine(&wt);
+		pressureAtm = 0.95;
+		tempC = 15.;
+
+		// 3 x 3 farm on a 5 diameter grid, the middle row offset by half a spacing
+		std::vector<double> x, y;
+		for (int i = 0; i < 3; i++){
+			for (int j = 0; j < 3; j++){
+				x.push_back(5. * wt.rotorDiameter * (j + 0.5 * (i % 2)));
+				y.push_back(5. * wt.rotorDiameter * i);
+			}
+		}
+		nTurbines = x.size();
+
+		windPowerCalculator* wpcs[2] = { &cached, &exact };
+		for (int k = 0; k < 2; k++){
+			wpcs[k]->nTurbines = nTurbines;
+			wpcs[k]->turbulenceIntensity = 0.1;
+			wpcs[k]->windTurb = &wt;
+			wpcs[k]->XCoords = x;
+			wpcs[k]->YCoords = y;
+			wpcs[k]->InitializeModel(makeWakeModel());
+		}
+		ASSERT_TRUE(cached.InitializeWakeCache(1.0, 0.5));
+	}
+
+	/// runs both calculators at one speed and direction, returns the difference in farm power over rated farm power and the largest turbine speed difference
+	void compare(double windSpeed, double windDir, double &farmPowerErr, double &windSpeedErr){
+		std::vector<double> power(nTurbines), thrust(nTurbines), eff(nTurbines), wind(nTurbines), TI(nTurbines), distDown(nTurbines), distCross(nTurbines);
+		std::vector<double> powerEx(nTurbines), windEx(nTurbines);
+		double farmPower = 0., farmPowerExact = 0., ratedFarmPower = 1500. * nTurbines;
+		ASSERT_EQ(cached.windPowerUsingResource(windSpeed, windDir, pressureAtm, tempC, &farmPower, &power[0], &thrust[0], &eff[0], &wind[0], &TI[0], &distDown[0], &distCross[0]), (int)nTurbines);
+		ASSERT_EQ(exact.windPowerUsingResource(windSpeed, windDir, pressureAtm, tempC, &farmPowerExact, &powerEx[0], &thrust[0], &eff[0], &windEx[0], &TI[0], &distDown[0], &distCross[0]), (int)nTurbines);
+		farmPowerErr = fabs(farmPower - farmPowerExact) / ratedFarmPower;
+		windSpeedErr = 0.;
+		for (size_t i = 0; i < nTurbines; i++)
+			windSpeedErr = max_of(windSpeedErr, fabs(wind[i] - windEx[i]));
+	}
+};
+
+/// Between the cache nodes the interpolated farm power and turbine speeds stay within the stated bounds of the wake model
+TEST_P(windWakeCacheTest, CacheMatchesWakeModel_lib_windwatts){
+	for (double windDir = 0.3; windDir < 360.; windDir += 7.7){
+		for (double windSpeed = 3.1; windSpeed < 25.; windSpeed += 0.83){
+			double farmPowerErr, windSpeedErr;
+			compare(windSpeed, windDir, farmPowerErr, windSpeedErr);
+			EXPECT_LT(farmPowerErr, farmPowerTol) << "speed " << windSpeed << " direction " << windDir;
+			EXPECT_LT(windSpeedErr, windSpeedTol) << "speed " << windSpeed << " direction " << windDir;
+		}
+	}
+}
+
+/// Directions just below 360 interpolate between the last node and the node at 0
+TEST_P(windWakeCacheTest, CacheWrapsAroundNorth_lib_windwatts){
+	double windDirs[] = { 359.2, 359.6, 359.99, 0., 0.4, 360.3, -0.4 };
+	for (size_t k = 0; k < sizeof(windDirs) / sizeof(double); k++){
+		for (double windSpeed = 4.2; windSpeed < 25.; windSpeed += 2.9){
+			double farmPowerErr, windSpeedErr;
+			compare(windSpeed, windDirs[k], farmPowerErr, windSpeedErr);
+			EXPECT_LT(farmPowerErr, farmPowerTol) << "speed " << windSpeed << " direction " << windDirs[k];
+			EXPECT_LT(windSpeedErr, windSpeedTol) << "speed " << windSpeed << " direction " << windDirs[k];
+		}
+	}
+}
+
+/// Where the free stream turbine produces nothing, including speeds past the end of the power curve, the cache defers to the wake model
+TEST_P(windWakeCacheTest, CacheFallsBackOutsidePowerCurve_lib_windwatts){
+	double windSpeeds[] = { 0., 1.5, 26., 33.3, 40., 41.7, 55. };
+	for (size_t k = 0; k < sizeof(windSpeeds) / sizeof(double); k++){
+		for (double windDir = 11.; windDir < 360.; windDir += 45.){
+			double farmPowerErr, windSpeedErr;
+			compare(windSpeeds[k], windDir, farmPowerErr, windSpeedErr);
+			EXPECT_EQ(farmPowerErr, 0.) << "speed " << windSpeeds[k] << " direction " << windDir;
+			EXPECT_EQ(windSpeedErr, 0.) << "speed " << windSpeeds[k] << " direction " << windDir;
+		}
+	}
+}
+
+INSTANTIATE_TEST_CASE_P(WakeModels, windWakeCacheTest, ::testing::Values(0, 1, 2));
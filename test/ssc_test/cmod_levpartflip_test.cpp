@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+
+#include "../input_cases/code_generator_utilities.h"
+
+/**
+ * CMLevPartFlip runs the leveraged partnership flip financial model on a synthetic generation profile.
+ */
+class CMLevPartFlip : public ::testing::Test {
+public:
+	static void set_defaults(ssc_data_t p) {
+		ssc_number_t gen[8760];
+		for (int h = 0; h < 8760; h++) {
+			double hod = h % 24;
+			double day = (h / 24) / 365.0;
+			double sun = sin(M_PI * (hod - 6.) / 12.);
+			gen[h] = (ssc_number_t)(sun > 0 ? 4000. * sun * (0.8 + 0.2 * cos(2 * M_PI * (day - 0.5))) : 0.);
+		}
+		ssc_data_set_array(p, "gen", gen, 8760);
+		ssc_number_t degradation[1] = { 0.5 };
+		ssc_data_set_array(p, "degradation", degradation, 1);
+		ssc_number_t fed_tax[1] = { 21 };
+		ssc_data_set_array(p, "federal_tax_rate", fed_tax, 1);
+		ssc_number_t state_tax[1] = { 7 };
+		ssc_data_set_array(p, "state_tax_rate", state_tax, 1);
+		ssc_number_t depr_custom[1] = { 0 };
+		ssc_data_set_array(p, "depr_custom_schedule", depr_custom, 1);
+		ssc_data_set_number(p, "real_discount_rate", 6.4);
+		ssc_data_set_number(p, "inflation_rate", 2.5);
+		ssc_data_set_number(p, "system_capacity", 5000);
+		ssc_data_set_number(p, "system_use_lifetime_output", 0);
+		ssc_data_set_number(p, "total_installed_cost", 10.e6);
+		ssc_data_set_number(p, "construction_financing_cost", 0.);
+
+		// two time of delivery periods: afternoon peak on weekdays, flat on weekends
+		ssc_number_t weekday[12 * 24], weekend[12 * 24];
+		for (int i = 0; i < 12 * 24; i++) {
+			int hod = i % 24;
+			weekday[i] = (ssc_number_t)(hod >= 12 && hod < 19 ? 1 : 2);
+			weekend[i] = 2;
+		}
+		ssc_data_set_matrix(p, "dispatch_sched_weekday", weekday, 12, 24);
+		ssc_data_set_matrix(p, "dispatch_sched_weekend", weekend, 12, 24);
+		const double factors[9] = { 1.5, 0.9, 1., 1., 1., 1., 1., 1., 1. };
+		for (int i = 0; i < 9; i++) {
+			std::string name = "dispatch_factor" + std::to_string(i + 1);
+			ssc_data_set_number(p, name.c_str(), (ssc_number_t)factors[i]);
+		}
+	}
+};
+
+/// The solved PPA price and flip year match the results from before the IRR and NPV were moved to common_financial
+TEST_F(CMLevPartFlip, SolvedPpaMatchesBaseline) {
+	struct { const char *name[2]; double value[2]; double ppa; int flip_year; } cases[] = {
+		{ { "flip_target_percent", "total_installed_cost" }, { 11., 10.e6 }, 17.21696472, 11 },
+		{ { "flip_target_percent", "total_installed_cost" }, { 15., 12.e6 }, 21.39437485, 11 },
+		{ { "flip_target_year", "analysis_period" }, { 8., 20. }, 18.55390167, 8 },
+	};
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		ssc_data_t p = ssc_data_create();
+		set_defaults(p);
+		for (int j = 0; j < 2; j++)
+			ssc_data_set_number(p, cases[c].name[j], (ssc_number_t)cases[c].value[j]);
+		ASSERT_EQ(0, run_module(p, "levpartflip")) << "case " << c;
+
+		// the PPA price is solved to a relative tolerance of ppa_soln_tolerance, 1e-3 by default
+		ssc_number_t ppa = 0, flip_year = 0;
+		ASSERT_TRUE(ssc_data_get_number(p, "ppa", &ppa));
+		ASSERT_TRUE(ssc_data_get_number(p, "flip_actual_year", &flip_year));
+		EXPECT_NEAR(cases[c].ppa, ppa, 1.e-3 * cases[c].ppa) << "case " << c;
+		EXPECT_EQ(cases[c].flip_year, (int)flip_year) << "case " << c;
+		ssc_data_free(p);
+	}
+}
@@ -68,6 +68,39 @@ TEST_F(CMPvsamv1PowerIntegration, DefaultLifetimeNoFinancialModel) {
 	}
 }
 
+/// Run PVSAMv1 in lifetime mode with the year 1 irradiance replayed in later years
+TEST_F(CMPvsamv1PowerIntegration, LifetimeIrradianceReplay) {
+
+	std::map<std::string, double> pairs;
+	pairs["system_use_lifetime_output"] = 1;
+	pairs["analysis_period"] = 25;
+
+	double dc_degradation[25];
+	for (size_t i = 0; i < 25; i++) {
+		dc_degradation[i] = 0.5;
+	}
+	ssc_data_set_array(data, "dc_degradation", (ssc_number_t*)dc_degradation, 25);
+
+	int pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	int n_gen = 0;
+	ssc_number_t * p_gen = ssc_data_get_array(data, "gen", &n_gen);
+	ASSERT_TRUE(p_gen != 0);
+	std::vector<ssc_number_t> gen_full(p_gen, p_gen + n_gen);
+
+	pairs["en_lifetime_irrad_replay"] = 1;
+	pvsam_errors = modify_ssc_data_and_run_module(data, "pvsamv1", pairs);
+	EXPECT_FALSE(pvsam_errors);
+
+	int n_gen_replay = 0;
+	ssc_number_t * p_gen_replay = ssc_data_get_array(data, "gen", &n_gen_replay);
+	ASSERT_EQ(n_gen, n_gen_replay);
+	for (int i = 0; i < n_gen; i++) {
+		EXPECT_NEAR(gen_full[i], p_gen_replay[i], 1e-3) << "Lifetime generation at step " << i;
+	}
+}
+
 
 /// Test PVSAMv1 with all defaults and residential financial model
 TEST_F(CMPvsamv1PowerIntegration, DefaultResidentialModel)
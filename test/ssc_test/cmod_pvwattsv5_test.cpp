@@ -37,4 +37,77 @@ TEST_F(CMPvwattsV5Integration, DefaultNoFinancialModel){
 	ssc_data_get_number(data, "capacity_factor", &capacity_factor);
 	EXPECT_NEAR(capacity_factor, 19.7197, error_tolerance) << "Capacity factor";
 
-}
\ No newline at end of file
+}
+
+/// A batch of identical PVWattsV5 cases should reproduce the single-case result for every case
+TEST(SSCBatchTest, PVWattsV5MatchesSingleRun)
+{
+	ssc_data_t reference = ssc_data_create();
+	EXPECT_FALSE(pvwattsv5_nofinancial_testfile(reference));
+	ASSERT_TRUE(ssc_module_exec_simple("pvwattsv5", reference));
+	ssc_number_t annual_energy_ref;
+	ssc_data_get_number(reference, "annual_energy", &annual_energy_ref);
+
+	const int ncases = 6;
+	std::vector<ssc_data_t> cases;
+	ssc_batch_t batch = ssc_batch_create("pvwattsv5", 3);
+	ASSERT_TRUE(batch != NULL);
+	for (int i = 0; i < ncases; i++)
+	{
+		cases.push_back(ssc_data_create());
+		pvwattsv5_nofinancial_testfile(cases[i]);
+		EXPECT_EQ(ssc_batch_add(batch, cases[i]), i);
+	}
+	EXPECT_EQ(ssc_batch_count(batch), ncases);
+	EXPECT_EQ(ssc_batch_status(batch, 0), SSC_BATCH_PENDING);
+
+	EXPECT_TRUE(ssc_batch_run(batch));
+
+	for (int i = 0; i < ncases; i++)
+	{
+		EXPECT_EQ(ssc_batch_status(batch, i), SSC_BATCH_SUCCESS) << "case " << i;
+		ssc_number_t annual_energy = 0;
+		ssc_data_get_number(cases[i], "annual_energy", &annual_energy);
+		EXPECT_EQ(annual_energy, annual_energy_ref) << "case " << i;
+		ssc_data_free(cases[i]);
+	}
+
+	ssc_batch_free(batch);
+	ssc_data_free(reference);
+}
+
+/// A failing case is reported with its error log and does not affect the other cases
+TEST(SSCBatchTest, FailedCaseIsReported)
+{
+	ssc_data_t good = ssc_data_create();
+	ssc_data_t bad = ssc_data_create();
+	pvwattsv5_nofinancial_testfile(good);
+	pvwattsv5_nofinancial_testfile(bad);
+	ssc_data_unassign(bad, "system_capacity");
+
+	ssc_batch_t batch = ssc_batch_create("pvwattsv5", 2);
+	ssc_batch_add(batch, bad);
+	ssc_batch_add(batch, good);
+
+	EXPECT_FALSE(ssc_batch_run(batch));
+	EXPECT_EQ(ssc_batch_status(batch, 0), SSC_BATCH_FAILED);
+	EXPECT_EQ(ssc_batch_status(batch, 1), SSC_BATCH_SUCCESS);
+	EXPECT_EQ(ssc_batch_status(batch, 2), SSC_INVALID);
+
+	int type = 0;
+	bool found_error = false;
+	const char *text;
+	for (int i = 0; (text = ssc_batch_log(batch, 0, i, &type, 0)) != NULL; i++)
+		if (type == SSC_ERROR) found_error = true;
+	EXPECT_TRUE(found_error);
+
+	ssc_batch_free(batch);
+	ssc_data_free(good);
+	ssc_data_free(bad);
+}
+
+/// Invalid module names are rejected when the batch is created
+TEST(SSCBatchTest, InvalidModule)
+{
+	EXPECT_TRUE(ssc_batch_create("not_a_module", 2) == NULL);
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "../input_cases/code_generator_utilities.h"
+
+/**
+ * CMSco2CspSystem designs a molten salt heated sCO2 cycle without off-design cases.
+ * The test is repeated for the recompression (1) and partial cooling (2) cycle configurations.
+ */
+class CMSco2CspSystem : public ::testing::TestWithParam<int> {
+public:
+	/// designs the cycle and returns the calculated thermal efficiency
+	static double design_eta(int cycle_config, int n_multi_start, int n_threads, double & P_comp_out) {
+		ssc_data_t data = ssc_data_create();
+		ssc_data_set_number(data, "htf", 17);
+		ssc_data_set_number(data, "T_htf_hot_des", 574.);
+		ssc_data_set_number(data, "dT_PHX_hot_approach", 20.);
+		ssc_data_set_number(data, "T_amb_des", 35.);
+		ssc_data_set_number(data, "dT_mc_approach", 6.);
+		ssc_data_set_number(data, "site_elevation", 300.);
+		ssc_data_set_number(data, "W_dot_net_des", 50.);
+		ssc_data_set_number(data, "design_method", 2);
+		ssc_data_set_number(data, "UA_recup_tot_des", 15000.);
+		ssc_data_set_number(data, "cycle_config", cycle_config);
+		ssc_data_set_number(data, "des_n_multi_start", n_multi_start);
+		ssc_data_set_number(data, "des_n_threads", n_threads);
+		ssc_data_set_number(data, "eta_isen_mc", 0.89);
+		ssc_data_set_number(data, "eta_isen_rc", 0.89);
+		ssc_data_set_number(data, "eta_isen_pc", 0.89);
+		ssc_data_set_number(data, "eta_isen_t", 0.90);
+		ssc_data_set_number(data, "LT_recup_eff_max", 1.0);
+		ssc_data_set_number(data, "HT_recup_eff_max", 1.0);
+		ssc_data_set_number(data, "P_high_limit", 25.);
+		ssc_data_set_number(data, "dT_PHX_cold_approach", 20.);
+		ssc_data_set_number(data, "fan_power_frac", 0.01);
+		ssc_data_set_number(data, "deltaP_cooler_frac", 0.002);
+
+		double eta = 0;
+		P_comp_out = 0;
+		if (run_module(data, "sco2_csp_system") == 0) {
+			ssc_number_t val = 0;
+			if (ssc_data_get_number(data, "eta_thermal_calc", &val))
+				eta = val;
+			if (ssc_data_get_number(data, "P_comp_out", &val))
+				P_comp_out = val;
+			ssc_data_free(data);
+		}
+		return eta;
+	}
+};
+
+/// Extra starting points can only replace the single-start design with a better one
+TEST_P(CMSco2CspSystem, MultiStartAtLeastSingleStart) {
+	int cycle_config = GetParam();
+	double P_single, P_multi;
+	double eta_single = design_eta(cycle_config, 1, 1, P_single);
+	double eta_multi = design_eta(cycle_config, 3, 1, P_multi);
+
+	ASSERT_GT(eta_single, 0.) << "cycle config " << cycle_config;
+	EXPECT_GE(eta_multi, eta_single) << "cycle config " << cycle_config;
+}
+
+/// The multi-start design doesn't depend on the number of threads
+TEST_P(CMSco2CspSystem, MultiStartThreadsMatchSerial) {
+	int cycle_config = GetParam();
+	double P_serial, P_parallel;
+	double eta_serial = design_eta(cycle_config, 3, 1, P_serial);
+	double eta_parallel = design_eta(cycle_config, 3, 4, P_parallel);
+
+	ASSERT_GT(eta_serial, 0.) << "cycle config " << cycle_config;
+	EXPECT_EQ(eta_serial, eta_parallel) << "cycle config " << cycle_config;
+	EXPECT_EQ(P_serial, P_parallel) << "cycle config " << cycle_config;
+}
+
+INSTANTIATE_TEST_CASE_P(CycleConfigs, CMSco2CspSystem, ::testing::Values(1, 2));
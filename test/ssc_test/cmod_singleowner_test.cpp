@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+
+#include "../input_cases/code_generator_utilities.h"
+
+/**
+ * CMSingleOwner runs the single owner financial model on a synthetic generation profile.
+ * Scenario sweeps through scenario_inputs must give the same metrics as one standalone run per scenario.
+ */
+class CMSingleOwner : public ::testing::Test {
+public:
+	ssc_data_t data;
+
+	void SetUp() {
+		data = ssc_data_create();
+		set_defaults(data);
+	}
+	void TearDown() {
+		if (data) ssc_data_free(data);
+	}
+
+	static void set_defaults(ssc_data_t p) {
+		ssc_number_t gen[8760];
+		for (int h = 0; h < 8760; h++) {
+			double hod = h % 24;
+			double day = (h / 24) / 365.0;
+			double sun = sin(M_PI * (hod - 6.) / 12.);
+			gen[h] = (ssc_number_t)(sun > 0 ? 4000. * sun * (0.8 + 0.2 * cos(2 * M_PI * (day - 0.5))) : 0.);
+		}
+		ssc_data_set_array(p, "gen", gen, 8760);
+		ssc_number_t degradation[1] = { 0.5 };
+		ssc_data_set_array(p, "degradation", degradation, 1);
+		ssc_number_t fed_tax[1] = { 21 };
+		ssc_data_set_array(p, "federal_tax_rate", fed_tax, 1);
+		ssc_number_t state_tax[1] = { 7 };
+		ssc_data_set_array(p, "state_tax_rate", state_tax, 1);
+		ssc_number_t depr_custom[1] = { 0 };
+		ssc_data_set_array(p, "depr_custom_schedule", depr_custom, 1);
+		ssc_data_set_number(p, "real_discount_rate", 6.4);
+		ssc_data_set_number(p, "inflation_rate", 2.5);
+		ssc_data_set_number(p, "system_capacity", 5000);
+		ssc_data_set_number(p, "system_use_lifetime_output", 0);
+		ssc_data_set_number(p, "total_installed_cost", 10.e6);
+		ssc_data_set_number(p, "construction_financing_cost", 0.);
+
+		// two time of delivery periods: afternoon peak on weekdays, flat on weekends
+		ssc_number_t weekday[12 * 24], weekend[12 * 24];
+		for (int i = 0; i < 12 * 24; i++) {
+			int hod = i % 24;
+			weekday[i] = (ssc_number_t)(hod >= 12 && hod < 19 ? 1 : 2);
+			weekend[i] = 2;
+		}
+		ssc_data_set_matrix(p, "dispatch_sched_weekday", weekday, 12, 24);
+		ssc_data_set_matrix(p, "dispatch_sched_weekend", weekend, 12, 24);
+		const double factors[9] = { 1.5, 0.9, 1., 1., 1., 1., 1., 1., 1. };
+		for (int i = 0; i < 9; i++) {
+			std::string name = "dispatch_factor" + std::to_string(i + 1);
+			ssc_data_set_number(p, name.c_str(), (ssc_number_t)factors[i]);
+		}
+	}
+
+	/// runs the metrics for one set of overrides on a fresh copy of the default inputs
+	void run_standalone(const char *names[], const ssc_number_t values[], size_t n, ssc_number_t metrics[], const char *metric_names[], size_t nmetrics) {
+		ssc_data_t p = ssc_data_create();
+		set_defaults(p);
+		for (size_t j = 0; j < n; j++)
+			ssc_data_set_number(p, names[j], values[j]);
+		ASSERT_EQ(0, run_module(p, "singleowner"));
+		for (size_t k = 0; k < nmetrics; k++)
+			ASSERT_TRUE(ssc_data_get_number(p, metric_names[k], &metrics[k])) << metric_names[k];
+		ssc_data_free(p);
+	}
+
+	/// runs the module without discarding the data on failure, unlike run_module
+	bool exec_singleowner() {
+		ssc_module_t module = ssc_module_create("singleowner");
+		bool ok = ssc_module_exec(module, data) != 0;
+		ssc_module_free(module);
+		return ok;
+	}
+
+	void compare_scenarios(const char *names[], size_t n, ssc_number_t *scen, size_t nrows) {
+		std::string list;
+		for (size_t j = 0; j < n; j++)
+			list += (j > 0 ? ", " : "") + std::string(names[j]);
+		ssc_data_set_string(data, "scenario_input_names", list.c_str());
+		ssc_data_set_matrix(data, "scenario_inputs", scen, (int)nrows, (int)n);
+		ASSERT_EQ(0, run_module(data, "singleowner"));
+
+		const char *outputs[] = { "scenario_ppa", "scenario_lppa_nom", "scenario_lcoe_nom", "scenario_lcoe_real",
+			"scenario_project_return_aftertax_irr", "scenario_project_return_aftertax_npv", "scenario_flip_actual_irr",
+			"scenario_size_of_debt", "scenario_min_dscr" };
+		const char *metrics[] = { "ppa", "lppa_nom", "lcoe_nom", "lcoe_real", "project_return_aftertax_irr",
+			"project_return_aftertax_npv", "flip_actual_irr", "size_of_debt", "min_dscr" };
+		const size_t nmetrics = sizeof(metrics) / sizeof(metrics[0]);
+
+		for (size_t r = 0; r < nrows; r++) {
+			ssc_number_t expected[nmetrics];
+			run_standalone(names, &scen[r*n], n, expected, metrics, nmetrics);
+			for (size_t k = 0; k < nmetrics; k++) {
+				int len = 0;
+				ssc_number_t *actual = ssc_data_get_array(data, outputs[k], &len);
+				ASSERT_TRUE(actual != NULL) << outputs[k];
+				ASSERT_EQ((int)nrows, len) << outputs[k];
+				EXPECT_EQ(expected[k], actual[r]) << outputs[k] << " scenario " << r;
+			}
+		}
+	}
+};
+
+/// Scenarios that leave the generation inputs alone reuse the energy calculation of the first row
+TEST_F(CMSingleOwner, ScenariosMatchStandaloneRuns) {
+	const char *names[] = { "total_installed_cost", "flip_target_percent" };
+	ssc_number_t scen[] = { 8.e6, 9.,
+							12.e6, 13. };
+	compare_scenarios(names, 2, scen, 2);
+}
+
+/// Scenarios that change the analysis period redo the energy calculation for every row
+TEST_F(CMSingleOwner, EnergyScenariosMatchStandaloneRuns) {
+	const char *names[] = { "analysis_period", "total_installed_cost" };
+	ssc_number_t scen[] = { 20., 9.e6,
+							30., 11.e6 };
+	compare_scenarios(names, 2, scen, 2);
+}
+
+/// Each scenario value is checked against the constraints of its input
+TEST_F(CMSingleOwner, ScenarioInputsAreValidated) {
+	ssc_data_set_number(data, "flip_target_percent", 12.);
+	ssc_number_t out_of_range[] = { 11., 150. };
+	ssc_data_set_string(data, "scenario_input_names", "flip_target_percent");
+	ssc_data_set_matrix(data, "scenario_inputs", out_of_range, 2, 1);
+	EXPECT_FALSE(exec_singleowner());
+
+	ssc_number_t not_integer[] = { 1.5 };
+	ssc_data_set_string(data, "scenario_input_names", "ppa_soln_mode");
+	ssc_data_set_matrix(data, "scenario_inputs", not_integer, 1, 1);
+	EXPECT_FALSE(exec_singleowner());
+
+	ssc_number_t array_input[] = { 1. };
+	ssc_data_set_string(data, "scenario_input_names", "degradation");
+	ssc_data_set_matrix(data, "scenario_inputs", array_input, 1, 1);
+	EXPECT_FALSE(exec_singleowner());
+
+	// a failed sweep leaves the original inputs in place
+	ssc_number_t flip_target = 0;
+	ASSERT_TRUE(ssc_data_get_number(data, "flip_target_percent", &flip_target));
+	EXPECT_EQ(12., flip_target);
+	ssc_number_t *degradation = ssc_data_get_array(data, "degradation", NULL);
+	ASSERT_TRUE(degradation != NULL);
+	EXPECT_EQ((ssc_number_t)0.5, degradation[0]);
+}
+
+/// The solved PPA price and flip year match the results from before the IRR and NPV were moved to common_financial
+TEST_F(CMSingleOwner, SolvedPpaMatchesBaseline) {
+	struct { const char *name[2]; double value[2]; double ppa; int flip_year; } cases[] = {
+		{ { "flip_target_percent", "total_installed_cost" }, { 11., 10.e6 }, 16.63827896, 11 },
+		{ { "flip_target_percent", "total_installed_cost" }, { 15., 12.e6 }, 20.68486595, 11 },
+		{ { "flip_target_year", "analysis_period" }, { 8., 20. }, 17.92505646, 8 },
+	};
+	for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+		ssc_data_t p = ssc_data_create();
+		set_defaults(p);
+		for (int j = 0; j < 2; j++)
+			ssc_data_set_number(p, cases[c].name[j], (ssc_number_t)cases[c].value[j]);
+		ASSERT_EQ(0, run_module(p, "singleowner")) << "case " << c;
+
+		// the PPA price is solved to a relative tolerance of ppa_soln_tolerance, 1e-5 by default
+		ssc_number_t ppa = 0, flip_year = 0;
+		ASSERT_TRUE(ssc_data_get_number(p, "ppa", &ppa));
+		ASSERT_TRUE(ssc_data_get_number(p, "flip_actual_year", &flip_year));
+		EXPECT_NEAR(cases[c].ppa, ppa, 1.e-5 * cases[c].ppa) << "case " << c;
+		EXPECT_EQ(cases[c].flip_year, (int)flip_year) << "case " << c;
+		ssc_data_free(p);
+	}
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+#include "../input_cases/code_generator_utilities.h"
+
+/**
+ * CMUtilityRate5Batch compares the batch_load/batch_gen bills of utilityrate5 with separate runs of each profile.
+ * The test is repeated for every metering option, which covers both the monthly and the time step reconciliation.
+ */
+class CMUtilityRate5Batch : public ::testing::TestWithParam<int> {
+public:
+	int nprofiles = 3;
+	std::vector<ssc_number_t> batch_load;
+	std::vector<ssc_number_t> batch_gen;
+
+	void SetUp() {
+		batch_load.resize(nprofiles * 8760);
+		batch_gen.resize(nprofiles * 8760);
+		for (int r = 0; r < nprofiles; r++) {
+			for (int h = 0; h < 8760; h++) {
+				double hod = h % 24;
+				double doy = h / 24;
+				double sun = sin(M_PI * (hod - 6.) / 12.);
+				double season = cos(2. * M_PI * (doy - 200.) / 365.);
+				batch_load[r * 8760 + h] = (ssc_number_t)((1. + r) * (0.8 + 0.4 * season + (hod >= 16 && hod < 21 ? 0.9 : 0.) + 0.1 * ((h * 7 + r) % 5)));
+				batch_gen[r * 8760 + h] = (ssc_number_t)(sun > 0 ? (1.5 + 2. * r) * sun * (0.85 - 0.15 * season) : 0.);
+			}
+		}
+	}
+
+	/// two period time of use tariff with tiered energy rates and both demand charges
+	static void set_tariff(ssc_data_t data, int metering_option) {
+		ssc_data_set_number(data, "analysis_period", 1);
+		ssc_data_set_number(data, "system_use_lifetime_output", 0);
+		ssc_data_set_number(data, "inflation_rate", 2.5);
+		ssc_number_t degradation[1] = { 0 };
+		ssc_data_set_array(data, "degradation", degradation, 1);
+		ssc_data_set_number(data, "ur_metering_option", (ssc_number_t)metering_option);
+		ssc_data_set_number(data, "ur_nm_yearend_sell_rate", 0.03);
+		ssc_data_set_number(data, "ur_monthly_fixed_charge", 12.);
+		ssc_data_set_number(data, "ur_monthly_min_charge", 20.);
+
+		ssc_number_t weekday[12 * 24], weekend[12 * 24];
+		for (int i = 0; i < 12 * 24; i++) {
+			int hod = i % 24;
+			weekday[i] = (ssc_number_t)(hod >= 16 && hod < 21 ? 1 : 2);
+			weekend[i] = 2;
+		}
+		ssc_data_set_matrix(data, "ur_ec_sched_weekday", weekday, 12, 24);
+		ssc_data_set_matrix(data, "ur_ec_sched_weekend", weekend, 12, 24);
+		ssc_number_t ec_tou[] = { 1, 1, 300, 0, 0.25, 0.08,
+								  1, 2, 1e38, 0, 0.32, 0.08,
+								  2, 1, 300, 0, 0.11, 0.05,
+								  2, 2, 1e38, 0, 0.14, 0.05 };
+		ssc_data_set_matrix(data, "ur_ec_tou_mat", ec_tou, 4, 6);
+
+		ssc_data_set_number(data, "ur_dc_enable", 1);
+		ssc_data_set_matrix(data, "ur_dc_sched_weekday", weekday, 12, 24);
+		ssc_data_set_matrix(data, "ur_dc_sched_weekend", weekend, 12, 24);
+		ssc_number_t dc_tou[] = { 1, 1, 1e38, 8.5,
+								  2, 1, 1e38, 2. };
+		ssc_data_set_matrix(data, "ur_dc_tou_mat", dc_tou, 2, 4);
+		ssc_number_t dc_flat[12 * 4];
+		for (int m = 0; m < 12; m++) {
+			dc_flat[m * 4] = (ssc_number_t)m;
+			dc_flat[m * 4 + 1] = 1;
+			dc_flat[m * 4 + 2] = (ssc_number_t)1e38;
+			dc_flat[m * 4 + 3] = (ssc_number_t)(m >= 5 && m <= 8 ? 4. : 1.5);
+		}
+		ssc_data_set_matrix(data, "ur_dc_flat_mat", dc_flat, 12, 4);
+	}
+};
+
+TEST_P(CMUtilityRate5Batch, BatchRowsMatchSingleRuns) {
+	int metering_option = GetParam();
+
+	ssc_data_t batch = ssc_data_create();
+	set_tariff(batch, metering_option);
+	ssc_data_set_array(batch, "load", &batch_load[0], 8760);
+	ssc_data_set_array(batch, "gen", &batch_gen[0], 8760);
+	ssc_data_set_matrix(batch, "batch_load", &batch_load[0], nprofiles, 8760);
+	ssc_data_set_matrix(batch, "batch_gen", &batch_gen[0], nprofiles, 8760);
+	ASSERT_EQ(0, run_module(batch, "utilityrate5"));
+
+	int nr = 0, nc = 0, len = 0;
+	ssc_number_t *batch_w_sys = ssc_data_get_matrix(batch, "batch_monthly_utility_bill_w_sys", &nr, &nc);
+	ASSERT_TRUE(batch_w_sys != NULL);
+	ASSERT_EQ(nprofiles, nr);
+	ASSERT_EQ(12, nc);
+	ssc_number_t *batch_wo_sys = ssc_data_get_matrix(batch, "batch_monthly_utility_bill_wo_sys", &nr, &nc);
+	ASSERT_TRUE(batch_wo_sys != NULL);
+	ASSERT_EQ(nprofiles, nr);
+	ASSERT_EQ(12, nc);
+	ssc_number_t *annual_w_sys = ssc_data_get_array(batch, "batch_utility_bill_w_sys", &len);
+	ASSERT_EQ(nprofiles, len);
+	ssc_number_t *annual_wo_sys = ssc_data_get_array(batch, "batch_utility_bill_wo_sys", &len);
+	ASSERT_EQ(nprofiles, len);
+
+	for (int r = 0; r < nprofiles; r++) {
+		ssc_data_t single = ssc_data_create();
+		set_tariff(single, metering_option);
+		ssc_data_set_array(single, "load", &batch_load[r * 8760], 8760);
+		ssc_data_set_array(single, "gen", &batch_gen[r * 8760], 8760);
+		ASSERT_EQ(0, run_module(single, "utilityrate5"));
+
+		ssc_number_t *w_sys = ssc_data_get_array(single, "year1_monthly_utility_bill_w_sys", &len);
+		ASSERT_EQ(12, len);
+		ssc_number_t *wo_sys = ssc_data_get_array(single, "year1_monthly_utility_bill_wo_sys", &len);
+		ASSERT_EQ(12, len);
+		double sum_w_sys = 0, sum_wo_sys = 0;
+		for (int m = 0; m < 12; m++) {
+			EXPECT_EQ(w_sys[m], batch_w_sys[r * 12 + m]) << "metering option " << metering_option << ", profile " << r << ", month " << m;
+			EXPECT_EQ(wo_sys[m], batch_wo_sys[r * 12 + m]) << "metering option " << metering_option << ", profile " << r << ", month " << m;
+			sum_w_sys += w_sys[m];
+			sum_wo_sys += wo_sys[m];
+		}
+		EXPECT_NEAR(sum_w_sys, annual_w_sys[r], 1e-4 * fabs(sum_w_sys) + 1e-2) << "metering option " << metering_option << ", profile " << r;
+		EXPECT_NEAR(sum_wo_sys, annual_wo_sys[r], 1e-4 * fabs(sum_wo_sys) + 1e-2) << "metering option " << metering_option << ", profile " << r;
+		ssc_data_free(single);
+	}
+	ssc_data_free(batch);
+}
+
+INSTANTIATE_TEST_CASE_P(MeteringOptions, CMUtilityRate5Batch, ::testing::Values(0, 1, 2, 3, 4));
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "../ssc/common_financial.h"
+
+/**
+ * The npv and irr that the single owner, partnership flip, sale leaseback and host developer models each carried
+ * before they were shared as cf_npv and cf_irr, kept here to check the shared versions against.
+ * 'last_guess' records the initial guess of the last Newton iteration, to tell which retry found the solution.
+ */
+class module_irr
+{
+public:
+	util::matrix_t<double> cf;
+	double last_guess;
+
+	double npv( int cf_line, int nyears, double rate )
+	{
+		double rr = 1.0;
+		if (rate != -1.0) rr = 1.0/(1.0+rate);
+		double result = 0;
+		for (int i=nyears;i>0;i--)
+			result = rr * result + cf.at(cf_line,i);
+
+		return result*rr;
+	}
+
+	bool is_valid_iter_bound(double estimated_return_rate)
+	{
+		return estimated_return_rate != -1 && (estimated_return_rate < std::numeric_limits<int>::max()) && (estimated_return_rate > std::numeric_limits<int>::min());
+	}
+
+	double irr_poly_sum(double estimated_return_rate, int cf_line, int count)
+	{
+		double sum_of_polynomial = 0;
+		if (is_valid_iter_bound(estimated_return_rate))
+		{
+			for (int j = 0; j <= count ; j++)
+			{
+				double val = (pow((1 + estimated_return_rate), j));
+				if (val != 0.0)
+					sum_of_polynomial += cf.at(cf_line,j)/val;
+				else
+					break;
+			}
+		}
+		return sum_of_polynomial;
+	}
+
+	double irr_derivative_sum(double estimated_return_rate,int cf_line, int count)
+	{
+		double sum_of_derivative = 0;
+		if (is_valid_iter_bound(estimated_return_rate))
+			for (int i = 1; i <= count ; i++)
+			{
+				sum_of_derivative += cf.at(cf_line,i)*(i)/pow((1 + estimated_return_rate), i+1);
+			}
+		return sum_of_derivative*-1;
+	}
+
+	double irr_scale_factor( int cf_unscaled, int count)
+	{
+		// scale to max value for better irr convergence
+		if (count<1) return 1.0;
+		int i=0;
+		double max=fabs(cf.at(cf_unscaled,0));
+		for (i=0;i<=count;i++)
+			if (fabs(cf.at(cf_unscaled,i))> max) max =fabs(cf.at(cf_unscaled,i));
+		return (max>0 ? max:1);
+	}
+
+	bool is_valid_irr( int cf_line, int count, double residual, double tolerance, int number_of_iterations, int max_iterations, double calculated_irr, double scale_factor )
+	{
+		double npv_of_irr = npv(cf_line,count,calculated_irr)+cf.at(cf_line,0);
+		double npv_of_irr_plus_delta = npv(cf_line,count,calculated_irr+0.001)+cf.at(cf_line,0);
+		bool is_valid = ( (number_of_iterations<max_iterations) && (fabs(residual)<tolerance) && (npv_of_irr>npv_of_irr_plus_delta) && (fabs(npv_of_irr/scale_factor)<tolerance) );
+		return is_valid;
+	}
+
+	double irr( int cf_line, int count, double initial_guess=-2, double tolerance=1e-6, int max_iterations=100 )
+	{
+		int number_of_iterations=0;
+		double calculated_irr = std::numeric_limits<double>::quiet_NaN();
+		last_guess = std::numeric_limits<double>::quiet_NaN();
+
+		if (count < 1)
+			return calculated_irr;
+
+		// only possible for first value negative
+		if ( (cf.at(cf_line,0) <= 0))
+		{
+			// initial guess from http://zainco.blogspot.com/2008/08/internal-rate-of-return-using-newton.html
+			if ((initial_guess < -1) && (count > 1))// second order
+			{
+				if (cf.at(cf_line,0) !=0)
+				{
+					double b = 2.0+ cf.at(cf_line,1)/cf.at(cf_line,0);
+					double c = 1.0+cf.at(cf_line,1)/cf.at(cf_line,0)+cf.at(cf_line,2)/cf.at(cf_line,0);
+					initial_guess = -0.5*b - 0.5*sqrt(b*b-4.0*c);
+					if ((initial_guess <= 0) || (initial_guess >= 1)) initial_guess = -0.5*b + 0.5*sqrt(b*b-4.0*c);
+				}
+			}
+			else if (initial_guess < 0) // first order
+			{
+				if (cf.at(cf_line,0) !=0) initial_guess = -(1.0 + cf.at(cf_line,1)/cf.at(cf_line,0));
+			}
+
+			double scale_factor = irr_scale_factor(cf_line,count);
+			double residual=DBL_MAX;
+
+			calculated_irr = irr_calc(cf_line,count,initial_guess,tolerance,max_iterations,scale_factor,number_of_iterations,residual);
+
+			if (!is_valid_irr(cf_line,count,residual,tolerance,number_of_iterations,max_iterations,calculated_irr,scale_factor)) // try 0.1 as initial guess
+			{
+				initial_guess=0.1;
+				number_of_iterations=0;
+				residual=0;
+				calculated_irr = irr_calc(cf_line,count,initial_guess,tolerance,max_iterations,scale_factor,number_of_iterations,residual);
+			}
+
+			if (!is_valid_irr(cf_line,count,residual,tolerance,number_of_iterations,max_iterations,calculated_irr,scale_factor)) // try -0.1 as initial guess
+			{
+				initial_guess=-0.1;
+				number_of_iterations=0;
+				residual=0;
+				calculated_irr = irr_calc(cf_line,count,initial_guess,tolerance,max_iterations,scale_factor,number_of_iterations,residual);
+			}
+			if (!is_valid_irr(cf_line,count,residual,tolerance,number_of_iterations,max_iterations,calculated_irr,scale_factor)) // try 0 as initial guess
+			{
+				initial_guess=0;
+				number_of_iterations=0;
+				residual=0;
+				calculated_irr = irr_calc(cf_line,count,initial_guess,tolerance,max_iterations,scale_factor,number_of_iterations,residual);
+			}
+
+			if (!is_valid_irr(cf_line,count,residual,tolerance,number_of_iterations,max_iterations,calculated_irr,scale_factor)) // try 0.1 as initial guess
+			{
+				calculated_irr = std::numeric_limits<double>::quiet_NaN(); // did not converge
+			}
+			last_guess = initial_guess;
+		}
+		return calculated_irr;
+	}
+
+	double irr_calc( int cf_line, int count, double initial_guess, double tolerance, int max_iterations, double scale_factor, int &number_of_iterations, double &residual )
+	{
+		double calculated_irr = std::numeric_limits<double>::quiet_NaN();
+		double deriv_sum = irr_derivative_sum(initial_guess, cf_line, count);
+		if (deriv_sum != 0.0)
+			calculated_irr = initial_guess - irr_poly_sum(initial_guess,cf_line,count)/deriv_sum;
+		else
+			return initial_guess;
+
+		number_of_iterations++;
+
+		residual = irr_poly_sum(calculated_irr,cf_line,count) / scale_factor;
+
+		while (!(fabs(residual) <= tolerance) && (number_of_iterations < max_iterations))
+		{
+			deriv_sum = irr_derivative_sum(initial_guess,cf_line,count);
+			if (deriv_sum != 0.0)
+				calculated_irr = calculated_irr - irr_poly_sum(calculated_irr,cf_line,count)/deriv_sum;
+			else
+				break;
+
+			number_of_iterations++;
+			residual = irr_poly_sum(calculated_irr,cf_line,count) / scale_factor;
+		}
+		return calculated_irr;
+	}
+};
+
+/**
+ * Cash flows, one per row of the matrix, are solved by both the shared and the per-module versions.
+ * Row 0 is an unused line, as in the financial models, where the cash flow of interest is rarely the first row.
+ */
+class CommonFinancialIRR : public ::testing::Test
+{
+protected:
+	module_irr ref;
+
+	void set_cash_flow(const std::vector<double> &values)
+	{
+		ref.cf.resize_fill(2, values.size(), 0.0);
+		for (size_t i = 0; i < values.size(); i++)
+			ref.cf.at(1, i) = values[i];
+	}
+
+	/// solves the cash flow with both versions at every count, and returns the per-module initial guess at the full count
+	double expect_same_irr(const std::vector<double> &values)
+	{
+		set_cash_flow(values);
+		int n = (int)values.size() - 1;
+		for (int count = 0; count <= n; count++)
+		{
+			double expected = ref.irr(1, count);
+			double actual = cf_irr(ref.cf, 1, count);
+			if (std::isnan(expected))
+				EXPECT_TRUE(std::isnan(actual)) << "count " << count << " irr " << actual;
+			else
+				EXPECT_NEAR(expected, actual, 1e-9) << "count " << count;
+		}
+		ref.irr(1, n);
+		return ref.last_guess;
+	}
+
+	void expect_same_npv(const std::vector<double> &values)
+	{
+		set_cash_flow(values);
+		int n = (int)values.size() - 1;
+		double rates[] = { -0.5, -0.1, 0.0, 0.064, 0.1, 0.25, 1.0 };
+		for (size_t k = 0; k < sizeof(rates) / sizeof(double); k++)
+			for (int nyears = 0; nyears <= n; nyears++)
+				EXPECT_NEAR(ref.npv(1, nyears, rates[k]), cf_npv(ref.cf, 1, nyears, rates[k]), 1e-9 * ref.irr_scale_factor(1, n))
+					<< "rate " << rates[k] << " years " << nyears;
+	}
+};
+
+TEST_F(CommonFinancialIRR, ProjectCashFlows_common_financial)
+{
+	// level returns after an up-front cost, and a project sized cash flow with debt service and a final year reversal
+	std::vector<double> level(16, 120.);
+	level[0] = -1000.;
+	expect_same_irr(level);
+	expect_same_npv(level);
+
+	double project[] = { -3.2e7, 2.9e6, 3.1e6, 3.3e6, 3.2e6, 3.4e6, 3.6e6, 3.5e6, 3.7e6, 3.9e6, 4.1e6, 4.0e6, 4.2e6, 4.4e6, 4.3e6,
+		4.5e6, 4.6e6, 4.8e6, 4.7e6, 4.9e6, 5.0e6, 2.1e6, 2.2e6, 2.0e6, 2.3e6, -1.5e6 };
+	std::vector<double> cf(project, project + sizeof(project) / sizeof(double));
+	expect_same_irr(cf);
+	expect_same_npv(cf);
+
+	// the estimate from the first years converges without a retry
+	double quick[] = { -1000., 300., 350., 400., 450. };
+	cf.assign(quick, quick + 5);
+	double guess = expect_same_irr(cf);
+	EXPECT_NE(0.1, guess);
+	EXPECT_NE(-0.1, guess);
+	EXPECT_NE(0., guess);
+	EXPECT_NEAR(0.170936, cf_irr(ref.cf, 1, 4), 1e-6);
+}
+
+TEST_F(CommonFinancialIRR, RetryGuesses_common_financial)
+{
+	// the initial estimate fails and the retry from 0.1 converges
+	double retry1[] = { -594, -240, -273, -59, 134, 307, 111, 222, 191, 252, 146, 205, 381, 366 };
+	std::vector<double> cf(retry1, retry1 + sizeof(retry1) / sizeof(double));
+	EXPECT_EQ(0.1, expect_same_irr(cf));
+	expect_same_npv(cf);
+
+	// negative rate of return: the retry from -0.1 converges
+	double retry2[] = { -1029, 6, 139, 30, 97, 151, 78, 91, 132 };
+	cf.assign(retry2, retry2 + sizeof(retry2) / sizeof(double));
+	EXPECT_EQ(-0.1, expect_same_irr(cf));
+	expect_same_npv(cf);
+
+	// slow early returns: only the last retry, from 0, converges
+	double retry3[] = { -336, 0, 7, 10, 5, 2, 22, 21, 2, 17, 41, 32, 11, 26, 50, 6, 7, 27, 23, 52, 67, 12, 5, 5, 46 };
+	cf.assign(retry3, retry3 + sizeof(retry3) / sizeof(double));
+	EXPECT_EQ(0., expect_same_irr(cf));
+	EXPECT_FALSE(std::isnan(cf_irr(ref.cf, 1, (int)cf.size() - 1)));
+	expect_same_npv(cf);
+}
+
+TEST_F(CommonFinancialIRR, NoSolution_common_financial)
+{
+	// a large final year cost: none of the guesses converge
+	double reversal[] = { -740, 114, 77, 100, 80, 6, 66, 140, 140, 108, 43, 111, 96, 53, 103, 25, -880 };
+	std::vector<double> cf(reversal, reversal + sizeof(reversal) / sizeof(double));
+	expect_same_irr(cf);
+	EXPECT_TRUE(std::isnan(cf_irr(ref.cf, 1, (int)cf.size() - 1)));
+
+	// two roots, with the NPV rising through the lower one
+	double two_roots[] = { -100, 230, -132 };
+	cf.assign(two_roots, two_roots + 3);
+	expect_same_irr(cf);
+	EXPECT_TRUE(std::isnan(cf_irr(ref.cf, 1, 2)));
+
+	// a positive first year, a single year and an all zero cash flow are not solved
+	double positive[] = { 100, -50, -60 };
+	cf.assign(positive, positive + 3);
+	expect_same_irr(cf);
+	EXPECT_TRUE(std::isnan(cf_irr(ref.cf, 1, 2)));
+	cf.assign(4, 0.);
+	expect_same_irr(cf);
+	EXPECT_TRUE(std::isnan(cf_irr(ref.cf, 1, 0)));
+}
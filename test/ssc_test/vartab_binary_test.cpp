@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../ssc/sscapi.h"
+#include "../ssc/vartab.h"
+
+/// Writes a data object to a binary file, reads it back into a new data object and checks every variable
+class vartabBinaryTest : public ::testing::Test {
+protected:
+	ssc_data_t data_;
+	std::string file_;
+
+	void SetUp() {
+		data_ = ssc_data_create();
+		file_ = "vartab_binary_test.bin";
+	}
+	void TearDown() {
+		ssc_data_free(data_);
+		remove(file_.c_str());
+	}
+
+	ssc_data_t roundTrip() {
+		EXPECT_TRUE(ssc_data_write_binary(data_, file_.c_str()) != 0);
+		ssc_data_t copy = ssc_data_create();
+		EXPECT_TRUE(ssc_data_read_binary(copy, file_.c_str()) != 0);
+		return copy;
+	}
+
+	void expectEqual(ssc_data_t expected, ssc_data_t actual) {
+		var_table *vt_exp = static_cast<var_table*>(expected);
+		var_table *vt_act = static_cast<var_table*>(actual);
+		ASSERT_EQ(vt_exp->size(), vt_act->size());
+		const char *name = vt_exp->first();
+		while (name) {
+			var_data *v_exp = vt_exp->lookup(name);
+			var_data *v_act = vt_act->lookup(name);
+			ASSERT_TRUE(v_act != NULL) << name << " is missing";
+			ASSERT_EQ(v_exp->type, v_act->type) << name;
+			switch (v_exp->type) {
+			case SSC_STRING:
+				EXPECT_EQ(v_exp->str, v_act->str) << name;
+				break;
+			case SSC_NUMBER:
+			case SSC_ARRAY:
+			case SSC_MATRIX:
+				ASSERT_EQ(v_exp->num.nrows(), v_act->num.nrows()) << name;
+				ASSERT_EQ(v_exp->num.ncols(), v_act->num.ncols()) << name;
+				for (size_t i = 0; i < v_exp->num.nrows()*v_exp->num.ncols(); i++)
+					EXPECT_EQ(v_exp->num.data()[i], v_act->num.data()[i]) << name << "[" << i << "]";
+				break;
+			case SSC_TABLE:
+				expectEqual(&v_exp->table, &v_act->table);
+				break;
+			}
+			name = vt_exp->next();
+		}
+	}
+
+	std::vector<unsigned char> readFile() {
+		std::vector<unsigned char> buf;
+		FILE *fp = fopen(file_.c_str(), "rb");
+		if (!fp) return buf;
+		int c;
+		while ((c = fgetc(fp)) != EOF)
+			buf.push_back((unsigned char)c);
+		fclose(fp);
+		return buf;
+	}
+
+	void writeFile(const std::vector<unsigned char> &buf, size_t len) {
+		FILE *fp = fopen(file_.c_str(), "wb");
+		if (!fp) return;
+		if (len > 0) fwrite(&buf[0], 1, len, fp);
+		fclose(fp);
+	}
+
+	void setAllTypes(ssc_data_t p) {
+		ssc_data_set_string(p, "str", "a string with an odd length");
+		ssc_data_set_string(p, "str_empty", "");
+		ssc_data_set_number(p, "num", 3.25);
+		ssc_number_t arr[5] = { 1., -2.5, 1.e-10, 1.e10, 0. };
+		ssc_data_set_array(p, "arr", arr, 5);
+		ssc_data_set_array(p, "arr_empty", arr, 0);
+		ssc_number_t mat[6] = { 1., 2., 3., 4., 5., 6. };
+		ssc_data_set_matrix(p, "mat", mat, 2, 3);
+	}
+};
+
+TEST_F(vartabBinaryTest, RoundTripAllTypes) {
+	setAllTypes(data_);
+
+	ssc_data_t copy = roundTrip();
+	expectEqual(data_, copy);
+	ssc_data_free(copy);
+}
+
+TEST_F(vartabBinaryTest, RoundTripNestedTable) {
+	ssc_data_t inner = ssc_data_create();
+	setAllTypes(inner);
+	ssc_data_t middle = ssc_data_create();
+	setAllTypes(middle);
+	ssc_data_set_table(middle, "inner", inner);
+	ssc_data_set_table(data_, "middle", middle);
+	ssc_data_set_number(data_, "num", -1.);
+	ssc_data_free(middle);
+	ssc_data_free(inner);
+
+	ssc_data_t copy = roundTrip();
+	expectEqual(data_, copy);
+	ssc_data_free(copy);
+}
+
+TEST_F(vartabBinaryTest, RoundTripEmptyTable) {
+	ssc_data_t copy = roundTrip();
+	EXPECT_EQ(0, (int)static_cast<var_table*>(copy)->size());
+	ssc_data_free(copy);
+}
+
+TEST_F(vartabBinaryTest, ReadReplacesContents) {
+	ssc_data_set_number(data_, "num", 1.);
+	ASSERT_TRUE(ssc_data_write_binary(data_, file_.c_str()) != 0);
+
+	ssc_data_t copy = ssc_data_create();
+	ssc_data_set_string(copy, "stale", "removed by the read");
+	ASSERT_TRUE(ssc_data_read_binary(copy, file_.c_str()) != 0);
+	expectEqual(data_, copy);
+	ssc_data_free(copy);
+}
+
+TEST_F(vartabBinaryTest, TruncatedInput) {
+	setAllTypes(data_);
+	ssc_data_t inner = ssc_data_create();
+	setAllTypes(inner);
+	ssc_data_set_table(data_, "inner", inner);
+	ssc_data_free(inner);
+	ASSERT_TRUE(ssc_data_write_binary(data_, file_.c_str()) != 0);
+	std::vector<unsigned char> buf = readFile();
+	ASSERT_FALSE(buf.empty());
+
+	// every prefix of the file is rejected and leaves the data object empty
+	ssc_data_t copy = ssc_data_create();
+	for (size_t len = 0; len < buf.size(); len++) {
+		ssc_data_set_number(copy, "stale", 1.);
+		writeFile(buf, len);
+		EXPECT_EQ(0, ssc_data_read_binary(copy, file_.c_str())) << "length " << len;
+		EXPECT_EQ(0, (int)static_cast<var_table*>(copy)->size()) << "length " << len;
+	}
+	ssc_data_free(copy);
+}
+
+TEST_F(vartabBinaryTest, CorruptInput) {
+	ssc_number_t arr[3] = { 1., 2., 3. };
+	ssc_data_set_array(data_, "arr", arr, 3);
+	ASSERT_TRUE(ssc_data_write_binary(data_, file_.c_str()) != 0);
+	std::vector<unsigned char> good = readFile();
+	// 24 byte header, 16 bytes of variable count, name and type, 16 bytes of dimensions, then the padded values
+	ASSERT_EQ(56 + (3 * sizeof(ssc_number_t) + 7) / 8 * 8, good.size());
+
+	// header: magic, version, byte order mark, size of ssc_number_t
+	size_t header_bytes[4] = { 0, 8, 12, 16 };
+	for (size_t i = 0; i < 4; i++) {
+		std::vector<unsigned char> bad(good);
+		bad[header_bytes[i]] ^= 0xFF;
+		writeFile(bad, bad.size());
+		ssc_data_t copy = ssc_data_create();
+		EXPECT_EQ(0, ssc_data_read_binary(copy, file_.c_str())) << "header byte " << header_bytes[i];
+		EXPECT_EQ(0, (int)static_cast<var_table*>(copy)->size());
+		ssc_data_free(copy);
+	}
+
+	// table: variable count at 24, name length at 32, type at 39, rows at 40, cols at 48
+	size_t table_bytes[5] = { 24, 32, 39, 40, 48 };
+	for (size_t i = 0; i < 5; i++) {
+		std::vector<unsigned char> bad(good);
+		bad[table_bytes[i] + (i == 2 ? 0 : 3)] = 0x7F;
+		writeFile(bad, bad.size());
+		ssc_data_t copy = ssc_data_create();
+		EXPECT_EQ(0, ssc_data_read_binary(copy, file_.c_str())) << "table byte " << table_bytes[i];
+		EXPECT_EQ(0, (int)static_cast<var_table*>(copy)->size());
+		ssc_data_free(copy);
+	}
+
+	// missing file
+	remove(file_.c_str());
+	ssc_data_t copy = ssc_data_create();
+	EXPECT_EQ(0, ssc_data_read_binary(copy, file_.c_str()));
+	ssc_data_free(copy);
+}
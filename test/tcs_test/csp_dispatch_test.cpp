@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "../tcs/csp_dispatch.h"
+
+/**
+ * Rolling-horizon dispatch of a synthetic tower plant with storage. The expected field output, cycle efficiency
+ * and price signal are filled in directly instead of being predicted from a weather file and plant models.
+ */
+class CspDispatchTest : public ::testing::Test
+{
+protected:
+	static const int nt = 24;			//horizon [hr]
+	static const int n_windows = 4;		//rolling-horizon windows, one day apart
+
+	C_csp_messages messages;
+	std::vector<double> cloud;
+
+	void SetUp()
+	{
+		// repeatable cloudy hours
+		unsigned seed = 12345;
+		cloud.resize(n_windows * 24 + nt);
+		for (size_t h = 0; h < cloud.size(); h++)
+		{
+			seed = seed * 1103515245u + 12345u;
+			double r1 = ((seed >> 8) & 0xffff) / 65535.;
+			seed = seed * 1103515245u + 12345u;
+			double r2 = ((seed >> 8) & 0xffff) / 65535.;
+			cloud[h] = r1 < 0.25 ? 0.3 + 0.5*r2 : 1.;
+		}
+	}
+
+	void setup_plant(csp_dispatch_opt &d, int presolve_type)
+	{
+		double q_pb = 287000., q_rec = 670000.;		//[kWt]
+		csp_dispatch_opt::s_params &p = d.params;
+		p.dt = 1.;
+		p.e_tes_max = 10.*q_pb;
+		p.e_tes_min = 0.;
+		p.q_pb_des = q_pb;
+		p.eta_cycle_ref = 0.4125;
+		p.q_pb_max = 1.05*q_pb;
+		p.q_pb_min = 0.25*q_pb;
+		p.q_pb_standby = 0.2*q_pb;
+		p.e_pb_startup_cold = 0.5*q_pb;
+		p.e_pb_startup_hot = 0.25*q_pb;
+		p.dt_pb_startup_cold = 0.5;
+		p.dt_pb_startup_hot = 0.25;
+		p.e_rec_startup = 0.25*q_rec;
+		p.dt_rec_startup = 0.2;
+		p.q_rec_min = 0.25*q_rec;
+		p.q_rec_standby = 9.e99;
+		p.w_rec_pump = 0.0165;
+		p.w_rec_ht = 0.;
+		p.w_track = 500.;
+		p.w_stow = 0.;
+		p.w_cycle_standby = 0.;
+		p.w_cycle_pump = 0.0055;
+		p.tes_degrade_rate = 0.;
+		p.sf_effadj = 1.;
+		p.disp_time_weighting = 0.99;
+		p.rsu_cost = 952.;
+		p.csu_cost = 10000.;
+		p.pen_delta_w = 0.1;
+		p.messages = &messages;
+		p.is_pb_operating0 = p.is_pb_standby0 = p.is_rec_operating0 = false;
+		p.q_pb0 = 0.;
+		p.e_tes_init = 0.;
+		p.eff_table_load.add_point(0., 0.);
+		for (int i = 0; i < 6; i++)
+		{
+			double f = 0.25 + 0.8*i / 5.;
+			p.eff_table_load.add_point(f*q_pb, p.eta_cycle_ref*(0.85 + 0.15*sqrt(f)));
+		}
+
+		d.solver_params.mip_gap = 0.005;
+		d.solver_params.max_bb_iter = 35000;		//stops the harder windows short of the gap, which keeps the test quick
+		d.solver_params.solution_timeout = 600.;
+		d.solver_params.presolve_type = presolve_type;
+		d.solver_params.is_write_ampl_dat = false;
+		d.solver_params.is_ampl_engine = false;
+	}
+
+	/// expected performance and prices for the window starting at hour 'h0'
+	void set_forecast(csp_dispatch_opt &d, int h0)
+	{
+		double q_rec = 670000.;
+		d.outputs.q_sfavail_expected.clear();
+		d.outputs.eta_pb_expected.clear();
+		d.outputs.f_pb_op_limit.clear();
+		d.outputs.w_condf_expected.clear();
+		d.outputs.eta_sf_expected.clear();
+		d.price_signal.assign(nt, 1.);
+		d.w_lim.assign(nt, 1.e99);
+		for (int t = 0; t < nt; t++)
+		{
+			int h = h0 + t, hour = h % 24, day = h / 24;
+			double sun = std::max(0., sin(M_PI*(hour - 6.) / 12.));
+			d.outputs.q_sfavail_expected.push_back(1.2*q_rec*sun*cloud[h]);
+			d.outputs.eta_pb_expected.push_back(1. - 0.03*sun);
+			d.outputs.f_pb_op_limit.push_back(1.);
+			d.outputs.w_condf_expected.push_back(0.01 + 0.01*sun);
+			d.outputs.eta_sf_expected.push_back(1.);
+			d.price_signal[t] = hour < 6 ? 0.6 : (hour >= 15 && hour < 20 ? 2.2 : 1.0);
+			// a curtailed night, so the net power limit changes between windows
+			if (day == 1 && hour >= 1 && hour < 4)
+				d.w_lim[t] = 0.;
+		}
+		d.params.info_time = h0*3600.;
+		d.set_horizon(nt);
+	}
+};
+
+/// Keeping the model between windows finds dispatch plans as good as solving each window from a new model
+TEST_F(CspDispatchTest, ReusedModelMatchesRebuilt_csp_dispatch)
+{
+	csp_dispatch_opt reused;
+	setup_plant(reused, csp_dispatch_opt::s_solver_params::PRESOLVE_TYPE_OFF);
+
+	for (int w = 0; w < n_windows; w++)
+	{
+		set_forecast(reused, 24 * w);
+		ASSERT_TRUE(reused.optimize()) << "window " << w;
+
+		// same window and initial state, solved by a dispatch object that builds its model from scratch
+		csp_dispatch_opt rebuilt;
+		setup_plant(rebuilt, csp_dispatch_opt::s_solver_params::PRESOLVE_TYPE_OFF);
+		rebuilt.params.e_tes_init = reused.params.e_tes_init;
+		rebuilt.params.is_pb_operating0 = reused.params.is_pb_operating0;
+		rebuilt.params.is_pb_standby0 = reused.params.is_pb_standby0;
+		rebuilt.params.is_rec_operating0 = reused.params.is_rec_operating0;
+		rebuilt.params.q_pb0 = reused.params.q_pb0;
+		set_forecast(rebuilt, 24 * w);
+		ASSERT_TRUE(rebuilt.optimize()) << "window " << w;
+
+		// the relaxed problems are the same, and the plans found by branch and bound are within the MIP gap of each other
+		double tol = reused.solver_params.mip_gap * std::max(fabs(reused.outputs.objective_relaxed), fabs(rebuilt.outputs.objective_relaxed));
+		EXPECT_NEAR(reused.outputs.objective_relaxed, rebuilt.outputs.objective_relaxed, 1.e-6*fabs(rebuilt.outputs.objective_relaxed)) << "window " << w;
+		EXPECT_NEAR(reused.outputs.objective, rebuilt.outputs.objective, tol) << "window " << w;
+
+		// the next window starts from the state at the end of the first day
+		int k = 23;
+		reused.params.e_tes_init = reused.outputs.tes_charge_expected[k];
+		reused.params.is_pb_operating0 = reused.outputs.pb_operation[k];
+		reused.params.is_pb_standby0 = reused.outputs.pb_standby[k];
+		reused.params.is_rec_operating0 = reused.outputs.rec_operation[k];
+		reused.params.q_pb0 = reused.outputs.q_pb_target[k];
+	}
+}
+
+/// With the default presolve the model is rebuilt for every window, and the results match presolve off
+TEST_F(CspDispatchTest, PresolveMatchesPresolveOff_csp_dispatch)
+{
+	csp_dispatch_opt presolved, plain;
+	setup_plant(presolved, 0);
+	setup_plant(plain, csp_dispatch_opt::s_solver_params::PRESOLVE_TYPE_OFF);
+
+	for (int w = 0; w < 2; w++)
+	{
+		set_forecast(presolved, 24 * w);
+		set_forecast(plain, 24 * w);
+		ASSERT_TRUE(presolved.optimize()) << "window " << w;
+		ASSERT_TRUE(plain.optimize()) << "window " << w;
+
+		double tol = plain.solver_params.mip_gap * std::max(fabs(presolved.outputs.objective_relaxed), fabs(plain.outputs.objective_relaxed));
+		EXPECT_NEAR(presolved.outputs.objective, plain.outputs.objective, tol) << "window " << w;
+	}
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <cmath>
+
+#include "../tcs/htf_props.h"
+
+/**
+ * The lookup table mode of HTFProperties must reproduce the property correlations within the requested
+ * tolerance, fall back to the correlations outside of the table range, and give the same values from the
+ * batch and scalar methods.
+ */
+class HTFPropertiesLookupTest : public ::testing::Test{
+protected:
+	HTFProperties htf_corr;
+	HTFProperties htf_table;
+	double T_min, T_max, tol;
+
+	virtual void SetUp(){
+		T_min = 290. + 273.15;
+		T_max = 600. + 273.15;
+		tol = 1.E-5;
+		htf_corr.SetFluid(HTFProperties::Nitrate_Salt);
+		htf_table.SetFluid(HTFProperties::Nitrate_Salt);
+		htf_table.set_lookup_tables(T_min, T_max, tol);
+	}
+};
+
+TEST_F(HTFPropertiesLookupTest, TableAccuracy_htf_props){
+	ASSERT_TRUE(htf_table.is_lookup_tables_avail());
+	for (double T = T_min; T <= T_max; T += 0.37) {
+		EXPECT_NEAR(htf_table.Cp(T), htf_corr.Cp(T), tol*htf_corr.Cp(T_max)) << "T = " << T;
+		EXPECT_NEAR(htf_table.dens(T, 1.E5), htf_corr.dens(T, 1.E5), tol*htf_corr.dens(T_min, 1.E5)) << "T = " << T;
+		EXPECT_NEAR(htf_table.visc(T), htf_corr.visc(T), tol*htf_corr.visc(T_min)) << "T = " << T;
+		EXPECT_NEAR(htf_table.cond(T), htf_corr.cond(T), tol*htf_corr.cond(T_max)) << "T = " << T;
+		EXPECT_NEAR(htf_table.enth(T), htf_corr.enth(T), tol*htf_corr.enth(T_max)) << "T = " << T;
+	}
+}
+
+TEST_F(HTFPropertiesLookupTest, OutOfRangeAndBatch_htf_props){
+	// Outside of the table, the correlations are used directly
+	EXPECT_EQ(htf_table.visc(T_min - 10.), htf_corr.visc(T_min - 10.));
+	EXPECT_EQ(htf_table.visc(T_max + 10.), htf_corr.visc(T_max + 10.));
+
+	std::vector<double> T;
+	T.push_back(T_min - 10.);
+	for (int i = 0; i < 100; i++)
+		T.push_back(T_min + (T_max - T_min)*i / 99.);
+	T.push_back(T_max + 10.);
+
+	std::vector<double> mu(T.size()), h(T.size());
+	htf_table.visc(&T[0], &mu[0], (int)T.size());
+	htf_table.enth(&T[0], &h[0], (int)T.size());
+	for (size_t i = 0; i < T.size(); i++) {
+		EXPECT_NEAR(mu[i], htf_table.visc(T[i]), 1.E-15) << "T = " << T[i];
+		EXPECT_NEAR(h[i], htf_table.enth(T[i]), 1.E-9) << "T = " << T[i];
+	}
+
+	// Changing the fluid rebuilds the tables, and gas densities still respond to pressure
+	htf_table.SetFluid(HTFProperties::Air);
+	ASSERT_TRUE(htf_table.is_lookup_tables_avail());
+	EXPECT_NEAR(htf_table.dens(700., 2.E5), 2.*htf_table.dens(700., 1.E5), 1.E-9);
+
+	htf_table.clear_lookup_tables();
+	EXPECT_FALSE(htf_table.is_lookup_tables_avail());
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "../tcs/interpolation_routines.h"
+
+/**
+ * Smooth field efficiency maps over normalized sun positions, like the ones the heliostat field models krige.
+ * The precomputed grid must follow the kriged surface inside the bounds of the data and defer to kriging outside them.
+ */
+class GaussMarkovGridTest : public ::testing::Test
+{
+protected:
+	MatDoub sunpos;
+	VectDoub effs;
+
+	/// efficiency at azimuth 'az' and zenith 'zen', both normalized to [0,1], and aerosol optical depth 'aod'
+	static double eta(double az, double zen, double aod)
+	{
+		return (0.65 + 0.08*cos(2.*M_PI*az)*zen - 0.35*zen*zen) * (1. - 0.4*aod);
+	}
+
+	/// azimuth by zenith map, with an AOD axis when 'n_aod' > 0
+	void make_map(int n_az, int n_zen, int n_aod)
+	{
+		sunpos.clear();
+		effs.clear();
+		for (int k = 0; k < std::max(n_aod, 1); k++)
+			for (int j = 0; j < n_zen; j++)
+				for (int i = 0; i < n_az; i++)
+				{
+					VectDoub pos(2);
+					pos[0] = (double)i / (n_az - 1);
+					pos[1] = 0.05 + 0.9*j / (n_zen - 1);
+					double aod = 0.;
+					if (n_aod > 0)
+					{
+						aod = 0.5*k / (n_aod - 1);
+						pos.push_back(aod);
+					}
+					sunpos.push_back(pos);
+					effs.push_back(eta(pos[0], pos[1], aod));
+				}
+	}
+
+	/// points spread through the bounds of the map, on and between the data points
+	std::vector<VectDoub> inside_points(size_t ndim)
+	{
+		std::vector<VectDoub> points;
+		for (int i = 0; i <= 20; i++)
+		{
+			VectDoub pos(ndim);
+			pos[0] = fmod(0.37*i, 1.0);
+			pos[1] = 0.05 + 0.9*fmod(0.61*i + 0.13, 1.0);
+			if (ndim > 2)
+				pos[2] = 0.5*fmod(0.29*i + 0.07, 1.0);
+			points.push_back(pos);
+		}
+		// corners of the bounds
+		VectDoub lo(ndim, 0.), hi(ndim, 1.);
+		lo[1] = 0.05;
+		hi[1] = 0.95;
+		if (ndim > 2)
+			hi[2] = 0.5;
+		points.push_back(lo);
+		points.push_back(hi);
+		return points;
+	}
+
+	/// points with one coordinate beyond the bounds of the map
+	std::vector<VectDoub> outside_points(size_t ndim)
+	{
+		std::vector<VectDoub> points = inside_points(ndim);
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			size_t j = i % ndim;
+			points[i][j] = (i % 2 == 0) ? -0.02 - 0.01*i : points[i][j] + 1.02;
+		}
+		return points;
+	}
+
+	void expect_grid_follows_kriging(std::vector<int> n_grid)
+	{
+		Powvargram vgram(sunpos, effs, 1.99, 0.);
+		GaussMarkov kriged(sunpos, effs, vgram);
+		GaussMarkov gridded(sunpos, effs, vgram);
+		gridded.precompute_grid(n_grid);
+
+		// without a grid interp() is the kriging estimate
+		std::vector<VectDoub> points = inside_points(n_grid.size());
+		for (size_t i = 0; i < points.size(); i++)
+			EXPECT_EQ(kriged.interp_kriged(points[i]), kriged.interp(points[i])) << "point " << i;
+
+		// inside the bounds the grid stays close to the kriged surface
+		for (size_t i = 0; i < points.size(); i++)
+			EXPECT_NEAR(kriged.interp(points[i]), gridded.interp(points[i]), 1.E-3) << "point " << i;
+		EXPECT_LT(gridded.grid_max_error(), 1.E-3);
+		for (size_t i = 0; i < sunpos.size(); i++)
+			EXPECT_NEAR(effs[i], gridded.interp(sunpos[i]), 1.E-3) << "data point " << i;
+
+		// outside the bounds the grid isn't used
+		points = outside_points(n_grid.size());
+		for (size_t i = 0; i < points.size(); i++)
+			EXPECT_EQ(kriged.interp(points[i]), gridded.interp(points[i])) << "outside point " << i;
+	}
+};
+
+TEST_F(GaussMarkovGridTest, GridMatchesKriging_interpolation_routines)
+{
+	make_map(13, 10, 0);
+	std::vector<int> n_grid(2);
+	n_grid[0] = 181;
+	n_grid[1] = 91;
+	expect_grid_follows_kriging(n_grid);
+}
+
+TEST_F(GaussMarkovGridTest, AODGridMatchesKriging_interpolation_routines)
+{
+	make_map(9, 7, 4);
+	std::vector<int> n_grid(3);
+	n_grid[0] = 91;
+	n_grid[1] = 46;
+	n_grid[2] = 11;
+	expect_grid_follows_kriging(n_grid);
+}
+
+TEST_F(GaussMarkovGridTest, SinglePointPerDimension_interpolation_routines)
+{
+	// a map at one zenith angle has no spread to grid in that dimension
+	for (int i = 0; i < 13; i++)
+	{
+		VectDoub pos(2);
+		pos[0] = i / 12.;
+		pos[1] = 0.3;
+		sunpos.push_back(pos);
+		effs.push_back(eta(pos[0], pos[1], 0.));
+	}
+
+	Powvargram vgram(sunpos, effs, 1.99, 0.);
+	GaussMarkov gridded(sunpos, effs, vgram);
+	std::vector<int> n_grid(2);
+	n_grid[0] = 181;
+	n_grid[1] = 91;
+	gridded.precompute_grid(n_grid);
+
+	for (int i = 0; i <= 10; i++)
+	{
+		VectDoub pos(2);
+		pos[0] = 0.1*i;
+		pos[1] = 0.3;
+		EXPECT_NEAR(gridded.interp_kriged(pos), gridded.interp(pos), 1.E-3) << "point " << i;
+	}
+	EXPECT_LT(gridded.grid_max_error(), 1.E-3);
+}
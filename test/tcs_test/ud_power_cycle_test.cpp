@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../tcs/ud_power_cycle.h"
+#include "../tcs/csp_solver_util.h"
+
+/**
+ * Smooth stand-in for an off-design cycle model. The solved state is passed on to warm-start neighbouring points and
+ * nudges their results, so the tables show which point each level was started from. Calls are counted across clones,
+ * and the model throws on the call numbered 'm_n_fail' to simulate an interrupted run.
+ */
+class C_od_pc_mock : public C_od_pc_function
+{
+public:
+	std::atomic<int> & m_n_calls;
+	int m_n_fail;
+
+	C_od_pc_mock(std::atomic<int> & n_calls, int n_fail) : m_n_calls(n_calls), m_n_fail(n_fail) {}
+
+	virtual int operator()(S_f_inputs inputs, S_f_outputs & outputs)
+	{
+		if (++m_n_calls == m_n_fail)
+			throw(C_csp_exception("Off-design model stopped", "C_od_pc_mock"));
+
+		double x_start = inputs.m_x_warm_start.size() == 1 ? inputs.m_x_warm_start[0] : 1.0;
+		double f = (1.0 - 0.002*(inputs.m_T_htf_hot - 570.0)*(inputs.m_T_htf_hot - 570.0)/570.0) * pow(inputs.m_m_dot_htf_ND, 0.9)
+			* (1.0 - 0.004*(inputs.m_T_amb - 35.0));
+		outputs.m_W_dot_gross_ND = f + 1.E-6*x_start;
+		outputs.m_Q_dot_in_ND = inputs.m_m_dot_htf_ND * (1.0 + 0.001*(inputs.m_T_htf_hot - 570.0));
+		outputs.m_W_dot_cooling_ND = f * (1.0 + 0.01*(inputs.m_T_amb - 35.0));
+		outputs.m_m_dot_water_ND = 1.0;
+		outputs.m_x_solved.assign(1, 1.0 + 0.1*(inputs.m_m_dot_htf_ND - 1.0) + 0.01*(inputs.m_T_amb - 35.0));
+		return 0;
+	}
+
+	virtual C_od_pc_function * clone()
+	{
+		return new C_od_pc_mock(m_n_calls, m_n_fail);
+	}
+};
+
+class UDPCTableGeneratorTest : public ::testing::Test
+{
+protected:
+	std::string checkpoint_file;
+
+	virtual void SetUp()
+	{
+		checkpoint_file = "ud_power_cycle_test_checkpoint.txt";
+		remove(checkpoint_file.c_str());
+	}
+	virtual void TearDown()
+	{
+		remove(checkpoint_file.c_str());
+	}
+
+	/// Generates the three tables with 'n_threads' workers and warm start on, returning the number of off-design calls
+	int generate(int n_threads, std::string checkpoint, int n_fail, util::matrix_t<double> tables[3])
+	{
+		std::atomic<int> n_calls(0);
+		C_od_pc_mock pc_mock(n_calls, n_fail);
+		C_ud_pc_table_generator generator(pc_mock);
+		generator.m_n_threads = n_threads;
+		generator.m_is_warm_start = true;
+		generator.m_checkpoint_file = checkpoint;
+		generator.generate_tables(570.0, 550.0, 580.0, 7,
+			35.0, 0.0, 45.0, 8,
+			1.0, 0.5, 1.05, 6,
+			tables[0], tables[1], tables[2]);
+		return n_calls;
+	}
+
+	void expect_tables_equal(util::matrix_t<double> expected[3], util::matrix_t<double> actual[3])
+	{
+		for (int t = 0; t < 3; t++)
+		{
+			ASSERT_EQ(expected[t].nrows(), actual[t].nrows()) << "Table " << t;
+			ASSERT_EQ(expected[t].ncols(), actual[t].ncols()) << "Table " << t;
+			for (size_t i = 0; i < expected[t].nrows(); i++)
+				for (size_t j = 0; j < expected[t].ncols(); j++)
+					EXPECT_EQ(expected[t](i, j), actual[t](i, j)) << "Table " << t << " at (" << i << "," << j << ")";
+		}
+	}
+};
+
+TEST_F(UDPCTableGeneratorTest, ThreadsMatchSerial_ud_power_cycle)
+{
+	util::matrix_t<double> serial[3];
+	int n_runs = generate(1, "", -1, serial);
+	EXPECT_EQ(3 * (7 + 8 + 6), n_runs);
+
+	for (int n_threads = 2; n_threads <= 6; n_threads += 2)
+	{
+		util::matrix_t<double> parallel[3];
+		EXPECT_EQ(n_runs, generate(n_threads, "", -1, parallel)) << n_threads << " threads";
+		expect_tables_equal(serial, parallel);
+	}
+}
+
+TEST_F(UDPCTableGeneratorTest, CheckpointResumesInterruptedRun_ud_power_cycle)
+{
+	util::matrix_t<double> full[3];
+	int n_runs = generate(1, "", -1, full);
+
+	// the run stops on its 23rd off-design call, after 22 points were saved
+	util::matrix_t<double> interrupted[3];
+	EXPECT_THROW(generate(1, checkpoint_file, 23, interrupted), C_csp_exception);
+
+	// a line cut short by the interruption is dropped when the checkpoint is read
+	FILE *fp = fopen(checkpoint_file.c_str(), "a");
+	ASSERT_TRUE(fp != NULL);
+	fprintf(fp, "40 0 0.91 0.95");
+	fclose(fp);
+
+	// resuming solves only the remaining points, on several threads, and gives the tables of the full run
+	util::matrix_t<double> resumed[3];
+	EXPECT_EQ(n_runs - 22, generate(4, checkpoint_file, -1, resumed));
+	expect_tables_equal(full, resumed);
+
+	// a second resume restores every point from the completed checkpoint
+	util::matrix_t<double> restored[3];
+	EXPECT_EQ(0, generate(4, checkpoint_file, -1, restored));
+	expect_tables_equal(full, restored);
+}